@@ -32,6 +32,7 @@ namespace Sakura
 class BlossomItem;
 class SakuraThread;
 class Validator;
+class BlossomTrace;
 
 //--------------------------------------------------------------------------------------------------
 struct BlossomLeaf
@@ -44,8 +45,12 @@ struct BlossomLeaf
     std::string blossomPath = "";
 
     DataMap output;
+
+    // the input-items are moved out of the tree into the leaf and are owned by the leaf. A
+    // blossom can change or remove them, because they are not used anymore after the call.
     DataMap input;
 
+    // values of the calling tree, which is nullptr for pure blossoms and batched calls
     DataMap* parentValues = nullptr;
     std::string terminalOutput = "";
 };
@@ -79,16 +84,33 @@ public:
 
 protected:
     virtual bool runTask(BlossomLeaf &blossomLeaf, std::string &errorMessage) = 0;
+    virtual bool runBatch(std::vector<BlossomLeaf> &blossomLeafs, std::string &errorMessage);
 
     std::map<std::string, BlossomValidDef> validationMap;
     bool allowUnmatched = false;
 
+    // set to true, if the output depends only on the input and the blossom has no side-effects,
+    // so the results can be cached and reused for calls with the same input. Pure blossoms must
+    // not read the parent-values, because they are not part of the cache-key, so the
+    // parentValues of their blossom-leafs are always nullptr.
+    bool isPure = false;
+
+    // set to true, if runBatch is overridden to process multiple calls at once. Independent
+    // iterations of a sequential loop, which only call this blossom, are then given to runBatch
+    // instead of calling runTask for each iteration. Batched calls are not cached and get no
+    // parent-values, because the parent-values are already changed by the following iterations
+    // of the batch, when the blossom is processed.
+    bool supportsBatch = false;
+
 private:
     friend SakuraThread;
     friend Validator;
 
     bool growBlossom(BlossomLeaf &blossomLeaf,
-                     std::string &errorMessage);
+                     std::string &errorMessage,
+                     BlossomTrace* trace = nullptr);
+    bool growBlossomBatch(std::vector<BlossomLeaf> &blossomLeafs,
+                          std::string &errorMessage);
 
     bool validateInput(BlossomItem &blossomItem,
                        const std::string &filePath,
@@ -25,6 +25,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <mutex>
 #include <unistd.h>
 #include <sys/ioctl.h>
@@ -52,29 +53,79 @@ class BlossomItem;
 class BlossomLeaf;
 class Validator;
 class SakuraParsing;
+class ParseCache;
+class BlossomTrace;
+class BlossomCache;
+struct FoldingStats;
 
 namespace bfs = boost::filesystem;
 
 class SakuraLangInterface
 {
 public:
+    enum RunPriority
+    {
+        INTERACTIVE_PRIORITY = 0,
+        NORMAL_PRIORITY = 1,
+        BATCH_PRIORITY = 2,
+    };
+
     static SakuraLangInterface* getInstance();
 
+    SakuraLangInterface(const uint16_t numberOfThreads = 6,
+                        const bool enableDebug = false);
+    SakuraLangInterface(SakuraLangInterface* poolProvider,
+                        const bool enableDebug = false);
     ~SakuraLangInterface();
 
     bool triggerTree(DataMap& result,
                      const std::string &id,
                      DataMap &initialValues,
-                     std::string &errorMessage);
+                     std::string &errorMessage,
+                     const RunPriority priority = NORMAL_PRIORITY);
     bool runTree(DataMap& result,
                  const std::string &id,
                  const std::string &treeContent,
                  const DataMap &initialValues,
-                 std::string &errorMessage);
+                 std::string &errorMessage,
+                 const RunPriority priority = NORMAL_PRIORITY);
     bool readFiles(const std::string &inputPath,
                    std::string &errorMessage);
     bool readFilesInDir(const std::string &directoryPath,
                         std::string &errorMessage);
+    bool reloadFiles(std::string &errorMessage);
+
+    // thread-pool
+    bool setNumberOfThreads(const uint16_t numberOfThreads,
+                            const uint16_t maxNumberOfThreads = 0);
+    uint16_t getNumberOfThreads();
+    void setCpuPinning(const bool enable,
+                       const std::vector<uint32_t> &cpuIds = std::vector<uint32_t>());
+    void getSchedulingMetrics(DataMap &result);
+
+    // parse-cache
+    void setParseCacheSize(const uint64_t maxSize);
+    void getParseCacheMetrics(DataMap &result);
+
+    // blossom-cache
+    void setBlossomCacheSize(const uint64_t maxSize);
+    void getBlossomCacheMetrics(DataMap &result);
+
+    // optimizations
+    void setAutoParallelization(const bool enable);
+    void setBatchSize(const uint32_t batchSize);
+    void getFoldingMetrics(DataMap &result);
+
+    // error-output
+    void setJsonErrorOutput(const bool enable);
+
+    // trace
+    bool startTraceRecording(const std::string &filePath,
+                             std::string &errorMessage);
+    bool stopTraceRecording(std::string &errorMessage);
+    bool startTraceReplay(const std::string &filePath,
+                          std::string &errorMessage);
+    void stopTraceReplay();
 
     // blossom getter and setter
     bool doesBlossomExist(const std::string &groupName,
@@ -95,7 +146,7 @@ public:
                  Kitsunemimi::DataBuffer* data);
 
     // getter
-    const std::string getTemplate(const std::string &id);
+    const std::string& getTemplate(const std::string &id);
     DataBuffer* getFile(const std::string &id);
 
     const bfs::path getRelativePath(const bfs::path &blossomFilePath,
@@ -106,24 +157,38 @@ private:
     friend SakuraThread;
     friend Validator;
 
-    SakuraLangInterface(const uint16_t numberOfThreads = 6,
-                        const bool enableDebug = false);
-
     static SakuraLangInterface* m_instance;
 
     SakuraParsing* m_parser = nullptr;
 
     // internally used objects
     SakuraGarden* m_garden = nullptr;
+    ParseCache* m_parseCache = nullptr;
+    BlossomTrace* m_trace = nullptr;
+    BlossomCache* m_blossomCache = nullptr;
     SubtreeQueue* m_queue = nullptr;
     ThreadPool* m_threadPoos = nullptr;
+    bool m_ownsThreadPool = true;
+    bool m_autoParallelization = false;
+    uint32_t m_batchSize = 64;
+    bool m_jsonErrorOutput = false;
+    FoldingStats* m_foldingStats = nullptr;
+    std::mutex m_foldingLock;
     Validator* m_validator = nullptr;
+    // only protects parser and validator, the garden can be read without lock
     std::mutex m_lock;
 
     std::map<std::string, std::map<std::string, Blossom*>> m_registeredBlossoms;
 
+    TreeItem* getValidatedTree(const std::string &id,
+                               const std::string &treeContent,
+                               std::string &errorMessage);
+    void renderError(std::string &errorMessage);
+    void addFoldingStats(const FoldingStats &stats);
+    void deleteTrees(std::map<std::string, TreeItem*> &trees);
     bool runProcess(DataMap &resultingItems, TreeItem *tree,
                     const DataMap &initialValues,
+                    const RunPriority priority,
                     std::string &errorMessage);
 
     // output
@@ -23,6 +23,7 @@
 #include <libKitsunemimiSakuraLang/blossom.h>
 
 #include <items/item_methods.h>
+#include <processing/blossom_trace.h>
 #include <libKitsunemimiPersistence/logger/logger.h>
 
 namespace Kitsunemimi
@@ -45,18 +46,49 @@ Blossom::~Blossom() {}
  *
  * @param blossomLeaf leaf-object for values-handling while processing
  * @param errorMessage reference for error-message
+ * @param trace optional trace to record the call or to replay a recorded call
  *
  * @return true, if successful, else false
  */
 bool
 Blossom::growBlossom(BlossomLeaf &blossomLeaf,
-                     std::string &errorMessage)
+                     std::string &errorMessage,
+                     BlossomTrace* trace)
 {
     blossomLeaf.output.clear();
 
-    // process blossom
-    LOG_DEBUG("runTask " + blossomLeaf.blossomName);
-    const bool ret = runTask(blossomLeaf, errorMessage);
+    BlossomTrace::TraceMode traceMode = BlossomTrace::NO_TRACE;
+    if(trace != nullptr) {
+        traceMode = trace->getMode();
+    }
+
+    bool ret = false;
+    if(traceMode == BlossomTrace::REPLAY_TRACE)
+    {
+        // use the recorded result instead of processing the blossom
+        LOG_DEBUG("replay " + blossomLeaf.blossomName);
+        if(trace->replay(blossomLeaf, ret, errorMessage) == false)
+        {
+            errorMessage = createError(blossomLeaf, "blossom replay", errorMessage);
+            return false;
+        }
+    }
+    else if(traceMode == BlossomTrace::RECORD_TRACE)
+    {
+        // the input has to be serialized before the processing, because it can be changed
+        std::string serializedInput = "";
+        BlossomTrace::serializeItem(serializedInput, &blossomLeaf.input);
+
+        LOG_DEBUG("runTask " + blossomLeaf.blossomName);
+        ret = runTask(blossomLeaf, errorMessage);
+        trace->record(blossomLeaf, serializedInput, ret, errorMessage);
+    }
+    else
+    {
+        // process blossom
+        LOG_DEBUG("runTask " + blossomLeaf.blossomName);
+        ret = runTask(blossomLeaf, errorMessage);
+    }
 
     // handle result
     if(ret == false)
@@ -68,6 +100,65 @@ Blossom::growBlossom(BlossomLeaf &blossomLeaf,
     return true;
 }
 
+/**
+ * @brief process multiple calls of the blossom at once. The default-implementation calls runTask
+ *        for each blossom-leaf, so blossoms only override this, if they can process a batch
+ *        more efficient than single calls.
+ *
+ * @param blossomLeafs leaf-objects of all calls of the batch
+ * @param errorMessage reference for error-message
+ *
+ * @return true, if all calls were successful, else false
+ */
+bool
+Blossom::runBatch(std::vector<BlossomLeaf> &blossomLeafs,
+                  std::string &errorMessage)
+{
+    for(uint64_t i = 0; i < blossomLeafs.size(); i++)
+    {
+        if(runTask(blossomLeafs[i], errorMessage) == false) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief execute a batch of calls of the blossom
+ *
+ * @param blossomLeafs leaf-objects for values-handling of all calls of the batch
+ * @param errorMessage reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+Blossom::growBlossomBatch(std::vector<BlossomLeaf> &blossomLeafs,
+                          std::string &errorMessage)
+{
+    if(blossomLeafs.size() == 0) {
+        return true;
+    }
+
+    for(uint64_t i = 0; i < blossomLeafs.size(); i++) {
+        blossomLeafs[i].output.clear();
+    }
+
+    // process blossom
+    LOG_DEBUG("runBatch " + blossomLeafs.at(0).blossomName
+              + " with " + std::to_string(blossomLeafs.size()) + " calls");
+    const bool ret = runBatch(blossomLeafs, errorMessage);
+
+    // handle result
+    if(ret == false)
+    {
+        errorMessage = createError(blossomLeafs.at(0), "blossom batch execute", errorMessage);
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief validate given input with the required and allowed values of the selected blossom
  *
@@ -69,6 +69,8 @@ class SakuraParserInterface;
 %code
 {
 #include <parsing/sakura_parser_interface.h>
+#include <items/item_methods.h>
+#include <items/value_item_functions.h>
 # undef YY_DECL
 # define YY_DECL \
     Kitsunemimi::Sakura::SakuraParser::symbol_type sakuralex (Kitsunemimi::Sakura::SakuraParserInterface& driver)
@@ -132,6 +134,7 @@ YY_DECL;
 %type  <std::vector<BlossomItem*>*> blossom_set
 
 %type  <ValueItemMap*> item_set
+%type  <ValueItemMap*> reduce_set
 
 %type  <FunctionItem> access
 %type  <std::vector<FunctionItem>*> access_list
@@ -251,15 +254,11 @@ if_condition:
     "if" "(" value_item compare_type value_item ")" "{" blossom_group_set "}" "else" "{" blossom_group_set "}"
     {
         $$ = new IfBranching();
+        driver.setSpan($$, @$);
         $$->leftSide = $3;
         $$->rightSide = $5;
 
-        if($4 == "==") {
-            $$->ifType = IfBranching::EQUAL;
-        }
-        if($4 == "!=") {
-            $$->ifType = IfBranching::UNEQUAL;
-        }
+        $$->ifType = getCompareType($4);
 
         $$->ifContent = $8;
         $$->elseContent = $12;
@@ -268,15 +267,11 @@ if_condition:
     "if" "(" value_item compare_type value_item ")" "{" blossom_group_set "}"
     {
         $$ = new IfBranching();
+        driver.setSpan($$, @$);
         $$->leftSide = $3;
         $$->rightSide = $5;
 
-        if($4 == "==") {
-            $$->ifType = IfBranching::EQUAL;
-        }
-        if($4 == "!=") {
-            $$->ifType = IfBranching::UNEQUAL;
-        }
+        $$->ifType = getCompareType($4);
 
         $$->ifContent = $8;
         $$->elseContent = new SequentiellPart();
@@ -286,9 +281,11 @@ for_each_loop:
     "for" "(" regiterable_identifier ":" value_item ")" item_set "{" blossom_group_set "}"
     {
         $$ = new ForEachBranching();
+        driver.setSpan($$, @$);
         $$->tempVarName = $3;
         $$->iterateArray.insert("array", $5);
         $$->values = *$7;
+        separateReductions($$->values, $$->reductions);
         delete $7;
         $$->content = $9;
     }
@@ -296,9 +293,11 @@ for_each_loop:
     "parallel_for" "(" regiterable_identifier ":" value_item ")" item_set "{" blossom_group_set "}"
     {
         $$ = new ForEachBranching();
+        driver.setSpan($$, @$);
         $$->tempVarName = $3;
         $$->iterateArray.insert("array", $5);
         $$->values = *$7;
+        separateReductions($$->values, $$->reductions);
         delete $7;
         $$->content = $9;
         $$->parallel = true;
@@ -323,10 +322,12 @@ for_loop:
         }
 
         $$ = new ForBranching();
+        driver.setSpan($$, @$);
         $$->tempVarName = $3;
         $$->start = $5;
         $$->end = $9;
         $$->values = *$15;
+        separateReductions($$->values, $$->reductions);
         delete $15;
         $$->content = $17;
     }
@@ -349,26 +350,32 @@ for_loop:
         }
 
         $$ = new ForBranching();
+        driver.setSpan($$, @$);
         $$->tempVarName = $3;
         $$->start = $5;
         $$->end = $9;
         $$->values = *$15;
+        separateReductions($$->values, $$->reductions);
         delete $15;
         $$->content = $17;
         $$->parallel = true;
     }
 
 parallel:
-    "parallel" "(" ")" "{" blossom_group_set "}"
+    "parallel" "(" ")" reduce_set "{" blossom_group_set "}"
     {
         $$ = new ParallelPart();
-        $$->childs = dynamic_cast<SequentiellPart*>($5);
+        driver.setSpan($$, @$);
+        $$->reductions = *$4;
+        delete $4;
+        $$->childs = dynamic_cast<SequentiellPart*>($6);
     }
 
 blossom_group:
     "identifier" "(" name_item ")" item_set blossom_set
     {
         $$ = new BlossomGroupItem();
+        driver.setSpan($$, @$);
         $$->blossomGroupType = $1;
         $$->id = $3;
         $$->values = *$5;
@@ -380,6 +387,7 @@ blossom_group:
     "identifier" "(" name_item ")" blossom_set
     {
         $$ = new BlossomGroupItem();
+        driver.setSpan($$, @$);
         $$->blossomGroupType = $1;
         $$->id = $3;
         $$->blossoms = *$5;
@@ -389,12 +397,14 @@ blossom_group:
     "identifier" "(" name_item ")" item_set
     {
         $$ = new BlossomGroupItem();
+        driver.setSpan($$, @$);
         $$->blossomGroupType = "special";
         $$->id = $3;
         $$->values = *$5;
         delete $5;
 
         BlossomItem* tempBlossom = new BlossomItem();
+        driver.setSpan(tempBlossom, @$);
         tempBlossom->blossomType = $1;
         $$->blossoms.push_back(tempBlossom);
     }
@@ -402,10 +412,12 @@ blossom_group:
     "identifier" "(" name_item ")"
     {
         $$ = new BlossomGroupItem();
+        driver.setSpan($$, @$);
         $$->blossomGroupType = "special";
         $$->id = $3;
 
         BlossomItem* tempBlossom = new BlossomItem();
+        driver.setSpan(tempBlossom, @$);
         tempBlossom->blossomType = $1;
         $$->blossoms.push_back(tempBlossom);
     }
@@ -427,12 +439,14 @@ blossom:
    "->" "identifier"
    {
        $$ = new BlossomItem();
+       driver.setSpan($$, @$);
        $$->blossomType = $2;
    }
 |
    "->" "identifier" ":" item_set
    {
        $$ = new BlossomItem();
+       driver.setSpan($$, @$);
        $$->blossomType = $2;
        $$->values = *$4;
        delete $4;
@@ -442,7 +456,7 @@ blossom:
 regiterable_identifier:
    "identifier"
    {
-       driver.m_registeredKeys.push_back($1);
+       driver.m_registeredKeys.insert($1);
        $$ = $1;
    }
 
@@ -544,7 +558,28 @@ item_set:
             newItem.type = ValueItem::COMPARE_EQUAL_PAIR_TYPE;
         }
         if($4 == "!=") {
-            newItem.type = ValueItem::COMPARE_EQUAL_PAIR_TYPE;
+            newItem.type = ValueItem::COMPARE_UNEQUAL_PAIR_TYPE;
+        }
+
+        $1->insert($3, newItem);
+        $$ = $1;
+    }
+|
+    item_set  "-" regiterable_identifier "<<" "identifier" "(" value_item ")"
+    {
+        if($1->contains($3))
+        {
+            driver.error(yyla.location, "name already used: \"" + $3 + "\"", true);
+            return 1;
+        }
+
+        ValueItem newItem = $7;
+        newItem.type = ValueItem::REDUCE_PAIR_TYPE;
+        newItem.reduceType = getReduceType($5);
+        if(newItem.reduceType == ValueItem::NO_REDUCE)
+        {
+            driver.error(yyla.location, "unknown reduce-function: \"" + $5 + "\"", true);
+            return 1;
         }
 
         $1->insert($3, newItem);
@@ -652,19 +687,63 @@ item_set:
             newItem.type = ValueItem::COMPARE_EQUAL_PAIR_TYPE;
         }
         if($3 == "!=") {
-            newItem.type = ValueItem::COMPARE_EQUAL_PAIR_TYPE;
+            newItem.type = ValueItem::COMPARE_UNEQUAL_PAIR_TYPE;
+        }
+
+        $$->insert($2, newItem);
+    }
+|
+    "-" regiterable_identifier "<<" "identifier" "(" value_item ")"
+    {
+        $$ = new ValueItemMap();
+
+        ValueItem newItem = $6;
+        newItem.type = ValueItem::REDUCE_PAIR_TYPE;
+        newItem.reduceType = getReduceType($4);
+        if(newItem.reduceType == ValueItem::NO_REDUCE)
+        {
+            driver.error(yyla.location, "unknown reduce-function: \"" + $4 + "\"", true);
+            return 1;
         }
 
         $$->insert($2, newItem);
     }
 
+reduce_set:
+    %empty
+    {
+        $$ = new ValueItemMap();
+    }
+|
+    reduce_set "-" regiterable_identifier "<<" "identifier" "(" value_item ")"
+    {
+        if($1->contains($3))
+        {
+            driver.error(yyla.location, "name already used: \"" + $3 + "\"", true);
+            return 1;
+        }
+
+        ValueItem newItem = $7;
+        newItem.type = ValueItem::REDUCE_PAIR_TYPE;
+        newItem.reduceType = getReduceType($5);
+        if(newItem.reduceType == ValueItem::NO_REDUCE)
+        {
+            driver.error(yyla.location, "unknown reduce-function: \"" + $5 + "\"", true);
+            return 1;
+        }
+
+        $1->insert($3, newItem);
+        $$ = $1;
+    }
+
 subtree_fork:
     "subtree" "(" name_item ")" item_set
     {
         $$ = new SubtreeItem();
+        driver.setSpan($$, @$);
         $$->nameOrPath = $3;
         $$->values = *$5;
-        driver.m_sakuraParsing->addFileToQueue($3);
+        $$->resolvedId = driver.m_sakuraParsing->addFileToQueue($3);
         delete $5;
     }
 
@@ -716,6 +795,15 @@ value_item:
         newItem.item = new DataValue($1);
         $$ = newItem;
     }
+|
+    string_text function_list
+    {
+        ValueItem newItem;
+        newItem.item = new DataValue($1);
+        newItem.functions = *$2;
+        delete $2;
+        $$ = newItem;
+    }
 |
     "identifier"
     {
@@ -0,0 +1,280 @@
+/**
+ * @file        error_container.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "error_container.h"
+
+#include <cstdio>
+
+#include <libKitsunemimiCommon/common_items/table_item.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor, which decodes a chain of error-records
+ *
+ * @param errorMessage error-message, which can contain plain text before the first record
+ */
+ErrorContainer::ErrorContainer(const std::string &errorMessage)
+{
+    uint64_t start = errorMessage.find(ERROR_RECORD_SEPARATOR);
+    m_prefix = errorMessage.substr(0, start);
+
+    while(start != std::string::npos)
+    {
+        const uint64_t end = errorMessage.find(ERROR_RECORD_SEPARATOR, start + 1);
+        if(end == std::string::npos) {
+            decodeRecord(errorMessage.substr(start + 1));
+        } else {
+            decodeRecord(errorMessage.substr(start + 1, end - start - 1));
+        }
+
+        start = end;
+    }
+}
+
+/**
+ * @brief add a field to an error-record
+ *
+ * @param record reference to the record, which should be extended
+ * @param name name of the field
+ * @param value value of the field
+ */
+void
+ErrorContainer::addField(std::string &record,
+                         const std::string &name,
+                         const std::string &value)
+{
+    appendEscaped(record, name);
+    record += ERROR_FIELD_SEPARATOR;
+    appendEscaped(record, value);
+    record += ERROR_FIELD_SEPARATOR;
+}
+
+/**
+ * @brief append a field to a record and escape all separators within the field, so the
+ *        content of the field can not break the structure of the record
+ *
+ * @param record reference to the record, which should be extended
+ * @param field field to append
+ */
+void
+ErrorContainer::appendEscaped(std::string &record,
+                              const std::string &field)
+{
+    for(const char c : field)
+    {
+        if(c == ERROR_RECORD_SEPARATOR
+                || c == ERROR_FIELD_SEPARATOR
+                || c == ERROR_ESCAPE_CHARACTER)
+        {
+            record += ERROR_ESCAPE_CHARACTER;
+            record += static_cast<char>(c ^ 0x40);
+        }
+        else
+        {
+            record += c;
+        }
+    }
+}
+
+/**
+ * @brief restore the original content of an escaped field
+ *
+ * @param field escaped field
+ *
+ * @return original content of the field
+ */
+const std::string
+ErrorContainer::unescapeField(const std::string &field)
+{
+    std::string result = "";
+    result.reserve(field.size());
+
+    for(uint64_t i = 0; i < field.size(); i++)
+    {
+        if(field.at(i) == ERROR_ESCAPE_CHARACTER
+                && i + 1 < field.size())
+        {
+            i++;
+            result += static_cast<char>(field.at(i) ^ 0x40);
+        }
+        else
+        {
+            result += field.at(i);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief render all errors as tables, beginning with the outermost error
+ *
+ * @return rendered error-message
+ */
+const std::string
+ErrorContainer::toString() const
+{
+    std::string result = m_prefix;
+
+    for(const ErrorEntry &entry : m_entries)
+    {
+        Kitsunemimi::TableItem errorOutput;
+        errorOutput.addColumn("Field");
+        errorOutput.addColumn("Value");
+
+        for(const std::pair<std::string, std::string> &field : entry) {
+            errorOutput.addRow(std::vector<std::string>{field.first, field.second});
+        }
+
+        result += errorOutput.toString(200);
+    }
+
+    return result;
+}
+
+/**
+ * @brief render all errors as json-array with one object per error, beginning with the
+ *        outermost error
+ *
+ * @return json-string
+ */
+const std::string
+ErrorContainer::toJsonString() const
+{
+    std::string result = "[";
+
+    if(m_prefix.size() > 0) {
+        result += "{\"error-message\":\"" + escapeJson(m_prefix) + "\"}";
+    }
+
+    for(const ErrorEntry &entry : m_entries)
+    {
+        if(result.size() > 1) {
+            result += ",";
+        }
+
+        result += "{";
+        for(uint64_t i = 0; i < entry.size(); i++)
+        {
+            if(i > 0) {
+                result += ",";
+            }
+            result += "\"" + escapeJson(entry.at(i).first) + "\":";
+            result += "\"" + escapeJson(entry.at(i).second) + "\"";
+        }
+        result += "}";
+    }
+
+    result += "]";
+
+    return result;
+}
+
+/**
+ * @brief split a single record into its fields
+ *
+ * @param record record without the record-separator
+ */
+void
+ErrorContainer::decodeRecord(const std::string &record)
+{
+    ErrorEntry entry;
+
+    uint64_t pos = 0;
+    while(pos < record.size())
+    {
+        const uint64_t nameEnd = record.find(ERROR_FIELD_SEPARATOR, pos);
+        if(nameEnd == std::string::npos) {
+            break;
+        }
+
+        uint64_t valueEnd = record.find(ERROR_FIELD_SEPARATOR, nameEnd + 1);
+        if(valueEnd == std::string::npos) {
+            valueEnd = record.size();
+        }
+
+        entry.push_back(std::make_pair(
+                            unescapeField(record.substr(pos, nameEnd - pos)),
+                            unescapeField(record.substr(nameEnd + 1, valueEnd - nameEnd - 1))));
+        pos = valueEnd + 1;
+    }
+
+    m_entries.push_back(entry);
+}
+
+/**
+ * @brief escape a string for the usage within a json-string
+ *
+ * @param input string to escape
+ *
+ * @return escaped string
+ */
+const std::string
+ErrorContainer::escapeJson(const std::string &input) const
+{
+    std::string result = "";
+    result.reserve(input.size());
+
+    for(const char c : input)
+    {
+        switch(c)
+        {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            case '\r':
+                result += "\\r";
+                break;
+            default:
+                // remaining control-characters
+                if(static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<int>(c));
+                    result += buffer;
+                }
+                else
+                {
+                    result += c;
+                }
+                break;
+        }
+    }
+
+    return result;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,75 @@
+/**
+ * @file        error_container.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_ERROR_CONTAINER_H
+#define KITSUNEMIMI_SAKURA_LANG_ERROR_CONTAINER_H
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+// Errors are passed internally as compact records, which are only rendered, when they leave
+// the interface. Each record starts with the record-separator and contains pairs of field-name
+// and value, which are separated by the unit-separator. Separators and the escape-character
+// within the fields are replaced by the escape-character, followed by the caret-notation of
+// the replaced character.
+const char ERROR_RECORD_SEPARATOR = '\x1e';
+const char ERROR_FIELD_SEPARATOR = '\x1f';
+const char ERROR_ESCAPE_CHARACTER = '\x1d';
+
+/**
+ * @brief The ErrorContainer class decodes a chain of error-records and renders it as tables or
+ *        as json-array
+ */
+class ErrorContainer
+{
+public:
+    ErrorContainer(const std::string &errorMessage);
+
+    const std::string toString() const;
+    const std::string toJsonString() const;
+
+    static void addField(std::string &record,
+                         const std::string &name,
+                         const std::string &value);
+
+private:
+    typedef std::vector<std::pair<std::string, std::string>> ErrorEntry;
+
+    std::string m_prefix = "";
+    std::vector<ErrorEntry> m_entries;
+
+    void decodeRecord(const std::string &record);
+    static void appendEscaped(std::string &record, const std::string &field);
+    static const std::string unescapeField(const std::string &field);
+    const std::string escapeJson(const std::string &input) const;
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_ERROR_CONTAINER_H
@@ -22,12 +22,17 @@
 
 #include "item_methods.h"
 
+#include <cerrno>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
 #include <items/value_item_functions.h>
+#include <items/error_container.h>
 #include <libKitsunemimiSakuraLang/blossom.h>
 
 #include <libKitsunemimiJinja2/jinja2_converter.h>
 #include <libKitsunemimiCommon/common_items/data_items.h>
-#include <libKitsunemimiCommon/common_items/table_item.h>
 
 namespace Kitsunemimi
 {
@@ -37,162 +42,291 @@ namespace Sakura
 using Kitsunemimi::Jinja2::Jinja2Converter;
 
 /**
- * @brief process a value-item by handling its function-calls
+ * @brief process a single function-call on a data-item
  *
- * @param valueItem value-item, which should be processed
- * @param insertValues data-map with information to fill into the jinja2-string
+ * @param item data-item, on which the function should be called. The item itself is not
+ *             modified by any of the functions.
+ * @param functionItem function-call with its arguments
+ * @param insertValues data-map with information to fill the arguments of the function
  * @param errorMessage error-message for output
  *
- * @return false, if something went wrong while processing and filling, else true. If false
- *         an error-message was sent directly into the sakura-root-object
-*/
-bool
-getProcessedItem(ValueItem &valueItem,
-                 DataMap &insertValues,
-                 std::string &errorMessage)
+ * @return result of the function as new data-item, or nullptr, if the function failed
+ */
+DataItem*
+processFunction(DataItem* item,
+                const FunctionItem &functionItem,
+                DataMap &insertValues,
+                std::string &errorMessage)
 {
-    for(const Kitsunemimi::Sakura::FunctionItem& functionItem : valueItem.functions)
+    DataItem* tempItem = nullptr;
+    const std::string type = functionItem.type;
+
+    //----------------------------------------------------------------------------------------------
+    if(type == "get")
     {
-        if(valueItem.item == nullptr) {
-            return false;
+        if(functionItem.arguments.size() != 1)
+        {
+            errorMessage = type + "-function requires 1 argument";
+            return nullptr;
         }
-        DataItem* tempItem = nullptr;
-        const std::string type = functionItem.type;
 
-        //------------------------------------------------------------------------------------------
-        if(type == "get")
-        {
-            if(functionItem.arguments.size() != 1)
-            {
-                errorMessage = type + "-function requires 1 argument";
-                return false;
-            }
+        ValueItem arg = functionItem.arguments.at(0);
+        if(fillValueItem(arg, insertValues, errorMessage) == false) {
+            return nullptr;
+        }
 
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, errorMessage) == false) {
-                return false;
-            }
+        tempItem = getValue(item,
+                            arg.item->toValue(),
+                            errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "split")
+    {
+        if(functionItem.arguments.size() != 1)
+        {
+            errorMessage = type + "-function requires 1 argument";
+            return nullptr;
+        }
 
-            tempItem = getValue(valueItem.item,
-                                arg.item->toValue(),
-                                errorMessage);
+        ValueItem arg = functionItem.arguments.at(0);
+        if(fillValueItem(arg, insertValues, errorMessage) == false) {
+            return nullptr;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "split")
+
+        tempItem = splitValue(item->toValue(),
+                              arg.item->toValue(),
+                              errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "contains")
+    {
+        if(functionItem.arguments.size() != 1)
         {
-            if(functionItem.arguments.size() != 1)
-            {
-                errorMessage = type + "-function requires 1 argument";
-                return false;
-            }
+            errorMessage = type + "-function requires 1 argument";
+            return nullptr;
+        }
 
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, errorMessage) == false) {
-                return false;
-            }
+        ValueItem arg = functionItem.arguments.at(0);
+        if(fillValueItem(arg, insertValues, errorMessage) == false) {
+            return nullptr;
+        }
 
-            tempItem = splitValue(valueItem.item->toValue(),
-                                  arg.item->toValue(),
-                                  errorMessage);
+        tempItem = containsValue(item,
+                                 arg.item->toValue(),
+                                 errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "size")
+    {
+        if(functionItem.arguments.size() != 0)
+        {
+            errorMessage = type + "-function requires 0 arguments";
+            return nullptr;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "contains")
+
+        tempItem = sizeValue(item, errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "insert")
+    {
+        if(functionItem.arguments.size() != 2)
         {
-            if(functionItem.arguments.size() != 1)
-            {
-                errorMessage = type + "-function requires 1 argument";
-                return false;
-            }
+            errorMessage = type + "-function requires 2 arguments";
+            return nullptr;
+        }
 
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, errorMessage) == false) {
-                return false;
-            }
+        ValueItem arg1 = functionItem.arguments.at(0);
+        ValueItem arg2 = functionItem.arguments.at(1);
 
-            tempItem = containsValue(valueItem.item,
-                                     arg.item->toValue(),
-                                     errorMessage);
+        if(fillValueItem(arg1, insertValues, errorMessage) == false
+                || fillValueItem(arg2, insertValues, errorMessage) == false)
+        {
+            return nullptr;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "size")
+
+        tempItem = insertValue(item->toMap(),
+                               arg1.item->toValue(),
+                               arg2.item,
+                               errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "append")
+    {
+        if(functionItem.arguments.size() != 1)
         {
-            if(functionItem.arguments.size() != 0)
-            {
-                errorMessage = type + "-function requires 0 arguments";
-                return false;
-            }
+            errorMessage = type + "-function requires 1 argument";
+            return nullptr;
+        }
 
-            tempItem = sizeValue(valueItem.item, errorMessage);
+        ValueItem arg = functionItem.arguments.at(0);
+        if(fillValueItem(arg, insertValues, errorMessage) == false) {
+            return nullptr;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "insert")
-        {
-            if(functionItem.arguments.size() != 2)
-            {
-                errorMessage = type + "-function requires 2 arguments";
-                return false;
-            }
 
-            ValueItem arg1 = functionItem.arguments.at(0);
-            ValueItem arg2 = functionItem.arguments.at(1);
+        tempItem = appendValue(item->toArray(),
+                               arg.item,
+                               errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "clear_empty")
+    {
+        if(functionItem.arguments.size() != 0)
+        {
+            errorMessage = type + "-function requires 0 arguments";
+            return nullptr;
+        }
 
-            if(fillValueItem(arg1, insertValues, errorMessage) == false
-                    || fillValueItem(arg2, insertValues, errorMessage) == false)
-            {
-                return false;
-            }
+        tempItem = clearEmpty(item->toArray(),
+                              errorMessage);
 
-            tempItem = insertValue(valueItem.item->toMap(),
-                                   arg1.item->toValue(),
-                                   arg2.item,
-                                   errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "parse_json")
+    {
+        if(functionItem.arguments.size() != 0)
+        {
+            errorMessage = type + "-function requires 0 arguments";
+            return nullptr;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "append")
+
+        tempItem = parseJson(item->toValue(),
+                             errorMessage);
+
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "unique")
+    {
+        if(functionItem.arguments.size() != 0)
         {
-            if(functionItem.arguments.size() != 1)
-            {
-                errorMessage = type + "-function requires 1 argument";
-                return false;
-            }
+            errorMessage = type + "-function requires 0 arguments";
+            return nullptr;
+        }
 
-            ValueItem arg = functionItem.arguments.at(0);
-            if(fillValueItem(arg, insertValues, errorMessage) == false) {
-                return false;
-            }
+        tempItem = uniqueValue(item->toArray(),
+                               errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+    if(type == "intersect"
+            || type == "difference")
+    {
+        if(functionItem.arguments.size() != 1)
+        {
+            errorMessage = type + "-function requires 1 argument";
+            return nullptr;
+        }
 
-            tempItem = appendValue(valueItem.item->toArray(),
-                                   arg.item,
-                                   errorMessage);
+        ValueItem arg = functionItem.arguments.at(0);
+        if(fillValueItem(arg, insertValues, errorMessage) == false) {
+            return nullptr;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "clear_empty")
+
+        tempItem = filterBySet(item->toArray(),
+                               arg.item->toArray(),
+                               type == "intersect",
+                               errorMessage);
+    }
+    //----------------------------------------------------------------------------------------------
+
+    return tempItem;
+}
+
+/**
+ * @brief process the next function-call of a chain of function-calls. A parse_json-call, which
+ *        is followed by get-calls, is fused together with them into a single path-query, so
+ *        only the requested part of the json-string is converted.
+ *
+ * @param item data-item, on which the function should be called
+ * @param functions chain of function-calls
+ * @param position position of the next function-call in the chain. It is moved behind all
+ *                 function-calls, which were processed.
+ * @param insertValues data-map with information to fill the arguments of the functions
+ * @param errorMessage error-message for output
+ *
+ * @return result of the function-calls as new data-item, or nullptr, if failed
+ */
+DataItem*
+processNextFunction(DataItem* item,
+                    const std::vector<FunctionItem> &functions,
+                    uint64_t &position,
+                    DataMap &insertValues,
+                    std::string &errorMessage)
+{
+    const FunctionItem &functionItem = functions.at(position);
+
+    // collect the get-calls directly after a parse_json-call
+    uint64_t end = position + 1;
+    if(functionItem.type == "parse_json"
+            && functionItem.arguments.size() == 0)
+    {
+        while(end < functions.size()
+              && functions.at(end).type == "get"
+              && functions.at(end).arguments.size() == 1)
         {
-            if(functionItem.arguments.size() != 0)
-            {
-                errorMessage = type + "-function requires 0 arguments";
-                return false;
-            }
+            end++;
+        }
+    }
 
-            tempItem = clearEmpty(valueItem.item->toArray(),
-                                  errorMessage);
+    // process single function-call
+    if(end == position + 1)
+    {
+        position++;
+        return processFunction(item, functionItem, insertValues, errorMessage);
+    }
 
+    // fill the keys of all get-calls and query the json-string with them as path
+    std::vector<ValueItem> keys;
+    keys.reserve(end - position - 1);
+    std::vector<DataValue*> path;
+    for(uint64_t i = position + 1; i < end; i++)
+    {
+        keys.push_back(functions.at(i).arguments.at(0));
+        if(fillValueItem(keys.back(), insertValues, errorMessage) == false) {
+            return nullptr;
         }
-        //------------------------------------------------------------------------------------------
-        if(type == "parse_json")
+
+        // like the get-function, only values can be used as key or position
+        DataValue* key = keys.back().item->toValue();
+        if(key == nullptr)
         {
-            if(functionItem.arguments.size() != 0)
-            {
-                errorMessage = type + "-function requires 0 arguments";
-                return false;
-            }
+            errorMessage = "inputs for get-function are invalid";
+            return nullptr;
+        }
+        path.push_back(key);
+    }
 
-            tempItem = parseJson(valueItem.item->toValue(),
-                                 errorMessage);
+    position = end;
+    return parseJsonPath(item->toValue(), path, errorMessage);
+}
 
+/**
+ * @brief process a value-item by handling its function-calls
+ *
+ * @param valueItem value-item, which should be processed
+ * @param insertValues data-map with information to fill into the jinja2-string
+ * @param errorMessage error-message for output
+ * @param firstFunction position of the first function-call, which should be processed
+ *
+ * @return false, if something went wrong while processing and filling, else true. If false
+ *         an error-message was sent directly into the sakura-root-object
+*/
+bool
+getProcessedItem(ValueItem &valueItem,
+                 DataMap &insertValues,
+                 std::string &errorMessage,
+                 const uint64_t firstFunction)
+{
+    uint64_t position = firstFunction;
+    while(position < valueItem.functions.size())
+    {
+        if(valueItem.item == nullptr) {
+            return false;
         }
-        //------------------------------------------------------------------------------------------
 
+        DataItem* tempItem = processNextFunction(valueItem.item,
+                                                 valueItem.functions,
+                                                 position,
+                                                 insertValues,
+                                                 errorMessage);
         delete valueItem.item;
         valueItem.item = tempItem;
 
@@ -229,11 +363,29 @@ fillIdentifierItem(ValueItem &valueItem,
     }
 
     delete valueItem.item;
-    valueItem.item = tempItem->copy();
+    valueItem.item = nullptr;
     valueItem.isIdentifier = false;
-    valueItem.functions = valueItem.functions;
 
-    return getProcessedItem(valueItem, insertValues, errorMessage);
+    // without functions the item itself is the result and has to be copied
+    if(valueItem.functions.size() == 0)
+    {
+        valueItem.item = tempItem->copy();
+        return true;
+    }
+
+    // none of the functions modifies its input, so the first one can work directly on the item
+    // of the insert-values, instead of a copy of a maybe large array or map
+    uint64_t position = 0;
+    valueItem.item = processNextFunction(tempItem,
+                                         valueItem.functions,
+                                         position,
+                                         insertValues,
+                                         errorMessage);
+    if(valueItem.item == nullptr) {
+        return false;
+    }
+
+    return getProcessedItem(valueItem, insertValues, errorMessage, position);
 }
 
 /**
@@ -287,12 +439,19 @@ fillValueItem(ValueItem &valueItem,
               DataMap &insertValues,
               std::string &errorMessage)
 {
-    // process and fill incoming string, which is interpreted as jinja2-template
+    // process and fill incoming string, which is interpreted as jinja2-template. Strings without
+    // any jinja2-syntax don't need the converter.
     if(valueItem.isIdentifier == false
             && valueItem.type != ValueItem::OUTPUT_PAIR_TYPE
             && valueItem.item->isStringValue())
     {
-        return fillJinja2Template(valueItem, insertValues, errorMessage);
+        if(isJinja2Template(valueItem.item->toValue()->getString())
+                && fillJinja2Template(valueItem, insertValues, errorMessage) == false)
+        {
+            return false;
+        }
+
+        return getProcessedItem(valueItem, insertValues, errorMessage);
     }
     // process and fill incoming identifier
     else if(valueItem.isIdentifier
@@ -309,6 +468,21 @@ fillValueItem(ValueItem &valueItem,
     return true;
 }
 
+/**
+ * @brief check if a string contains any jinja2-syntax
+ *
+ * @param input string to check
+ *
+ * @return true, if the string contains an expression, statement or comment, else false
+ */
+bool
+isJinja2Template(const std::string &input)
+{
+    return input.find("{{") != std::string::npos
+            || input.find("{%") != std::string::npos
+            || input.find("{#") != std::string::npos;
+}
+
 /**
  * @brief fill the entries of a value-item-map with the information of the values of in incoming
  *        data-map, which processing all functions within the value-item-map
@@ -352,17 +526,23 @@ fillInputValueItemMap(ValueItemMap &items,
 }
 
 /**
- * @brief wirte the output back into a value-item-map
+ * @brief wirte the output back into a value-item-map. The output-items are moved out of the
+ *        output-map instead of copying them.
  *
  * @param items value-item-map, where the output should be inserted
  * @param output output of the blossom-item as data-item
+ * @param errorMessage error-message for output
  *
- * @return true, if the output was written in at least one point of the value-item-map
+ * @return false, if an output is missing in the output-map, else true
  */
 bool
 fillOutputValueItemMap(ValueItemMap &items,
-                       DataMap &output)
+                       DataMap &output,
+                       std::string &errorMessage)
 {
+    // output-items, which were already moved, for the case, that an output is used multiple times
+    std::map<std::string, DataItem*> movedItems;
+
     std::map<std::string, ValueItem>::iterator it;
     for(it = items.m_valueMap.begin();
         it != items.m_valueMap.end();
@@ -371,17 +551,38 @@ fillOutputValueItemMap(ValueItemMap &items,
         // replace only as output-marked values
         if(it->second.type == ValueItem::OUTPUT_PAIR_TYPE)
         {
-            DataItem* tempItem = output.get(it->second.item->toString());
-            if(tempItem == nullptr)
+            if(it->second.item == nullptr)
             {
-                // TODO: error-output
+                errorMessage = "name of the output for the value " + it->first + " is missing";
                 return false;
             }
 
-            ValueItem valueItem;
-            valueItem.item = tempItem->copy();
-            valueItem.type = ValueItem::OUTPUT_PAIR_TYPE;
-            it->second = valueItem;
+            const std::string outputName = it->second.item->toString();
+            DataItem* tempItem = nullptr;
+
+            std::map<std::string, DataItem*>::iterator outputIt;
+            outputIt = output.m_map.find(outputName);
+            if(outputIt != output.m_map.end())
+            {
+                tempItem = outputIt->second;
+                output.m_map.erase(outputIt);
+                movedItems.insert(std::make_pair(outputName, tempItem));
+            }
+            else
+            {
+                std::map<std::string, DataItem*>::const_iterator movedIt;
+                movedIt = movedItems.find(outputName);
+                if(movedIt == movedItems.end())
+                {
+                    errorMessage = "output " + outputName + " for the value "
+                                   + it->first + " was not set";
+                    return false;
+                }
+                tempItem = movedIt->second->copy();
+            }
+
+            delete it->second.item;
+            it->second.item = tempItem;
         }
     }
 
@@ -466,7 +667,9 @@ overrideItems(DataMap &original,
             std::map<std::string, DataItem*>::iterator originalIt;
             originalIt = original.m_map.find(overrideIt->first);
 
-            if(originalIt != original.m_map.end()) {
+            if(originalIt != original.m_map.end()
+                    && overrideIt->second.item != nullptr)
+            {
                 original.insert(overrideIt->first, overrideIt->second.item->copy(), true);
             }
         }
@@ -481,7 +684,9 @@ overrideItems(DataMap &original,
             std::map<std::string, DataItem*>::iterator originalIt;
             originalIt = original.m_map.find(overrideIt->first);
 
-            if(originalIt == original.m_map.end()) {
+            if(originalIt == original.m_map.end()
+                    && overrideIt->second.item != nullptr)
+            {
                 original.insert(overrideIt->first, overrideIt->second.item->copy(), true);
             }
         }
@@ -493,7 +698,9 @@ overrideItems(DataMap &original,
             overrideIt != override.m_valueMap.end();
             overrideIt++)
         {
-            original.insert(overrideIt->first, overrideIt->second.item->copy(), true);
+            if(overrideIt->second.item != nullptr) {
+                original.insert(overrideIt->first, overrideIt->second.item->copy(), true);
+            }
         }
     }
 }
@@ -558,6 +765,648 @@ overrideItems(ValueItemMap &original,
     }
 }
 
+/**
+ * @brief move all items of a data-map into another data-map without copying them. Existing
+ *        items with the same key are replaced.
+ *
+ * @param original data-map, which should be updated
+ * @param source data-map with the new items, which is empty afterwards
+ */
+void
+moveItems(DataMap &original,
+          DataMap &source)
+{
+    std::map<std::string, DataItem*>::iterator it;
+    for(it = source.m_map.begin();
+        it != source.m_map.end();
+        it++)
+    {
+        original.insert(it->first, it->second, true);
+    }
+
+    source.m_map.clear();
+}
+
+/**
+ * @brief move the items of a data-map into another data-map without copying them, but only for
+ *        keys, which already exist in the target. The moved items are removed from the source.
+ *
+ * @param original data-map, whose existing items should be replaced
+ * @param source data-map with the new items
+ */
+void
+moveExistingItems(DataMap &original,
+                  DataMap &source)
+{
+    std::map<std::string, DataItem*>::iterator originalIt;
+    for(originalIt = original.m_map.begin();
+        originalIt != original.m_map.end();
+        originalIt++)
+    {
+        std::map<std::string, DataItem*>::iterator sourceIt;
+        sourceIt = source.m_map.find(originalIt->first);
+        if(sourceIt == source.m_map.end()) {
+            continue;
+        }
+
+        delete originalIt->second;
+        originalIt->second = sourceIt->second;
+        source.m_map.erase(sourceIt);
+    }
+}
+
+/**
+ * @brief remove all items from a data-map, whose keys are not in a list of keys. This restores
+ *        the scope of a data-map without a complete backup of all its items.
+ *
+ * @param values data-map, which should be cleared
+ * @param keys sorted list of keys, which should be kept
+ */
+void
+removeAdditionalItems(DataMap &values,
+                      const std::vector<std::string> &keys)
+{
+    std::vector<std::string>::const_iterator keyIt = keys.begin();
+    std::map<std::string, DataItem*>::iterator it = values.m_map.begin();
+
+    while(it != values.m_map.end())
+    {
+        // both are sorted, so they can be compared by walking through them together
+        while(keyIt != keys.end()
+              && *keyIt < it->first)
+        {
+            keyIt++;
+        }
+
+        if(keyIt != keys.end()
+                && *keyIt == it->first)
+        {
+            it++;
+            continue;
+        }
+
+        delete it->second;
+        it = values.m_map.erase(it);
+    }
+}
+
+/**
+ * @brief move the output-values of a value-item-map into a data-map without copying them.
+ *        Like with overrideItems only existing items are replaced and all other values of the
+ *        value-item-map are not written back.
+ *
+ * @param original data-map, whose existing items should be replaced
+ * @param items value-item-map with the output-values. Their items are empty afterwards.
+ */
+void
+moveOutputItems(DataMap &original,
+                ValueItemMap &items)
+{
+    std::map<std::string, ValueItem>::iterator it;
+    for(it = items.m_valueMap.begin();
+        it != items.m_valueMap.end();
+        it++)
+    {
+        if(it->second.type != ValueItem::OUTPUT_PAIR_TYPE
+                || it->second.item == nullptr)
+        {
+            continue;
+        }
+
+        std::map<std::string, DataItem*>::iterator originalIt;
+        originalIt = original.m_map.find(it->first);
+        if(originalIt == original.m_map.end()) {
+            continue;
+        }
+
+        delete originalIt->second;
+        originalIt->second = it->second.item;
+        it->second.item = nullptr;
+    }
+}
+
+/**
+ * @brief move all written items out of the current data-map. Written items are collected even
+ *        if they didn't exist before or if their new value is equal to the old one, so the last
+ *        writer wins, when the changes of multiple data-maps are applied. Only the written items
+ *        are touched, so the costs don't depend on the size of the scope.
+ *
+ * @param changedItems data-map for all written items
+ * @param current data-map with the current values, where the written items are moved from
+ * @param writtenItems names of all items, which were written
+ */
+void
+collectChangedItems(DataMap &changedItems,
+                    DataMap &current,
+                    const std::set<std::string> &writtenItems)
+{
+    std::set<std::string>::const_iterator writtenIt;
+    for(writtenIt = writtenItems.begin();
+        writtenIt != writtenItems.end();
+        writtenIt++)
+    {
+        std::map<std::string, DataItem*>::iterator currentIt;
+        currentIt = current.m_map.find(*writtenIt);
+        if(currentIt == current.m_map.end()) {
+            continue;
+        }
+
+        // move the item instead of copying it, because the current values are not used anymore
+        changedItems.insert(currentIt->first, currentIt->second, true);
+        current.m_map.erase(currentIt);
+    }
+}
+
+/**
+ * @brief move all reduce-values of a value-item-map into a separate map
+ *
+ * @param values value-item-map with the values of a loop- or parallel-header
+ * @param reductions value-item-map, where the reduce-values should be moved to
+ */
+void
+separateReductions(ValueItemMap &values,
+                   ValueItemMap &reductions)
+{
+    std::map<std::string, ValueItem>::iterator it = values.m_valueMap.begin();
+    while(it != values.m_valueMap.end())
+    {
+        if(it->second.type == ValueItem::REDUCE_PAIR_TYPE)
+        {
+            reductions.insert(it->first, it->second, true);
+            it = values.m_valueMap.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+/**
+ * @brief initialize the results of all reductions with their start-values
+ *
+ * @param result data-map for the results of the reductions
+ * @param reductions value-item-map with all reduce-values
+ */
+void
+initReduceValues(DataMap &result,
+                 const ValueItemMap &reductions)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = reductions.m_valueMap.begin();
+        it != reductions.m_valueMap.end();
+        it++)
+    {
+        result.insert(it->first, createReduceStartValue(it->second.reduceType), true);
+    }
+}
+
+/**
+ * @brief collect the contribution of a single iteration to all reductions
+ *
+ * @param contribution data-map for the filled values of the iteration
+ * @param reductions value-item-map with all reduce-values
+ * @param insertValues data-map with the values of the iteration to fill the reduce-values
+ * @param errorMessage error-message for output
+ *
+ * @return true, if successful, else false
+ */
+bool
+collectReduceValues(DataMap &contribution,
+                    const ValueItemMap &reductions,
+                    DataMap &insertValues,
+                    std::string &errorMessage)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = reductions.m_valueMap.begin();
+        it != reductions.m_valueMap.end();
+        it++)
+    {
+        // fill a copy of the value, because the original is used again by the other iterations
+        ValueItem valueItem = it->second;
+        valueItem.type = ValueItem::INPUT_PAIR_TYPE;
+        if(fillValueItem(valueItem, insertValues, errorMessage) == false) {
+            return false;
+        }
+
+        // move the filled item into the contribution
+        contribution.insert(it->first, valueItem.item, true);
+        valueItem.item = nullptr;
+    }
+
+    return true;
+}
+
+/**
+ * @brief merge the contribution of a single iteration into the results of all reductions.
+ *        Contributions have to be merged in the order of the iterations, to get the same result
+ *        independent from the order in which the iterations were processed.
+ *
+ * @param result data-map with the current results of the reductions
+ * @param reductions value-item-map with all reduce-values
+ * @param contribution data-map with the filled values of the iteration. The items are moved
+ *                     into the result, so the map is empty afterwards.
+ * @param errorMessage error-message for output
+ *
+ * @return true, if successful, else false
+ */
+bool
+mergeReduceValues(DataMap &result,
+                  const ValueItemMap &reductions,
+                  DataMap &contribution,
+                  std::string &errorMessage)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = reductions.m_valueMap.begin();
+        it != reductions.m_valueMap.end();
+        it++)
+    {
+        std::map<std::string, DataItem*>::iterator contributionIt;
+        contributionIt = contribution.m_map.find(it->first);
+        if(contributionIt == contribution.m_map.end()) {
+            continue;
+        }
+
+        // take the item out of the contribution-map to avoid a copy
+        DataItem* value = contributionIt->second;
+        contribution.m_map.erase(contributionIt);
+
+        std::map<std::string, DataItem*>::iterator resultIt = result.m_map.find(it->first);
+        if(resultIt == result.m_map.end())
+        {
+            delete value;
+            continue;
+        }
+
+        if(reduceValue(resultIt->second, value, it->second.reduceType, errorMessage) == false)
+        {
+            errorMessage = createError("reduce", "error while reducing value "
+                                       + it->first + ":\n" + errorMessage);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief combine the results of all reductions over two neighbouring ranges of iterations. The
+ *        results of the following range are merged behind the results of the first range, so
+ *        ranges can be combined in any grouping, as long as their order is kept.
+ *
+ * @param result data-map with the results of the first range, which are updated
+ * @param reductions value-item-map with all reduce-values
+ * @param other data-map with the results of the following range. The items are moved into the
+ *              result, so the map is empty afterwards.
+ * @param errorMessage error-message for output
+ *
+ * @return true, if successful, else false
+ */
+bool
+combineReduceValues(DataMap &result,
+                    const ValueItemMap &reductions,
+                    DataMap &other,
+                    std::string &errorMessage)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = reductions.m_valueMap.begin();
+        it != reductions.m_valueMap.end();
+        it++)
+    {
+        std::map<std::string, DataItem*>::iterator otherIt = other.m_map.find(it->first);
+        if(otherIt == other.m_map.end()) {
+            continue;
+        }
+
+        // take the item out of the other map to avoid a copy
+        DataItem* value = otherIt->second;
+        other.m_map.erase(otherIt);
+
+        std::map<std::string, DataItem*>::iterator resultIt = result.m_map.find(it->first);
+        if(resultIt == result.m_map.end())
+        {
+            result.insert(it->first, value, true);
+            continue;
+        }
+
+        if(combineReduceResults(resultIt->second,
+                                value,
+                                it->second.reduceType,
+                                errorMessage) == false)
+        {
+            errorMessage = createError("reduce", "error while reducing value "
+                                       + it->first + ":\n" + errorMessage);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief convert a string-value, which contains only a number, into a number-value
+ *
+ * @param item item to convert
+ *
+ * @return new number-value or nullptr, if the item is not a string with only a number
+ */
+DataValue*
+convertNumberString(DataItem* item)
+{
+    if(item->isStringValue() == false) {
+        return nullptr;
+    }
+
+    const std::string value = item->toValue()->getString();
+    if(value.size() == 0
+            || std::isspace(static_cast<unsigned char>(value.at(0))))
+    {
+        return nullptr;
+    }
+
+    char* end = nullptr;
+    errno = 0;
+    const long longValue = std::strtol(value.c_str(), &end, 10);
+    if(*end == '\0'
+            && errno == 0)
+    {
+        return new DataValue(longValue);
+    }
+
+    errno = 0;
+    const double doubleValue = std::strtod(value.c_str(), &end);
+    if(*end == '\0'
+            && errno == 0
+            && std::isfinite(doubleValue))
+    {
+        return new DataValue(doubleValue);
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief compare the two sides of an if-condition. Rendered jinja2-strings are always strings,
+ *        so a string, which contains only a number, is compared as number with a number.
+ *
+ * @param result reference for the result of the comparison
+ * @param leftSide left side of the comparison
+ * @param rightSide right side of the comparison
+ * @param compareType type of the comparison
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if the compare-type is not supported for the values, else true
+ */
+bool
+compareItems(bool &result,
+             DataItem* leftSide,
+             DataItem* rightSide,
+             const IfBranching::compareTypes compareType,
+             std::string &errorMessage)
+{
+    DataValue* leftNumber = nullptr;
+    DataValue* rightNumber = nullptr;
+    if(rightSide->isIntValue() || rightSide->isFloatValue()) {
+        leftNumber = convertNumberString(leftSide);
+    }
+    if(leftSide->isIntValue() || leftSide->isFloatValue()) {
+        rightNumber = convertNumberString(rightSide);
+    }
+
+    const bool ret = compareValues(result,
+                                   leftNumber != nullptr ? leftNumber : leftSide,
+                                   rightNumber != nullptr ? rightNumber : rightSide,
+                                   compareType,
+                                   errorMessage);
+
+    delete leftNumber;
+    delete rightNumber;
+
+    return ret;
+}
+
+/**
+ * @brief compare two values by their type
+ *
+ * @param result reference for the result of the comparison
+ * @param leftSide left side of the comparison
+ * @param rightSide right side of the comparison
+ * @param compareType type of the comparison
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if the compare-type is not supported for the values, else true
+ */
+bool
+compareValues(bool &result,
+              DataItem* leftSide,
+              DataItem* rightSide,
+              const IfBranching::compareTypes compareType,
+              std::string &errorMessage)
+{
+    // get order of the two values as -1, 0 or 1
+    int order = 0;
+    bool orderable = true;
+
+    if((leftSide->isIntValue() || leftSide->isFloatValue())
+            && (rightSide->isIntValue() || rightSide->isFloatValue()))
+    {
+        // numbers
+        if(leftSide->isIntValue()
+                && rightSide->isIntValue())
+        {
+            const long left = leftSide->toValue()->getLong();
+            const long right = rightSide->toValue()->getLong();
+            order = (left > right) - (left < right);
+        }
+        else
+        {
+            const double left = leftSide->isIntValue() ? leftSide->toValue()->getLong()
+                                                       : leftSide->toValue()->getDouble();
+            const double right = rightSide->isIntValue() ? rightSide->toValue()->getLong()
+                                                         : rightSide->toValue()->getDouble();
+            order = (left > right) - (left < right);
+        }
+    }
+    else if(leftSide->isBoolValue()
+            && rightSide->isBoolValue())
+    {
+        // bools can only be compared for equality
+        order = leftSide->toValue()->getBool() != rightSide->toValue()->getBool();
+        orderable = false;
+    }
+    else if(leftSide->isStringValue()
+            && rightSide->isStringValue())
+    {
+        // strings are ordered lexicographical
+        const int compareResult = leftSide->toValue()->getString().compare(
+                    rightSide->toValue()->getString());
+        order = (compareResult > 0) - (compareResult < 0);
+    }
+    else if(leftSide->isMap() || leftSide->isArray()
+            || rightSide->isMap() || rightSide->isArray())
+    {
+        // maps and arrays are compared by their structure and only for equality
+        order = isEqualItem(leftSide, rightSide) == false;
+        orderable = false;
+    }
+    else
+    {
+        // mixed types of values are only compared for equality by their string-content
+        order = leftSide->toString() != rightSide->toString();
+        orderable = false;
+    }
+
+    switch(compareType)
+    {
+        case IfBranching::EQUAL:
+            result = order == 0;
+            return true;
+        case IfBranching::UNEQUAL:
+            result = order != 0;
+            return true;
+        default:
+            break;
+    }
+
+    if(orderable == false)
+    {
+        errorMessage = "values of different types, bools, maps and arrays can only be "
+                       "compared with \"==\" and \"!=\"";
+        return false;
+    }
+
+    switch(compareType)
+    {
+        case IfBranching::GREATER_EQUAL:
+            result = order >= 0;
+            return true;
+        case IfBranching::GREATER:
+            result = order > 0;
+            return true;
+        case IfBranching::SMALLER_EQUAL:
+            result = order <= 0;
+            return true;
+        case IfBranching::SMALLER:
+            result = order < 0;
+            return true;
+        default:
+            break;
+    }
+
+    errorMessage = "compare-type is not supported";
+    return false;
+}
+
+/**
+ * @brief check if two items are equal. Maps are equal, if they have the same keys with equal
+ *        values, and arrays are equal, if they have equal values in the same order. Values are
+ *        compared like in if-conditions, so the integer 1 is equal to the float 1.0.
+ *
+ * @param leftSide first item
+ * @param rightSide second item
+ *
+ * @return true, if both items are equal, else false
+ */
+bool
+isEqualItem(DataItem* leftSide,
+            DataItem* rightSide)
+{
+    if(leftSide == nullptr
+            || rightSide == nullptr)
+    {
+        return leftSide == rightSide;
+    }
+
+    // maps
+    if(leftSide->isMap()
+            && rightSide->isMap())
+    {
+        DataMap* leftMap = leftSide->toMap();
+        DataMap* rightMap = rightSide->toMap();
+        if(leftMap->m_map.size() != rightMap->m_map.size()) {
+            return false;
+        }
+
+        std::map<std::string, DataItem*>::const_iterator leftIt;
+        for(leftIt = leftMap->m_map.begin();
+            leftIt != leftMap->m_map.end();
+            leftIt++)
+        {
+            std::map<std::string, DataItem*>::const_iterator rightIt;
+            rightIt = rightMap->m_map.find(leftIt->first);
+            if(rightIt == rightMap->m_map.end()
+                    || isEqualItem(leftIt->second, rightIt->second) == false)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // arrays
+    if(leftSide->isArray()
+            && rightSide->isArray())
+    {
+        DataArray* leftArray = leftSide->toArray();
+        DataArray* rightArray = rightSide->toArray();
+        if(leftArray->m_array.size() != rightArray->m_array.size()) {
+            return false;
+        }
+
+        for(uint64_t i = 0; i < leftArray->m_array.size(); i++)
+        {
+            if(isEqualItem(leftArray->m_array.at(i), rightArray->m_array.at(i)) == false) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // a map or an array is never equal to another type
+    if(leftSide->isMap() || leftSide->isArray()
+            || rightSide->isMap() || rightSide->isArray())
+    {
+        return false;
+    }
+
+    bool result = false;
+    std::string errorMessage = "";
+    compareValues(result, leftSide, rightSide, IfBranching::EQUAL, errorMessage);
+
+    return result;
+}
+
+/**
+ * @brief convert the compare-operator of the parser into the compare-type of an if-condition
+ *
+ * @param compareOperator compare-operator as string
+ *
+ * @return compare-type of the operator
+ */
+IfBranching::compareTypes
+getCompareType(const std::string &compareOperator)
+{
+    if(compareOperator == ">=") {
+        return IfBranching::GREATER_EQUAL;
+    }
+    if(compareOperator == ">") {
+        return IfBranching::GREATER;
+    }
+    if(compareOperator == "<=") {
+        return IfBranching::SMALLER_EQUAL;
+    }
+    if(compareOperator == "<") {
+        return IfBranching::SMALLER;
+    }
+    if(compareOperator == "!=") {
+        return IfBranching::UNEQUAL;
+    }
+
+    return IfBranching::EQUAL;
+}
+
 /**
  * @brief check if given values match with existing one of a value-item-map
  *
@@ -643,31 +1492,46 @@ convertBlossomOutput(const BlossomLeaf &blossom)
 }
 
 /**
- * @brief convert value-item-map into data-map
+ * @brief move the items of a value-item-map into a data-map without copying them. The moved
+ *        items are owned by the data-map afterwards and the value-items stay empty, so changes
+ *        of the blossom on its input are never visible in the value-item-map. Only the names of
+ *        the outputs are copied, because they are still necessary to write back the outputs.
  *
  * @param result resulting data-map
  * @param input input value-item-map
  */
 void
-convertValueMap(DataMap &result, const ValueItemMap &input)
+moveValueMap(DataMap &result,
+             ValueItemMap &input)
 {
-    // fill values
-    std::map<std::string, ValueItem>::const_iterator it;
+    // move values
+    std::map<std::string, ValueItem>::iterator it;
     for(it = input.m_valueMap.begin();
         it != input.m_valueMap.end();
         it++)
     {
-        result.insert(it->first, it->second.item->copy());
+        if(it->second.item == nullptr) {
+            continue;
+        }
+
+        if(it->second.type == ValueItem::OUTPUT_PAIR_TYPE)
+        {
+            result.insert(it->first, it->second.item->copy());
+            continue;
+        }
+
+        result.insert(it->first, it->second.item);
+        it->second.item = nullptr;
     }
 
-    // fill childs
+    // move childs
     std::map<std::string, ValueItemMap*>::const_iterator itChild;
     for(itChild = input.m_childMaps.begin();
         itChild != input.m_childMaps.end();
         itChild++)
     {
         DataMap* internalMap = new DataMap();
-        convertValueMap(*internalMap, *itChild->second);
+        moveValueMap(*internalMap, *itChild->second);
         result.insert(itChild->first, internalMap);
     }
 }
@@ -694,7 +1558,34 @@ createError(const BlossomItem &blossomItem,
                        blossomItem.blossomType,
                        blossomItem.blossomGroupType,
                        blossomItem.blossomName,
-                       blossomPath);
+                       blossomPath,
+                       blossomItem.span);
+}
+
+/**
+ * @brief create an error-output for an item, which is not a blossom
+ *
+ * @param sakuraItem item with the position of the error within the file
+ * @param filePath path of the file, which contains the item
+ * @param errorLocation location where the error appeared
+ * @param errorMessage message to describe, what was wrong
+ * @param possibleSolution message with a possible solution to solve the problem
+ */
+const std::string
+createError(const SakuraItem &sakuraItem,
+            const std::string &filePath,
+            const std::string &errorLocation,
+            const std::string &errorMessage,
+            const std::string &possibleSolution)
+{
+    return createError(errorLocation,
+                       errorMessage,
+                       possibleSolution,
+                       "",
+                       "",
+                       "",
+                       filePath,
+                       sakuraItem.span);
 }
 
 /**
@@ -721,7 +1612,8 @@ createError(const BlossomLeaf &blossomLeaf,
 }
 
 /**
- * @brief create an error-output
+ * @brief create an error-output as compact error-record. The record is only rendered into a
+ *        table, when it leaves the interface, so wrapping it into outer errors is cheap.
  *
  * @param errorLocation location where the error appeared
  * @param errorMessage message to describe, what was wrong
@@ -730,6 +1622,7 @@ createError(const BlossomLeaf &blossomLeaf,
  * @param blossomGroup type of the blossom-group, where the error appeared
  * @param blossomName name of the blossom in the script to specify the location
  * @param blossomFilePath file-path, where the error had appeared
+ * @param span position of the item within the file, where the error had appeared
  */
 const std::string
 createError(const std::string &errorLocation,
@@ -738,36 +1631,50 @@ createError(const std::string &errorLocation,
             const std::string &blossomType,
             const std::string &blossomGroupType,
             const std::string &blossomName,
-            const std::string &blossomFilePath)
+            const std::string &blossomFilePath,
+            const SourceSpan &span)
 {
-    Kitsunemimi::TableItem errorOutput;
-    // initialize error-output
-    errorOutput.addColumn("Field");
-    errorOutput.addColumn("Value");
+    // errors of inner calls are not part of the message of this error, but follow this error
+    // as separate records
+    const uint64_t innerStart = errorMessage.find(ERROR_RECORD_SEPARATOR);
+
+    std::string record(1, ERROR_RECORD_SEPARATOR);
 
     if(errorLocation.size() > 0) {
-        errorOutput.addRow(std::vector<std::string>{"location", errorLocation});
+        ErrorContainer::addField(record, "location", errorLocation);
     }
 
     if(possibleSolution.size() > 0) {
-        errorOutput.addRow(std::vector<std::string>{"possible solution", possibleSolution});
+        ErrorContainer::addField(record, "possible solution", possibleSolution);
     }
     if(blossomType.size() > 0) {
-        errorOutput.addRow(std::vector<std::string>{"blossom-type", blossomType});
+        ErrorContainer::addField(record, "blossom-type", blossomType);
     }
     if(blossomGroupType.size() > 0) {
-        errorOutput.addRow(std::vector<std::string>{"blossom-group-type", blossomGroupType});
+        ErrorContainer::addField(record, "blossom-group-type", blossomGroupType);
     }
     if(blossomName.size() > 0) {
-        errorOutput.addRow(std::vector<std::string>{"blossom-name", blossomName});
+        ErrorContainer::addField(record, "blossom-name", blossomName);
     }
     if(blossomFilePath.size() > 0) {
-        errorOutput.addRow(std::vector<std::string>{"blossom-file-path", blossomFilePath});
+        ErrorContainer::addField(record, "blossom-file-path", blossomFilePath);
+    }
+    if(span.line > 0)
+    {
+        ErrorContainer::addField(record, "line-number", std::to_string(span.line));
+        ErrorContainer::addField(record, "position in line", std::to_string(span.column));
+    }
+
+    if(innerStart == std::string::npos)
+    {
+        ErrorContainer::addField(record, "error-message", errorMessage);
+        return record;
     }
 
-    errorOutput.addRow(std::vector<std::string>{"error-message", errorMessage});
+    ErrorContainer::addField(record, "error-message", errorMessage.substr(0, innerStart));
+    record.append(errorMessage, innerStart, std::string::npos);
 
-    return errorOutput.toString(200);
+    return record;
 }
 
 } // namespace Sakura
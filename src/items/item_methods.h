@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <string>
+#include <set>
 
 #include <libKitsunemimiCommon/common_items/data_items.h>
 
@@ -38,9 +39,19 @@ struct BlossomLeaf;
 
 using Kitsunemimi::DataMap;
 
+DataItem* processFunction(DataItem* item,
+                          const FunctionItem &functionItem,
+                          DataMap &insertValues,
+                          std::string &errorMessage);
+DataItem* processNextFunction(DataItem* item,
+                              const std::vector<FunctionItem> &functions,
+                              uint64_t &position,
+                              DataMap &insertValues,
+                              std::string &errorMessage);
 bool getProcessedItem(ValueItem &valueItem,
                       DataMap &insertValues,
-                      std::string &errorMessage);
+                      std::string &errorMessage,
+                      const uint64_t firstFunction = 0);
 
 // fill functions
 bool fillIdentifierItem(ValueItem &valueItem,
@@ -52,11 +63,13 @@ bool fillJinja2Template(ValueItem &valueItem,
 bool fillValueItem(ValueItem &valueItem,
                    DataMap &insertValues,
                    std::string &errorMessage);
+bool isJinja2Template(const std::string &input);
 bool fillInputValueItemMap(ValueItemMap &items,
                            DataMap &insertValues,
                            std::string &errorMessage);
 bool fillOutputValueItemMap(ValueItemMap &items,
-                            DataMap &output);
+                            DataMap &output,
+                            std::string &errorMessage);
 
 // override functions
 enum OverrideType
@@ -75,6 +88,51 @@ void overrideItems(DataMap &original,
 void overrideItems(ValueItemMap &original,
                    const ValueItemMap &override,
                    OverrideType type);
+void moveItems(DataMap &original,
+               DataMap &source);
+void moveExistingItems(DataMap &original,
+                       DataMap &source);
+void moveOutputItems(DataMap &original,
+                     ValueItemMap &items);
+void removeAdditionalItems(DataMap &values,
+                           const std::vector<std::string> &keys);
+void collectChangedItems(DataMap &changedItems,
+                         DataMap &current,
+                         const std::set<std::string> &writtenItems);
+
+// reduce functions
+void separateReductions(ValueItemMap &values,
+                        ValueItemMap &reductions);
+void initReduceValues(DataMap &result,
+                      const ValueItemMap &reductions);
+bool collectReduceValues(DataMap &contribution,
+                         const ValueItemMap &reductions,
+                         DataMap &insertValues,
+                         std::string &errorMessage);
+bool mergeReduceValues(DataMap &result,
+                       const ValueItemMap &reductions,
+                       DataMap &contribution,
+                       std::string &errorMessage);
+bool combineReduceValues(DataMap &result,
+                         const ValueItemMap &reductions,
+                         DataMap &other,
+                         std::string &errorMessage);
+
+// compare
+DataValue* convertNumberString(DataItem* item);
+bool compareItems(bool &result,
+                  DataItem* leftSide,
+                  DataItem* rightSide,
+                  const IfBranching::compareTypes compareType,
+                  std::string &errorMessage);
+bool compareValues(bool &result,
+                   DataItem* leftSide,
+                   DataItem* rightSide,
+                   const IfBranching::compareTypes compareType,
+                   std::string &errorMessage);
+bool isEqualItem(DataItem* leftSide,
+                 DataItem* rightSide);
+IfBranching::compareTypes getCompareType(const std::string &compareOperator);
 
 // check items
 const std::vector<std::string> checkInput(ValueItemMap &original,
@@ -83,8 +141,8 @@ const std::vector<std::string> checkItems(DataMap &items);
 
 // convert
 const std::string convertBlossomOutput(const BlossomLeaf &blossom);
-void convertValueMap(DataMap &result,
-                     const ValueItemMap &input);
+void moveValueMap(DataMap &result,
+                  ValueItemMap &input);
 
 // error-output
 const std::string createError(const BlossomItem &blossomItem,
@@ -92,6 +150,11 @@ const std::string createError(const BlossomItem &blossomItem,
                               const std::string &errorLocation,
                               const std::string &errorMessage,
                               const std::string &possibleSolution = "");
+const std::string createError(const SakuraItem &sakuraItem,
+                              const std::string &filePath,
+                              const std::string &errorLocation,
+                              const std::string &errorMessage,
+                              const std::string &possibleSolution = "");
 const std::string createError(const BlossomLeaf &blossomLeaf,
                               const std::string &errorLocation,
                               const std::string &errorMessage,
@@ -102,7 +165,8 @@ const std::string createError(const std::string &errorLocation,
                               const std::string &blossomType = "",
                               const std::string &blossomGroupType = "",
                               const std::string &blossomName = "",
-                              const std::string &blossomFilePath = "");
+                              const std::string &blossomFilePath = "",
+                              const SourceSpan &span = SourceSpan());
 
 } // namespace Sakura
 } // namespace Kitsunemimi
@@ -0,0 +1,589 @@
+/**
+ * @file        json_path_scanner.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "json_path_scanner.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include <libKitsunemimiCommon/common_items/data_items.h>
+#include <libKitsunemimiJson/json_item.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor
+ *
+ * @param input json-formated string, which must exist as long as the scanner is used
+ * @param size number of characters of the json-formated string
+ */
+JsonPathScanner::JsonPathScanner(const char* input,
+                                 const uint64_t size)
+    : m_input(input),
+      m_size(size) {}
+
+/**
+ * @brief search a value within the json-string and convert only this value into a data-item
+ *
+ * @param path keys of maps and positions in arrays, like they would be used by a chain of
+ *             get-function-calls on the completely parsed json-string
+ * @param errorMessage error-message for output
+ *
+ * @return nullptr, if failed, else a data-item with the requested value
+ */
+DataItem*
+JsonPathScanner::getValue(const std::vector<DataValue*> &path,
+                          std::string &errorMessage)
+{
+    m_pos = 0;
+    skipWhitespaces();
+
+    for(DataValue* key : path)
+    {
+        if(m_pos >= m_size)
+        {
+            errorMessage = "json-string ended unexpected";
+            return nullptr;
+        }
+
+        // go into a map
+        if(m_input[m_pos] == '{')
+        {
+            if(findInObject(key->toString(), errorMessage) == false) {
+                return nullptr;
+            }
+            continue;
+        }
+
+        // go into an array
+        if(m_input[m_pos] == '[')
+        {
+            if(key->isIntValue() == false)
+            {
+                errorMessage = "input for the get-function is not an integer-typed value-item";
+                return nullptr;
+            }
+            if(key->getLong() < 0)
+            {
+                errorMessage = "input for the get-function has a negative value";
+                return nullptr;
+            }
+
+            const uint64_t position = static_cast<uint64_t>(key->getLong());
+            if(findInArray(position, errorMessage) == false) {
+                return nullptr;
+            }
+            continue;
+        }
+
+        errorMessage = "item for calling the get-function is a value-item";
+        return nullptr;
+    }
+
+    return convertValue(errorMessage);
+}
+
+/**
+ * @brief search the first appearance of one of the given characters
+ *
+ * @param characters characters to search
+ * @param start position where the search begins
+ *
+ * @return position of the found character, or std::string::npos, if nothing was found
+ */
+uint64_t
+JsonPathScanner::findFirstOf(const char* characters,
+                             const uint64_t start) const
+{
+    for(uint64_t i = start; i < m_size; i++)
+    {
+        if(std::strchr(characters, m_input[i]) != nullptr) {
+            return i;
+        }
+    }
+
+    return std::string::npos;
+}
+
+/**
+ * @brief move the position behind all whitespaces
+ */
+void
+JsonPathScanner::skipWhitespaces()
+{
+    while(m_pos < m_size)
+    {
+        const char current = m_input[m_pos];
+        if(current != ' '
+                && current != '\n'
+                && current != '\r'
+                && current != '\t')
+        {
+            return;
+        }
+        m_pos++;
+    }
+}
+
+/**
+ * @brief move the position behind the value, which begins at the current position, without
+ *        converting it
+ *
+ * @param errorMessage error-message for output
+ *
+ * @return false, if the value is invalid, else true
+ */
+bool
+JsonPathScanner::skipValue(std::string &errorMessage)
+{
+    if(m_pos >= m_size)
+    {
+        errorMessage = "json-string ended unexpected";
+        return false;
+    }
+
+    const char first = m_input[m_pos];
+
+    // skip string
+    if(first == '"') {
+        return skipString(errorMessage);
+    }
+
+    // skip map or array by counting the brackets. Strings are skipped as a whole, because they
+    // can contain brackets.
+    if(first == '{'
+            || first == '[')
+    {
+        uint64_t depth = 0;
+        while(m_pos < m_size)
+        {
+            const char current = m_input[m_pos];
+            if(current == '"')
+            {
+                if(skipString(errorMessage) == false) {
+                    return false;
+                }
+                continue;
+            }
+
+            if(current == '{'
+                    || current == '[')
+            {
+                depth++;
+            }
+            else if(current == '}'
+                    || current == ']')
+            {
+                depth--;
+                if(depth == 0)
+                {
+                    m_pos++;
+                    return true;
+                }
+            }
+
+            m_pos++;
+        }
+
+        errorMessage = "json-string ended unexpected";
+        return false;
+    }
+
+    // skip number, bool or null
+    const uint64_t start = m_pos;
+    const uint64_t end = findFirstOf(",}] \n\r\t", m_pos);
+    m_pos = (end == std::string::npos) ? m_size : end;
+    if(m_pos == start)
+    {
+        errorMessage = "invalid value in json-string at position " + std::to_string(start);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief move the position behind the string, which begins at the current position
+ *
+ * @param errorMessage error-message for output
+ *
+ * @return false, if the string doesn't end, else true
+ */
+bool
+JsonPathScanner::skipString(std::string &errorMessage)
+{
+    m_pos++;
+
+    while(m_pos < m_size)
+    {
+        const uint64_t found = findFirstOf("\"\\", m_pos);
+        if(found == std::string::npos) {
+            break;
+        }
+
+        // skip escaped character
+        if(m_input[found] == '\\')
+        {
+            m_pos = found + 2;
+            continue;
+        }
+
+        m_pos = found + 1;
+        return true;
+    }
+
+    errorMessage = "string in json-string doesn't end";
+    return false;
+}
+
+/**
+ * @brief read the string, which begins at the current position, and resolve its escaped
+ *        characters
+ *
+ * @param result reference for the resulting string
+ * @param errorMessage error-message for output
+ *
+ * @return false, if the string is invalid, else true
+ */
+bool
+JsonPathScanner::readString(std::string &result,
+                            std::string &errorMessage)
+{
+    const uint64_t start = m_pos + 1;
+    if(skipString(errorMessage) == false) {
+        return false;
+    }
+
+    const std::string raw(m_input + start, m_pos - start - 1);
+    if(raw.find('\\') == std::string::npos)
+    {
+        result = raw;
+        return true;
+    }
+
+    // resolve escaped characters. Unicode-sequences are converted into utf-8.
+    result.clear();
+    for(uint64_t i = 0; i < raw.size(); i++)
+    {
+        if(raw.at(i) != '\\'
+                || i + 1 == raw.size())
+        {
+            result.push_back(raw.at(i));
+            continue;
+        }
+
+        i++;
+        switch(raw.at(i))
+        {
+            case 'b':
+                result.push_back('\b');
+                break;
+            case 'f':
+                result.push_back('\f');
+                break;
+            case 'n':
+                result.push_back('\n');
+                break;
+            case 'r':
+                result.push_back('\r');
+                break;
+            case 't':
+                result.push_back('\t');
+                break;
+            case 'u':
+            {
+                uint32_t code = 0;
+                if(readHex(raw, i + 1, code) == false)
+                {
+                    errorMessage = "invalid unicode-sequence in json-string";
+                    return false;
+                }
+                i += 4;
+
+                // characters outside of the basic multilingual plane are written as a pair of
+                // an high- and a low-surrogate, which have to be combined into one code-point
+                uint32_t lowSurrogate = 0;
+                if(code >= 0xD800
+                        && code <= 0xDBFF
+                        && i + 6 < raw.size()
+                        && raw.at(i + 1) == '\\'
+                        && raw.at(i + 2) == 'u'
+                        && readHex(raw, i + 3, lowSurrogate)
+                        && lowSurrogate >= 0xDC00
+                        && lowSurrogate <= 0xDFFF)
+                {
+                    code = 0x10000 + ((code - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                    i += 6;
+                }
+
+                if(code < 0x80)
+                {
+                    result.push_back(static_cast<char>(code));
+                }
+                else if(code < 0x800)
+                {
+                    result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                    result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                else if(code < 0x10000)
+                {
+                    result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                    result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                    result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                else
+                {
+                    result.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                    result.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                    result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                    result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                }
+                break;
+            }
+            default:
+                result.push_back(raw.at(i));
+                break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief read the 4 hex-digits of an unicode-sequence
+ *
+ * @param raw string with the unicode-sequence
+ * @param start position of the first hex-digit
+ * @param code reference for the resulting code-point
+ *
+ * @return false, if there are not 4 valid hex-digits at the position, else true
+ */
+bool
+JsonPathScanner::readHex(const std::string &raw,
+                         const uint64_t start,
+                         uint32_t &code)
+{
+    if(start + 4 > raw.size()) {
+        return false;
+    }
+
+    for(uint64_t i = start; i < start + 4; i++)
+    {
+        if(std::isxdigit(static_cast<unsigned char>(raw.at(i))) == 0) {
+            return false;
+        }
+    }
+
+    code = static_cast<uint32_t>(std::strtoul(raw.substr(start, 4).c_str(), nullptr, 16));
+    return true;
+}
+
+/**
+ * @brief search a key within the map, which begins at the current position, and move the
+ *        position to the begin of its value. Like with the complete parser, the last appearance
+ *        of a key wins.
+ *
+ * @param key key to search
+ * @param errorMessage error-message for output
+ *
+ * @return false, if the key doesn't exist or the map is invalid, else true
+ */
+bool
+JsonPathScanner::findInObject(const std::string &key,
+                              std::string &errorMessage)
+{
+    bool found = false;
+    uint64_t valuePos = 0;
+
+    m_pos++;
+    skipWhitespaces();
+    if(m_pos < m_size
+            && m_input[m_pos] == '}')
+    {
+        errorMessage = "key " + key + " doesn't exist in the map";
+        return false;
+    }
+
+    while(m_pos < m_size)
+    {
+        // read key
+        std::string currentKey;
+        if(m_input[m_pos] != '"'
+                || readString(currentKey, errorMessage) == false)
+        {
+            errorMessage = "invalid key in json-string at position " + std::to_string(m_pos);
+            return false;
+        }
+
+        skipWhitespaces();
+        if(m_pos >= m_size
+                || m_input[m_pos] != ':')
+        {
+            errorMessage = "missing ':' in json-string at position " + std::to_string(m_pos);
+            return false;
+        }
+        m_pos++;
+        skipWhitespaces();
+
+        // skip value
+        if(currentKey == key)
+        {
+            found = true;
+            valuePos = m_pos;
+        }
+        if(skipValue(errorMessage) == false) {
+            return false;
+        }
+
+        // go to next key or end of the map
+        skipWhitespaces();
+        if(m_pos < m_size
+                && m_input[m_pos] == ',')
+        {
+            m_pos++;
+            skipWhitespaces();
+            continue;
+        }
+        if(m_pos < m_size
+                && m_input[m_pos] == '}')
+        {
+            break;
+        }
+
+        errorMessage = "invalid map in json-string at position " + std::to_string(m_pos);
+        return false;
+    }
+
+    if(found == false)
+    {
+        errorMessage = "key " + key + " doesn't exist in the map";
+        return false;
+    }
+
+    m_pos = valuePos;
+    return true;
+}
+
+/**
+ * @brief move the position to the begin of an entry of the array, which begins at the current
+ *        position
+ *
+ * @param position position of the requested entry in the array
+ * @param errorMessage error-message for output
+ *
+ * @return false, if the array is too small or invalid, else true
+ */
+bool
+JsonPathScanner::findInArray(const uint64_t position,
+                             std::string &errorMessage)
+{
+    m_pos++;
+    skipWhitespaces();
+    if(m_pos < m_size
+            && m_input[m_pos] == ']')
+    {
+        errorMessage = "input value for get-function is too but for the array";
+        return false;
+    }
+
+    uint64_t counter = 0;
+    while(m_pos < m_size)
+    {
+        if(counter == position) {
+            return true;
+        }
+
+        if(skipValue(errorMessage) == false) {
+            return false;
+        }
+
+        // go to next entry or end of the array
+        skipWhitespaces();
+        if(m_pos < m_size
+                && m_input[m_pos] == ',')
+        {
+            m_pos++;
+            skipWhitespaces();
+            counter++;
+            continue;
+        }
+        if(m_pos < m_size
+                && m_input[m_pos] == ']')
+        {
+            errorMessage = "input value for get-function is too but for the array";
+            return false;
+        }
+
+        errorMessage = "invalid array in json-string at position " + std::to_string(m_pos);
+        return false;
+    }
+
+    errorMessage = "json-string ended unexpected";
+    return false;
+}
+
+/**
+ * @brief convert the value, which begins at the current position, into a data-item. Only this
+ *        part of the string is given to the json-parser, so the conversion is the same like
+ *        with the complete parsing.
+ *
+ * @param errorMessage error-message for output
+ *
+ * @return nullptr, if failed, else a data-item with the converted value
+ */
+DataItem*
+JsonPathScanner::convertValue(std::string &errorMessage)
+{
+    const uint64_t start = m_pos;
+    if(skipValue(errorMessage) == false) {
+        return nullptr;
+    }
+
+    const std::string valueString(m_input + start, m_pos - start);
+    const char first = valueString.at(0);
+
+    // maps and arrays can be parsed directly
+    Kitsunemimi::Json::JsonItem jsonItem;
+    if(first == '{'
+            || first == '[')
+    {
+        if(jsonItem.parse(valueString, errorMessage) == false) {
+            return nullptr;
+        }
+
+        return jsonItem.getItemContent()->copy();
+    }
+
+    // single values are packed into an array for the parser
+    if(jsonItem.parse("[" + valueString + "]", errorMessage) == false) {
+        return nullptr;
+    }
+
+    return jsonItem.getItemContent()->get(0)->copy();
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
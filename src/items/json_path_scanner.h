@@ -0,0 +1,80 @@
+/**
+ * @file        json_path_scanner.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_JSON_PATH_SCANNER_H
+#define KITSUNEMIMI_SAKURA_LANG_JSON_PATH_SCANNER_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class DataValue;
+
+namespace Sakura
+{
+
+/**
+ * @brief The JsonPathScanner class searches a single value within a json-formated string by a
+ *        path of keys and array-positions. All other parts of the string are only skipped and
+ *        never converted into data-items, so only the requested value is allocated.
+ */
+class JsonPathScanner
+{
+public:
+    JsonPathScanner(const char* input,
+                    const uint64_t size);
+
+    DataItem* getValue(const std::vector<DataValue*> &path,
+                       std::string &errorMessage);
+
+private:
+    const char* m_input = nullptr;
+    uint64_t m_size = 0;
+    uint64_t m_pos = 0;
+
+    uint64_t findFirstOf(const char* characters,
+                         const uint64_t start) const;
+
+    void skipWhitespaces();
+    bool skipValue(std::string &errorMessage);
+    bool skipString(std::string &errorMessage);
+    bool readString(std::string &result,
+                    std::string &errorMessage);
+    static bool readHex(const std::string &raw,
+                        const uint64_t start,
+                        uint32_t &code);
+
+    bool findInObject(const std::string &key,
+                      std::string &errorMessage);
+    bool findInArray(const uint64_t position,
+                     std::string &errorMessage);
+
+    DataItem* convertValue(std::string &errorMessage);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_JSON_PATH_SCANNER_H
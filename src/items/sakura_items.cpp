@@ -56,10 +56,12 @@ BlossomItem::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
 
     newItem->blossomName = blossomName;
     newItem->blossomGroupType = blossomGroupType;
     newItem->blossomType = blossomType;
+    newItem->isPure = isPure;
 
     return newItem;
 }
@@ -90,6 +92,7 @@ BlossomGroupItem::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
 
     newItem->id = id;
     newItem->blossomGroupType = blossomGroupType;
@@ -123,6 +126,7 @@ TreeItem::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
 
     newItem->unparsedConent = unparsedConent;
     newItem->relativePath = relativePath;
@@ -151,8 +155,10 @@ SubtreeItem::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
 
     newItem->nameOrPath = nameOrPath;
+    newItem->resolvedId = resolvedId;
 
     return newItem;
 }
@@ -183,6 +189,7 @@ IfBranching::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
 
     newItem->leftSide = leftSide;
     newItem->ifType = ifType;
@@ -220,9 +227,11 @@ ForEachBranching::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
 
     newItem->tempVarName = tempVarName;
     newItem->iterateArray = iterateArray;
+    newItem->reductions = reductions;
     newItem->parallel = parallel;
 
     if(content != nullptr) {
@@ -254,10 +263,12 @@ ForBranching::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
 
     newItem->tempVarName = tempVarName;
     newItem->start = start;
     newItem->end = end;
+    newItem->reductions = reductions;
     newItem->parallel = parallel;
 
     if(content != nullptr) {
@@ -293,6 +304,8 @@ SequentiellPart::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
+    newItem->dependencyLevels = dependencyLevels;
 
     for(uint32_t i = 0; i < childs.size(); i++)
     {
@@ -322,6 +335,8 @@ ParallelPart::copy()
 
     newItem->type = type;
     newItem->values = values;
+    newItem->span = span;
+    newItem->reductions = reductions;
     newItem->childs = childs->copy();
 
     return newItem;
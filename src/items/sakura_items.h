@@ -37,6 +37,19 @@ struct DataBuffer;
 namespace Sakura
 {
 
+//==================================================================================================
+// SourceSpan
+//==================================================================================================
+struct SourceSpan
+{
+    // position within the parsed file, beginning with 1. Line 0 means, that the position
+    // is unknown, for example for items, which were created by the optimizer.
+    uint32_t line = 0;
+    uint32_t column = 0;
+    uint32_t endLine = 0;
+    uint32_t endColumn = 0;
+};
+
 //==================================================================================================
 // SakuraItem
 //==================================================================================================
@@ -64,6 +77,7 @@ public:
 
     ItemType getType() const;
     ValueItemMap values;
+    SourceSpan span;
 
 protected:
     ItemType type = UNDEFINED_ITEM;
@@ -82,6 +96,9 @@ public:
     std::string blossomName = "";
     std::string blossomType = "";
     std::string blossomGroupType = "";
+
+    // copy of the purity of the called blossom, which is set by the validator
+    bool isPure = false;
 };
 
 //==================================================================================================
@@ -131,6 +148,8 @@ public:
     SakuraItem* copy();
 
     std::string nameOrPath = "";
+    // id of the called tree within the garden, which is resolved while parsing
+    std::string resolvedId = "";
     DataMap* parentValues = nullptr;
 
     // result
@@ -176,6 +195,7 @@ public:
 
     std::string tempVarName = "";
     ValueItemMap iterateArray;
+    ValueItemMap reductions;
     bool parallel = false;
 
     SakuraItem* content = nullptr;
@@ -194,6 +214,7 @@ public:
     std::string tempVarName = "";
     ValueItem start;
     ValueItem end;
+    ValueItemMap reductions;
     bool parallel = false;
 
     SakuraItem* content = nullptr;
@@ -210,6 +231,9 @@ public:
     SakuraItem* copy();
 
     std::vector<SakuraItem*> childs;
+
+    // groups of independent childs, which is created by the validator
+    std::vector<std::vector<uint64_t>> dependencyLevels;
 };
 
 //==================================================================================================
@@ -222,6 +246,7 @@ public:
     ~ParallelPart();
     SakuraItem* copy();
 
+    ValueItemMap reductions;
     SakuraItem* childs;
 };
 
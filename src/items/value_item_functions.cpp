@@ -22,13 +22,15 @@
 
 #include "value_item_functions.h"
 
-#include <libKitsunemimiCommon/common_methods/string_methods.h>
+#include <unordered_set>
+#include <cstring>
+
+#include <items/json_path_scanner.h>
+
 #include <libKitsunemimiCommon/common_items/data_items.h>
 
 #include <libKitsunemimiJson/json_item.h>
 
-using Kitsunemimi::splitStringByDelimiter;
-
 namespace Kitsunemimi
 {
 namespace Sakura
@@ -99,11 +101,128 @@ getValue(DataItem* item,
     return nullptr;
 }
 
+/**
+ * @brief convert the escape-sequences \\n, \\t, \\r and \\\\ within a delimiter into the
+ *        characters, which they represent
+ *
+ * @param delimiter delimiter-string, like it was written in the file
+ *
+ * @return delimiter with resolved escape-sequences
+ */
+const std::string
+resolveDelimiter(const std::string &delimiter)
+{
+    std::string result;
+    result.reserve(delimiter.size());
+
+    for(uint64_t i = 0; i < delimiter.size(); i++)
+    {
+        const char current = delimiter.at(i);
+        if(current != '\\'
+                || i + 1 == delimiter.size())
+        {
+            result.push_back(current);
+            continue;
+        }
+
+        i++;
+        switch(delimiter.at(i))
+        {
+            case 'n':
+                result.push_back('\n');
+                break;
+            case 't':
+                result.push_back('\t');
+                break;
+            case 'r':
+                result.push_back('\r');
+                break;
+            case '\\':
+                result.push_back('\\');
+                break;
+            default:
+                // unknown escape-sequences are taken as they are
+                result.push_back(current);
+                result.push_back(delimiter.at(i));
+                break;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief get the next part of a string, which is splitted by a delimiter. Like with std::getline
+ *        a delimiter at the end of the string doesn't produce an additional empty part.
+ *
+ * @param part reference for the resulting part
+ * @param content string, which should be splitted
+ * @param delimiter not empty delimiter, which can have multiple characters
+ * @param position position in the string, where the next part begins. It is moved behind the
+ *                 delimiter after the part.
+ *
+ * @return false, if the end of the string was reached, else true
+ */
+bool
+getNextSplitPart(std::string &part,
+                 const std::string &content,
+                 const std::string &delimiter,
+                 uint64_t &position)
+{
+    if(position >= content.size()) {
+        return false;
+    }
+
+    // std::string::find goes for single-character delimiters through memchr, which is
+    // vectorized by the c-library
+    const uint64_t found = content.find(delimiter, position);
+    if(found == std::string::npos)
+    {
+        part.assign(content, position, std::string::npos);
+        position = content.size();
+        return true;
+    }
+
+    part.assign(content, position, found - position);
+    position = found + delimiter.size();
+
+    return true;
+}
+
+/**
+ * @brief count the parts of a string, which is splitted by a delimiter, without creating them
+ *
+ * @param content string, which should be splitted
+ * @param delimiter not empty delimiter, which can have multiple characters
+ *
+ * @return number of parts
+ */
+uint64_t
+countSplitParts(const std::string &content,
+                const std::string &delimiter)
+{
+    uint64_t numberOfParts = 0;
+    uint64_t position = 0;
+
+    while(position < content.size())
+    {
+        const uint64_t found = content.find(delimiter, position);
+        numberOfParts++;
+        if(found == std::string::npos) {
+            break;
+        }
+        position = found + delimiter.size();
+    }
+
+    return numberOfParts;
+}
+
 /**
  * @brief splitValue split a value-item by a delimiter
  *
- * @param item value-item, which should be splited
- * @param delimiter delimiter as string-value to identify the positions, where to split
+ * @param item string-value, which should be splited
+ * @param delimiter delimiter as string-value to identify the positions, where to split. It can
+ *                  have multiple characters and the escape-sequences \\n, \\t and \\r.
  * @param errorMessage error-message for output
  *
  * @return array-item with the splitted content
@@ -121,27 +240,27 @@ splitValue(DataValue* item,
         return nullptr;
     }
 
-    // get and check delimiter-string
-    const std::string delimiterString = delimiter->toString();
-    if(delimiterString.size() == 0) {
+    if(item->isStringValue() == false)
+    {
+        errorMessage = "item, which should be splitted, is not a string";
         return nullptr;
     }
 
-    // get first character as delimiter and handle line-break as special rule
-    char demilimter = delimiterString.at(0);
-    if(delimiterString == "\\n") {
-        demilimter = '\n';
+    // get and check delimiter-string
+    const std::string delimiterString = resolveDelimiter(delimiter->toString());
+    if(delimiterString.size() == 0)
+    {
+        errorMessage = "delimiter for split-function is empty";
+        return nullptr;
     }
 
-    // split string into string-array
-    std::vector<std::string> splittedContent;
-    splitStringByDelimiter(splittedContent, item->toString(), demilimter);
-
-    // convert string-array into a DataArray-object
+    // split string directly into a DataArray-object
+    const std::string content = item->getString();
     DataArray* resultArray = new DataArray();
-    for(const std::string& object : splittedContent)
-    {
-        resultArray->append(new DataValue(object));
+    std::string part;
+    uint64_t position = 0;
+    while(getNextSplitPart(part, content, delimiterString, position)) {
+        resultArray->append(new DataValue(part));
     }
 
     return resultArray;
@@ -172,6 +291,41 @@ sizeValue(DataItem* item,
     return resultItem;
 }
 
+/**
+ * @brief check if an entry of an array is equal to a key. Entries with the same type as the key
+ *        are compared directly by their value, all others by their string-representation like
+ *        before.
+ *
+ * @param entry entry of the array
+ * @param key key to compare with
+ * @param keyString string-representation of the key
+ *
+ * @return true, if equal, else false
+ */
+bool
+isEqualToKey(DataItem* entry,
+             DataValue* key,
+             const std::string &keyString)
+{
+    if(entry->isIntValue()
+            && key->isIntValue())
+    {
+        return entry->toValue()->getLong() == key->getLong();
+    }
+
+    if(entry->isBoolValue()
+            && key->isBoolValue())
+    {
+        return entry->toValue()->getBool() == key->getBool();
+    }
+
+    if(entry->isStringValue()) {
+        return entry->toValue()->getString() == keyString;
+    }
+
+    return entry->toString() == keyString;
+}
+
 /**
  * @brief check if a map or array item contains a specific value
  *
@@ -204,11 +358,12 @@ containsValue(DataItem* item,
     // in case, that the item is an array
     if(item->isArray())
     {
-        // iterate over the array in interprete all as string for easier comparing
+        // convert the key only once and not again for each entry of the array
+        const std::string keyString = key->toString();
         DataArray* tempArray = item->toArray();
-        for(uint32_t i = 0; i < tempArray->size(); i++)
+        for(uint64_t i = 0; i < tempArray->size(); i++)
         {
-            if(tempArray->get(i)->toString() == key->toString()) {
+            if(isEqualToKey(tempArray->get(i), key, keyString)) {
                 return new DataValue(true);
             }
         }
@@ -345,6 +500,89 @@ clearEmpty(DataArray* item,
     return result;
 }
 
+/**
+ * @brief remove all duplicates from an array-item. Entries are compared by their
+ *        string-representation, like within the contains-function.
+ *
+ * @param item array-item, which should be cleared from duplicates
+ * @param errorMessage error-message for output
+ *
+ * @return new array-item with the first appearance of each entry in the original order
+ */
+DataArray*
+uniqueValue(DataArray* item,
+            std::string &errorMessage)
+{
+    // precheck
+    if(item == nullptr)
+    {
+        errorMessage = "item, which should be unified, is not an array-item";
+        return nullptr;
+    }
+
+    std::unordered_set<std::string> alreadySeen;
+    alreadySeen.reserve(item->size());
+
+    DataArray* result = new DataArray();
+    for(uint64_t i = 0; i < item->size(); i++)
+    {
+        DataItem* entry = item->get(i);
+        if(alreadySeen.insert(entry->toString()).second) {
+            result->append(entry->copy());
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief filter an array-item by the entries of another array-item. Entries are compared by
+ *        their string-representation, like within the contains-function. The entries of the
+ *        other array are hashed once, so the complete filtering is linear to the size of both
+ *        arrays.
+ *
+ * @param item array-item, which should be filtered
+ * @param other array-item with the entries to filter by
+ * @param keepMatches true to keep only entries, which are in the other array (intersect),
+ *                    false to keep only entries, which are not in the other array (difference)
+ * @param errorMessage error-message for output
+ *
+ * @return new array-item with the remaining entries in the original order
+ */
+DataArray*
+filterBySet(DataArray* item,
+            DataArray* other,
+            const bool keepMatches,
+            std::string &errorMessage)
+{
+    // precheck
+    if(item == nullptr
+            || other == nullptr)
+    {
+        errorMessage = "inputs for intersect- and difference-function must be array-items";
+        return nullptr;
+    }
+
+    // hash all entries of the other array
+    std::unordered_set<std::string> otherEntries;
+    otherEntries.reserve(other->size());
+    for(uint64_t i = 0; i < other->size(); i++) {
+        otherEntries.insert(other->get(i)->toString());
+    }
+
+    DataArray* result = new DataArray();
+    for(uint64_t i = 0; i < item->size(); i++)
+    {
+        DataItem* entry = item->get(i);
+        const bool found = otherEntries.find(entry->toString()) != otherEntries.end();
+        if(found == keepMatches) {
+            result->append(entry->copy());
+        }
+    }
+
+    return result;
+}
+
 /**
  * @brief parse a json-formated string into a data-item
  *
@@ -375,5 +613,261 @@ parseJson(DataValue* intput,
     return nullptr;
 }
 
+/**
+ * @brief get a single value out of a json-formated string, without parsing the complete string
+ *
+ * @param intput input-value with the json-formated content
+ * @param path keys and array-positions to the requested value, like they would be used by a
+ *             chain of get-function-calls on the parsed content
+ * @param errorMessage error-message for output
+ *
+ * @return nullptr, if failed, else a data-item with the requested value
+ */
+DataItem*
+parseJsonPath(DataValue* intput,
+              const std::vector<DataValue*> &path,
+              std::string &errorMessage)
+{
+    // precheck
+    if(intput == nullptr)
+    {
+        errorMessage = "inputs for parse_json-function are invalid";
+        return nullptr;
+    }
+
+    // scan string-values directly in their buffer, to avoid a copy of the whole json-string
+    if(intput->isStringValue())
+    {
+        const char* content = intput->content.stringValue;
+        JsonPathScanner scanner(content, std::strlen(content));
+        return scanner.getValue(path, errorMessage);
+    }
+
+    const std::string content = intput->toString();
+    JsonPathScanner scanner(content.c_str(), content.size());
+
+    return scanner.getValue(path, errorMessage);
+}
+
+/**
+ * @brief convert the name of a reduce-function into its reduce-type
+ *
+ * @param functionName name of the reduce-function
+ *
+ * @return reduce-type or NO_REDUCE, if the name is unknown
+ */
+ValueItem::ReduceType
+getReduceType(const std::string &functionName)
+{
+    if(functionName == "append") {
+        return ValueItem::APPEND_REDUCE;
+    }
+    if(functionName == "sum") {
+        return ValueItem::SUM_REDUCE;
+    }
+    if(functionName == "count") {
+        return ValueItem::COUNT_REDUCE;
+    }
+    if(functionName == "merge") {
+        return ValueItem::MERGE_REDUCE;
+    }
+
+    return ValueItem::NO_REDUCE;
+}
+
+/**
+ * @brief create the initial value of a reduction, which is also the result of a reduction over
+ *        an empty loop
+ *
+ * @param reduceType type of the reduction
+ *
+ * @return new data-item as start-value of the reduction
+ */
+DataItem*
+createReduceStartValue(const ValueItem::ReduceType reduceType)
+{
+    switch(reduceType)
+    {
+        case ValueItem::APPEND_REDUCE:
+            return new DataArray();
+        case ValueItem::MERGE_REDUCE:
+            return new DataMap();
+        case ValueItem::SUM_REDUCE:
+        case ValueItem::COUNT_REDUCE:
+            return new DataValue(0L);
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief merge the contribution of a single iteration into the result of a reduction
+ *
+ * @param result reference to the current result of the reduction, which is updated
+ * @param value contribution of the iteration. The ownership of the object moves into this
+ *              function, so it is either stored within the result or deleted.
+ * @param reduceType type of the reduction
+ * @param errorMessage error-message for output
+ *
+ * @return true, if successful, else false
+ */
+bool
+reduceValue(DataItem* &result,
+            DataItem* value,
+            const ValueItem::ReduceType reduceType,
+            std::string &errorMessage)
+{
+    // precheck
+    if(result == nullptr
+            || value == nullptr)
+    {
+        errorMessage = "inputs for reduce-function are invalid";
+        delete value;
+        return false;
+    }
+
+    // add value to the resulting array without copy
+    if(reduceType == ValueItem::APPEND_REDUCE)
+    {
+        result->toArray()->append(value);
+        return true;
+    }
+
+    // move all key-value-pairs of the value into the resulting map
+    if(reduceType == ValueItem::MERGE_REDUCE)
+    {
+        if(value->isMap() == false)
+        {
+            errorMessage = "merge-reduction requires map-items, but got: " + value->toString();
+            delete value;
+            return false;
+        }
+
+        DataMap* valueMap = value->toMap();
+        std::map<std::string, DataItem*>::iterator it;
+        for(it = valueMap->m_map.begin();
+            it != valueMap->m_map.end();
+            it++)
+        {
+            result->toMap()->insert(it->first, it->second, true);
+        }
+
+        // entries are now owned by the result, so only the empty map-object has to be deleted
+        valueMap->m_map.clear();
+        delete value;
+        return true;
+    }
+
+    // count all values, which are true or not empty
+    if(reduceType == ValueItem::COUNT_REDUCE)
+    {
+        bool count = false;
+        if(value->isBoolValue()) {
+            count = value->toValue()->getBool();
+        } else {
+            count = value->toString() != "";
+        }
+        delete value;
+
+        if(count)
+        {
+            const long counter = result->toValue()->getLong() + 1;
+            delete result;
+            result = new DataValue(counter);
+        }
+
+        return true;
+    }
+
+    // sum up numeric values. The sum keeps an int-value until the first float-value appears
+    if(reduceType == ValueItem::SUM_REDUCE)
+    {
+        if(value->isIntValue() == false
+                && value->isFloatValue() == false)
+        {
+            errorMessage = "sum-reduction requires numeric values, but got: " + value->toString();
+            delete value;
+            return false;
+        }
+
+        DataValue* newResult = nullptr;
+        if(result->isIntValue()
+                && value->isIntValue())
+        {
+            newResult = new DataValue(result->toValue()->getLong()
+                                      + value->toValue()->getLong());
+        }
+        else
+        {
+            const double left = result->isIntValue() ? result->toValue()->getLong()
+                                                     : result->toValue()->getDouble();
+            const double right = value->isIntValue() ? value->toValue()->getLong()
+                                                     : value->toValue()->getDouble();
+            newResult = new DataValue(left + right);
+        }
+
+        delete value;
+        delete result;
+        result = newResult;
+        return true;
+    }
+
+    errorMessage = "unknown reduce-type";
+    delete value;
+    return false;
+}
+
+/**
+ * @brief combine the results of a reduction over two neighbouring ranges of iterations into
+ *        the result of the first range
+ *
+ * @param result reference to the result of the first range, which is updated
+ * @param other result of the following range. The ownership of the object moves into this
+ *              function, so it is either stored within the result or deleted.
+ * @param reduceType type of the reduction
+ * @param errorMessage error-message for output
+ *
+ * @return true, if successful, else false
+ */
+bool
+combineReduceResults(DataItem* &result,
+                     DataItem* other,
+                     const ValueItem::ReduceType reduceType,
+                     std::string &errorMessage)
+{
+    // precheck
+    if(result == nullptr
+            || other == nullptr)
+    {
+        errorMessage = "inputs for reduce-function are invalid";
+        delete other;
+        return false;
+    }
+
+    // move all items of the following range behind the items of the first range
+    if(reduceType == ValueItem::APPEND_REDUCE)
+    {
+        DataArray* otherArray = other->toArray();
+        for(DataItem* item : otherArray->m_array) {
+            result->toArray()->append(item);
+        }
+
+        // items are now owned by the result, so only the empty array-object has to be deleted
+        otherArray->m_array.clear();
+        delete other;
+        return true;
+    }
+
+    // the results of counts are the number of counted values, which have to be summed up
+    if(reduceType == ValueItem::COUNT_REDUCE) {
+        return reduceValue(result, other, ValueItem::SUM_REDUCE, errorMessage);
+    }
+
+    // merge and sum of two results are the same like merging a single contribution
+    return reduceValue(result, other, reduceType, errorMessage);
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
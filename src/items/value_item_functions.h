@@ -24,6 +24,9 @@
 #define KITSUNEMIMI_SAKURA_LANG_VALUE_ITEM_FUNCTIONS_H
 
 #include <string>
+#include <vector>
+
+#include <items/value_items.h>
 
 namespace Kitsunemimi
 {
@@ -38,6 +41,13 @@ namespace Sakura
 DataItem* getValue(DataItem* item,
                    DataValue* key,
                    std::string &errorMessage);
+const std::string resolveDelimiter(const std::string &delimiter);
+bool getNextSplitPart(std::string &part,
+                      const std::string &content,
+                      const std::string &delimiter,
+                      uint64_t &position);
+uint64_t countSplitParts(const std::string &content,
+                         const std::string &delimiter);
 DataArray* splitValue(DataValue* item,
                       DataValue* delimiter,
                       std::string &errorMessage);
@@ -55,8 +65,29 @@ DataMap* insertValue(DataMap* item,
                      std::string &errorMessage);
 DataArray* clearEmpty(DataArray* item,
                       std::string &errorMessage);
+DataArray* uniqueValue(DataArray* item,
+                       std::string &errorMessage);
+DataArray* filterBySet(DataArray* item,
+                       DataArray* other,
+                       const bool keepMatches,
+                       std::string &errorMessage);
 DataItem* parseJson(DataValue* intput,
                     std::string &errorMessage);
+DataItem* parseJsonPath(DataValue* intput,
+                        const std::vector<DataValue*> &path,
+                        std::string &errorMessage);
+
+// reduce-functions
+ValueItem::ReduceType getReduceType(const std::string &functionName);
+DataItem* createReduceStartValue(const ValueItem::ReduceType reduceType);
+bool reduceValue(DataItem* &result,
+                 DataItem* value,
+                 const ValueItem::ReduceType reduceType,
+                 std::string &errorMessage);
+bool combineReduceResults(DataItem* &result,
+                          DataItem* other,
+                          const ValueItem::ReduceType reduceType,
+                          std::string &errorMessage);
 
 } // namespace Sakura
 } // namespace Kitsunemimi
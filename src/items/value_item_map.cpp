@@ -259,7 +259,9 @@ ValueItemMap::getValueAsString(const std::string &key)
 {
     std::map<std::string, ValueItem>::const_iterator it;
     it = m_valueMap.find(key);
-    if(it != m_valueMap.end()) {
+    if(it != m_valueMap.end()
+            && it->second.item != nullptr)
+    {
         return it->second.item->toString();
     }
 
@@ -367,7 +369,12 @@ ValueItemMap::toString()
         it != m_valueMap.end();
         it++)
     {
-        table.addRow(std::vector<std::string>{it->first, it->second.item->toString()});
+        // inputs of blossoms are empty, after they were moved into the blossom-leaf
+        std::string value = "";
+        if(it->second.item != nullptr) {
+            value = it->second.item->toString();
+        }
+        table.addRow(std::vector<std::string>{it->first, value});
     }
 
     return table.toString();
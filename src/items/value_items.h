@@ -56,10 +56,21 @@ struct ValueItem
         OUTPUT_PAIR_TYPE = 2,
         COMPARE_EQUAL_PAIR_TYPE = 3,
         COMPARE_UNEQUAL_PAIR_TYPE = 4,
+        REDUCE_PAIR_TYPE = 5,
+    };
+
+    enum ReduceType
+    {
+        NO_REDUCE = 0,
+        APPEND_REDUCE = 1,
+        SUM_REDUCE = 2,
+        COUNT_REDUCE = 3,
+        MERGE_REDUCE = 4,
     };
 
     DataItem* item = nullptr;
     ValueType type = INPUT_PAIR_TYPE;
+    ReduceType reduceType = NO_REDUCE;
     bool isIdentifier = false;
     std::vector<FunctionItem> functions;
 
@@ -78,6 +89,7 @@ struct ValueItem
         }
 
         type = other.type;
+        reduceType = other.reduceType;
         isIdentifier = other.isIdentifier;
         functions = other.functions;
     }
@@ -104,6 +116,7 @@ struct ValueItem
             }
 
             this->type = other.type;
+            this->reduceType = other.reduceType;
             this->isIdentifier = other.isIdentifier;
             this->functions = other.functions;
         }
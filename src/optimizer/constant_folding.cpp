@@ -0,0 +1,414 @@
+/**
+ * @file        constant_folding.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "constant_folding.h"
+
+#include <sakura_garden.h>
+#include <items/item_methods.h>
+#include <optimizer/dependency_analysis.h>
+
+#include <libKitsunemimiPersistence/logger/logger.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+// maximum number of iterations of a for-loop, which is unrolled
+#define MAX_UNROLL_ITERATIONS 4
+
+/**
+ * @brief check if a value-item has the same value in each run, independent from the values of
+ *        the parent
+ *
+ * @param valueItem value-item to check
+ *
+ * @return true, if constant, else false
+ */
+bool
+isConstantValue(const ValueItem &valueItem)
+{
+    if(valueItem.item == nullptr
+            || valueItem.isIdentifier
+            || valueItem.type == ValueItem::OUTPUT_PAIR_TYPE
+            || valueItem.type == ValueItem::REDUCE_PAIR_TYPE)
+    {
+        return false;
+    }
+
+    if(valueItem.item->isStringValue()
+            && isJinja2Template(valueItem.item->toValue()->getString()))
+    {
+        return false;
+    }
+
+    for(const FunctionItem &function : valueItem.functions)
+    {
+        for(const ValueItem &argument : function.arguments)
+        {
+            if(isConstantValue(argument) == false) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief process the function-calls of a constant value-item once, so they don't have to be
+ *        processed in each run. If the processing fails, the value-item is not changed, so the
+ *        error is still reported at runtime.
+ *
+ * @param valueItem value-item to fold
+ * @param stats reference for the statistics
+ */
+void
+foldValueItem(ValueItem &valueItem,
+              FoldingStats &stats)
+{
+    for(FunctionItem &function : valueItem.functions)
+    {
+        for(ValueItem &argument : function.arguments) {
+            foldValueItem(argument, stats);
+        }
+    }
+
+    if(valueItem.functions.size() == 0
+            || isConstantValue(valueItem) == false)
+    {
+        return;
+    }
+
+    ValueItem folded = valueItem;
+    DataMap emptyMap;
+    std::string errorMessage = "";
+    if(fillValueItem(folded, emptyMap, errorMessage) == false
+            || folded.item == nullptr)
+    {
+        return;
+    }
+
+    // a result, which looks like a jinja2-string, would be converted at runtime
+    if(folded.item->isStringValue()
+            && isJinja2Template(folded.item->toValue()->getString()))
+    {
+        return;
+    }
+
+    LOG_DEBUG("fold value to: " + folded.item->toString());
+
+    folded.functions.clear();
+    valueItem = folded;
+    stats.foldedValues++;
+}
+
+/**
+ * @brief fold all value-items of a value-item-map
+ *
+ * @param valueItemMap value-item-map to fold
+ * @param stats reference for the statistics
+ */
+void
+foldValueItemMap(ValueItemMap &valueItemMap,
+                 FoldingStats &stats)
+{
+    std::map<std::string, ValueItem>::iterator it;
+    for(it = valueItemMap.m_valueMap.begin();
+        it != valueItemMap.m_valueMap.end();
+        it++)
+    {
+        foldValueItem(it->second, stats);
+    }
+
+    std::map<std::string, ValueItemMap*>::iterator itChild;
+    for(itChild = valueItemMap.m_childMaps.begin();
+        itChild != valueItemMap.m_childMaps.end();
+        itChild++)
+    {
+        foldValueItemMap(*itChild->second, stats);
+    }
+}
+
+/**
+ * @brief replace an if-condition with the content of the branch, which is always used, if both
+ *        sides of the condition are constant
+ *
+ * @param item reference to the if-condition, which is replaced
+ * @param stats reference for the statistics
+ */
+void
+pruneIfBranching(SakuraItem* &item,
+                 FoldingStats &stats)
+{
+    IfBranching* ifBranching = dynamic_cast<IfBranching*>(item);
+    if(isConstantValue(ifBranching->leftSide) == false
+            || isConstantValue(ifBranching->rightSide) == false
+            || ifBranching->leftSide.functions.size() > 0
+            || ifBranching->rightSide.functions.size() > 0)
+    {
+        return;
+    }
+
+    bool ifMatch = false;
+    std::string errorMessage = "";
+    if(compareItems(ifMatch,
+                    ifBranching->leftSide.item,
+                    ifBranching->rightSide.item,
+                    ifBranching->ifType,
+                    errorMessage) == false)
+    {
+        return;
+    }
+
+    LOG_DEBUG("prune if-condition, which is always " + std::string(ifMatch ? "true" : "false"));
+
+    // take the used branch out of the if-condition before deleting it
+    SakuraItem* usedBranch = nullptr;
+    if(ifMatch)
+    {
+        usedBranch = ifBranching->ifContent;
+        ifBranching->ifContent = nullptr;
+    }
+    else
+    {
+        usedBranch = ifBranching->elseContent;
+        ifBranching->elseContent = nullptr;
+    }
+
+    if(usedBranch == nullptr) {
+        usedBranch = new SequentiellPart();
+    }
+
+    delete item;
+    item = usedBranch;
+    stats.prunedBranches++;
+}
+
+/**
+ * @brief remove for-loops without any iteration and unroll for-loops with only a few iterations,
+ *        if both borders are constant
+ *
+ * @param item reference to the for-loop, which is replaced
+ * @param scope values of the tree, which contains the loop
+ * @param garden garden to identify calls of resources
+ * @param stats reference for the statistics
+ */
+void
+transformForLoop(SakuraItem* &item,
+                 const ValueItemMap &scope,
+                 SakuraGarden* garden,
+                 FoldingStats &stats)
+{
+    ForBranching* forBranching = dynamic_cast<ForBranching*>(item);
+
+    // values and reductions in the header of the loop change the parent-values even without
+    // any iteration
+    if(forBranching->values.m_valueMap.size() > 0
+            || forBranching->values.m_childMaps.size() > 0
+            || forBranching->reductions.m_valueMap.size() > 0)
+    {
+        return;
+    }
+
+    if(isConstantValue(forBranching->start) == false
+            || isConstantValue(forBranching->end) == false
+            || forBranching->start.functions.size() > 0
+            || forBranching->end.functions.size() > 0
+            || forBranching->start.item->isIntValue() == false
+            || forBranching->end.item->isIntValue() == false)
+    {
+        return;
+    }
+
+    const long start = forBranching->start.item->toValue()->getLong();
+    const long end = forBranching->end.item->toValue()->getLong();
+    if(start < 0
+            || end < 0)
+    {
+        return;
+    }
+
+    // remove loop without iterations
+    if(end <= start)
+    {
+        LOG_DEBUG("remove for-loop without iterations");
+
+        delete item;
+        item = new SequentiellPart();
+        stats.removedLoops++;
+        return;
+    }
+
+    const uint64_t numberOfIterations = static_cast<uint64_t>(end - start);
+    if(forBranching->parallel
+            || numberOfIterations > MAX_UNROLL_ITERATIONS)
+    {
+        return;
+    }
+
+    // the counter-variable must not override a value of the tree, because it would be written
+    // back to the parent after the loop
+    if(scope.m_valueMap.find(forBranching->tempVarName) != scope.m_valueMap.end()) {
+        return;
+    }
+
+    LOG_DEBUG("unroll for-loop with " + std::to_string(numberOfIterations) + " iterations");
+
+    // each iteration gets its own value of the counter-variable, because blossoms can read all
+    // parent-values and not only the values of their input
+    SequentiellPart* unrolled = new SequentiellPart();
+    for(uint64_t i = 0; i < numberOfIterations; i++)
+    {
+        SequentiellPart* iteration = new SequentiellPart();
+        iteration->values.insert(forBranching->tempVarName,
+                                 new DataValue(start + static_cast<long>(i)));
+        iteration->childs.push_back(forBranching->content->copy());
+        unrolled->childs.push_back(iteration);
+    }
+    createDependencyLevels(unrolled->dependencyLevels, unrolled->childs, garden);
+
+    delete item;
+    item = unrolled;
+    stats.unrolledLoops++;
+}
+
+/**
+ * @brief fold all constant values of an item and its childs and remove or replace parts of the
+ *        tree, which are decidable at validation-time
+ *
+ * @param item reference to the item, which can be replaced
+ * @param scope values of the tree, which contains the item
+ * @param garden garden to identify calls of resources
+ * @param stats reference for the statistics
+ */
+void
+foldSakuraItem(SakuraItem* &item,
+               const ValueItemMap &scope,
+               SakuraGarden* garden,
+               FoldingStats &stats)
+{
+    if(item == nullptr) {
+        return;
+    }
+
+    // only values, which are filled at runtime, are folded. The values of trees and in the header
+    // of loops are written unprocessed into the parent-values.
+
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::TREE_ITEM)
+    {
+        TreeItem* treeItem = dynamic_cast<TreeItem*>(item);
+        foldSakuraItem(treeItem->childs, treeItem->values, garden, stats);
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::BLOSSOM_GROUP_ITEM)
+    {
+        BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(item);
+        foldValueItemMap(blossomGroupItem->values, stats);
+        for(BlossomItem* blossomItem : blossomGroupItem->blossoms) {
+            foldValueItemMap(blossomItem->values, stats);
+        }
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::SUBTREE_ITEM)
+    {
+        foldValueItemMap(item->values, stats);
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::SEQUENTIELL_ITEM)
+    {
+        SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(item);
+        for(SakuraItem* &child : sequential->childs) {
+            foldSakuraItem(child, scope, garden, stats);
+        }
+
+        // replaced childs can have other dependencies
+        createDependencyLevels(sequential->dependencyLevels, sequential->childs, garden);
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::PARALLEL_ITEM)
+    {
+        ParallelPart* parallel = dynamic_cast<ParallelPart*>(item);
+        foldSakuraItem(parallel->childs, scope, garden, stats);
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::IF_ITEM)
+    {
+        IfBranching* ifBranching = dynamic_cast<IfBranching*>(item);
+        foldValueItem(ifBranching->leftSide, stats);
+        foldValueItem(ifBranching->rightSide, stats);
+        foldSakuraItem(ifBranching->ifContent, scope, garden, stats);
+        foldSakuraItem(ifBranching->elseContent, scope, garden, stats);
+        pruneIfBranching(item, stats);
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::FOR_EACH_ITEM)
+    {
+        ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(item);
+        foldValueItemMap(forEachBranching->iterateArray, stats);
+        foldSakuraItem(forEachBranching->content, scope, garden, stats);
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+    if(item->getType() == SakuraItem::FOR_ITEM)
+    {
+        ForBranching* forBranching = dynamic_cast<ForBranching*>(item);
+        foldValueItem(forBranching->start, stats);
+        foldValueItem(forBranching->end, stats);
+        foldSakuraItem(forBranching->content, scope, garden, stats);
+        transformForLoop(item, scope, garden, stats);
+        return;
+    }
+    //----------------------------------------------------------------------------------------------
+}
+
+/**
+ * @brief run the constant-folding over a validated tree and report the applied optimizations
+ *
+ * @param tree tree to optimize
+ * @param garden garden to identify calls of resources
+ * @param stats reference for the applied optimizations
+ */
+void
+optimizeTree(TreeItem* tree,
+             SakuraGarden* garden,
+             FoldingStats &stats)
+{
+    SakuraItem* item = tree;
+    foldSakuraItem(item, tree->values, garden, stats);
+
+    LOG_DEBUG("constant-folding of tree \"" + tree->id + "\":"
+              + " folded values: " + std::to_string(stats.foldedValues)
+              + ", pruned branches: " + std::to_string(stats.prunedBranches)
+              + ", unrolled loops: " + std::to_string(stats.unrolledLoops)
+              + ", removed loops: " + std::to_string(stats.removedLoops));
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
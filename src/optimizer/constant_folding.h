@@ -0,0 +1,64 @@
+/**
+ * @file        constant_folding.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_CONSTANT_FOLDING_H
+#define KITSUNEMIMI_SAKURA_LANG_CONSTANT_FOLDING_H
+
+#include <string>
+#include <stdint.h>
+
+#include <items/sakura_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+class SakuraGarden;
+
+/**
+ * @brief The FoldingStats struct counts the optimizations, which were applied to a tree
+ */
+struct FoldingStats
+{
+    uint32_t foldedValues = 0;
+    uint32_t prunedBranches = 0;
+    uint32_t unrolledLoops = 0;
+    uint32_t removedLoops = 0;
+};
+
+bool isConstantValue(const ValueItem &valueItem);
+void foldValueItem(ValueItem &valueItem,
+                   FoldingStats &stats);
+void foldValueItemMap(ValueItemMap &valueItemMap,
+                      FoldingStats &stats);
+void foldSakuraItem(SakuraItem* &item,
+                    const ValueItemMap &scope,
+                    SakuraGarden* garden,
+                    FoldingStats &stats);
+void optimizeTree(TreeItem* tree,
+                  SakuraGarden* garden,
+                  FoldingStats &stats);
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_CONSTANT_FOLDING_H
@@ -0,0 +1,401 @@
+/**
+ * @file        dependency_analysis.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "dependency_analysis.h"
+
+#include <cctype>
+
+#include <sakura_garden.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief collect all names, which are used within the jinja2-expressions of a string. Keywords
+ *        and names of attributes are collected too, which only make the result more conservative.
+ *
+ * @param identifiers reference for the resulting names
+ * @param input string, which is interpreted as jinja2-template
+ */
+void
+collectJinja2Identifiers(std::set<std::string> &identifiers,
+                         const std::string &input)
+{
+    uint64_t pos = 0;
+    while(pos < input.size())
+    {
+        // search for the next expression or statement
+        const uint64_t start = input.find('{', pos);
+        if(start == std::string::npos
+                || start + 1 >= input.size())
+        {
+            return;
+        }
+
+        const char marker = input.at(start + 1);
+        if(marker != '{'
+                && marker != '%')
+        {
+            pos = start + 1;
+            continue;
+        }
+
+        const std::string endMarker = marker == '{' ? "}}" : "%}";
+        uint64_t end = input.find(endMarker, start + 2);
+        if(end == std::string::npos) {
+            end = input.size();
+        }
+
+        // collect all words within the expression, which are not within a string
+        bool inString = false;
+        char quote = '\0';
+        uint64_t wordStart = std::string::npos;
+        for(uint64_t i = start + 2; i <= end; i++)
+        {
+            const char c = i < end ? input.at(i) : ' ';
+            if(inString)
+            {
+                if(c == quote) {
+                    inString = false;
+                }
+                continue;
+            }
+
+            const bool isWordChar = isalnum(static_cast<unsigned char>(c)) || c == '_';
+            if(isWordChar
+                    && wordStart == std::string::npos)
+            {
+                wordStart = i;
+            }
+            else if(isWordChar == false
+                    && wordStart != std::string::npos)
+            {
+                if(isdigit(static_cast<unsigned char>(input.at(wordStart))) == false) {
+                    identifiers.insert(input.substr(wordStart, i - wordStart));
+                }
+                wordStart = std::string::npos;
+            }
+
+            if(c == '"'
+                    || c == '\'')
+            {
+                inString = true;
+                quote = c;
+            }
+        }
+
+        pos = end + 2;
+    }
+}
+
+/**
+ * @brief collect the names of all values, which are read to fill a value-item
+ *
+ * @param reads reference for the resulting names
+ * @param valueItem value-item to check
+ */
+void
+collectReads(std::set<std::string> &reads,
+             const ValueItem &valueItem)
+{
+    // outputs only contain the name of the output of the blossom
+    if(valueItem.type != ValueItem::OUTPUT_PAIR_TYPE
+            && valueItem.item != nullptr)
+    {
+        if(valueItem.isIdentifier) {
+            reads.insert(valueItem.item->toString());
+        } else {
+            collectJinja2Identifiers(reads, valueItem.item->toString());
+        }
+    }
+
+    for(const FunctionItem &function : valueItem.functions)
+    {
+        for(const ValueItem &argument : function.arguments) {
+            collectReads(reads, argument);
+        }
+    }
+}
+
+/**
+ * @brief collect the names of all values, which are read to fill a value-item-map
+ *
+ * @param reads reference for the resulting names
+ * @param valueItemMap value-item-map to check
+ */
+void
+collectReads(std::set<std::string> &reads,
+             const ValueItemMap &valueItemMap)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = valueItemMap.m_valueMap.begin();
+        it != valueItemMap.m_valueMap.end();
+        it++)
+    {
+        collectReads(reads, it->second);
+    }
+
+    std::map<std::string, ValueItemMap*>::const_iterator itChild;
+    for(itChild = valueItemMap.m_childMaps.begin();
+        itChild != valueItemMap.m_childMaps.end();
+        itChild++)
+    {
+        collectReads(reads, *itChild->second);
+    }
+}
+
+/**
+ * @brief collect the values, which are read and written by an item of a sequential block. At
+ *        the moment only blossom-groups are analysed. All other items and calls of resources
+ *        are handled as barrier. Groups with a blossom, which is not pure, are marked as impure.
+ *
+ * @param accessSet reference for the result
+ * @param item item to analyse
+ * @param garden garden to identify calls of resources
+ */
+void
+collectAccess(AccessSet &accessSet,
+              SakuraItem* item,
+              SakuraGarden* garden)
+{
+    if(item->getType() != SakuraItem::BLOSSOM_GROUP_ITEM)
+    {
+        accessSet.barrier = true;
+        return;
+    }
+
+    BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(item);
+
+    // the name of the group is a jinja2-string
+    collectJinja2Identifiers(accessSet.reads, blossomGroupItem->id);
+
+    std::vector<const ValueItemMap*> valueMaps;
+    valueMaps.push_back(&blossomGroupItem->values);
+    for(BlossomItem* blossomItem : blossomGroupItem->blossoms)
+    {
+        if(garden != nullptr
+                && garden->containsRessource(blossomItem->blossomType))
+        {
+            accessSet.barrier = true;
+            return;
+        }
+
+        if(blossomItem->isPure == false) {
+            accessSet.impure = true;
+        }
+
+        valueMaps.push_back(&blossomItem->values);
+    }
+
+    // only the outputs of a blossom are written back to the parent
+    for(const ValueItemMap* valueMap : valueMaps)
+    {
+        collectReads(accessSet.reads, *valueMap);
+
+        std::map<std::string, ValueItem>::const_iterator it;
+        for(it = valueMap->m_valueMap.begin();
+            it != valueMap->m_valueMap.end();
+            it++)
+        {
+            if(it->second.type == ValueItem::OUTPUT_PAIR_TYPE) {
+                accessSet.writes.insert(it->first);
+            }
+        }
+    }
+}
+
+/**
+ * @brief collect the names of all values, which are read by an item and all of its childs
+ *
+ * @param reads reference for the resulting names
+ * @param item item to analyse
+ * @param garden garden to identify calls of resources
+ *
+ * @return false, if the item contains trees, subtrees or resources, which can read every value
+ *         of the parent, else true
+ */
+bool
+collectAllReads(std::set<std::string> &reads,
+                SakuraItem* item,
+                SakuraGarden* garden)
+{
+    if(item == nullptr) {
+        return true;
+    }
+
+    collectReads(reads, item->values);
+
+    switch(item->getType())
+    {
+        case SakuraItem::BLOSSOM_GROUP_ITEM:
+        {
+            AccessSet accessSet;
+            collectAccess(accessSet, item, garden);
+            reads.insert(accessSet.reads.begin(), accessSet.reads.end());
+            return accessSet.barrier == false
+                    && accessSet.impure == false;
+        }
+        case SakuraItem::BLOSSOM_ITEM:
+        {
+            return true;
+        }
+        case SakuraItem::SEQUENTIELL_ITEM:
+        {
+            SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(item);
+            for(SakuraItem* child : sequential->childs)
+            {
+                if(collectAllReads(reads, child, garden) == false) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case SakuraItem::PARALLEL_ITEM:
+        {
+            ParallelPart* parallel = dynamic_cast<ParallelPart*>(item);
+            collectReads(reads, parallel->reductions);
+            return collectAllReads(reads, parallel->childs, garden);
+        }
+        case SakuraItem::IF_ITEM:
+        {
+            IfBranching* ifBranching = dynamic_cast<IfBranching*>(item);
+            collectReads(reads, ifBranching->leftSide);
+            collectReads(reads, ifBranching->rightSide);
+            return collectAllReads(reads, ifBranching->ifContent, garden)
+                    && collectAllReads(reads, ifBranching->elseContent, garden);
+        }
+        case SakuraItem::FOR_EACH_ITEM:
+        {
+            ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(item);
+            collectReads(reads, forEachBranching->iterateArray);
+            collectReads(reads, forEachBranching->reductions);
+            return collectAllReads(reads, forEachBranching->content, garden);
+        }
+        case SakuraItem::FOR_ITEM:
+        {
+            ForBranching* forBranching = dynamic_cast<ForBranching*>(item);
+            collectReads(reads, forBranching->start);
+            collectReads(reads, forBranching->end);
+            collectReads(reads, forBranching->reductions);
+            return collectAllReads(reads, forBranching->content, garden);
+        }
+        default:
+            break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief check if one set of names contains at least one name of another set
+ *
+ * @param first first set
+ * @param second second set
+ *
+ * @return true, if there is at least one common name, else false
+ */
+bool
+intersects(const std::set<std::string> &first,
+           const std::set<std::string> &second)
+{
+    for(const std::string &name : first)
+    {
+        if(second.find(name) != second.end()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief check if an item has to be processed after another item of the same sequential block
+ *
+ * @param later access-set of the later item
+ * @param earlier access-set of the earlier item
+ *
+ * @return true, if the later item depends on the earlier item, else false
+ */
+bool
+dependsOn(const AccessSet &later,
+          const AccessSet &earlier)
+{
+    if(later.barrier
+            || earlier.barrier
+            || later.impure
+            || earlier.impure)
+    {
+        return true;
+    }
+
+    // read after write, write after write and write after read
+    return intersects(later.reads, earlier.writes)
+            || intersects(later.writes, earlier.writes)
+            || intersects(later.writes, earlier.reads);
+}
+
+/**
+ * @brief group the items of a sequential block into levels, where all items of a level are
+ *        independent from each other and only depend on items of previous levels. Processing the
+ *        levels one after another keeps the order of all dependent items.
+ *
+ * @param levels reference for the resulting levels with the positions of the items
+ * @param childs items of the sequential block
+ * @param garden garden to identify calls of resources
+ */
+void
+createDependencyLevels(std::vector<std::vector<uint64_t>> &levels,
+                       const std::vector<SakuraItem*> &childs,
+                       SakuraGarden* garden)
+{
+    levels.clear();
+
+    std::vector<AccessSet> accessSets(childs.size());
+    std::vector<uint64_t> levelOfItem(childs.size(), 0);
+
+    for(uint64_t i = 0; i < childs.size(); i++)
+    {
+        collectAccess(accessSets[i], childs.at(i), garden);
+
+        // the level of an item is one higher than the highest level of its dependencies
+        uint64_t level = 0;
+        for(uint64_t j = 0; j < i; j++)
+        {
+            if(dependsOn(accessSets.at(i), accessSets.at(j))
+                    && levelOfItem.at(j) + 1 > level)
+            {
+                level = levelOfItem.at(j) + 1;
+            }
+        }
+        levelOfItem[i] = level;
+
+        if(level >= levels.size()) {
+            levels.resize(level + 1);
+        }
+        levels[level].push_back(i);
+    }
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
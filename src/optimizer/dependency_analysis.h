@@ -0,0 +1,76 @@
+/**
+ * @file        dependency_analysis.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_DEPENDENCY_ANALYSIS_H
+#define KITSUNEMIMI_SAKURA_LANG_DEPENDENCY_ANALYSIS_H
+
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <items/sakura_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+class SakuraGarden;
+
+/**
+ * @brief The AccessSet struct contains the names of all values, which are read or written by an
+ *        item of a sequential block. If the accessed values can not be determined, the item is a
+ *        barrier, which depends on all items before and where all items afterwards depend on.
+ *        Items, which call blossoms with possible side-effects, are impure. They are ordered
+ *        like barriers, because these blossoms can read all parent-values.
+ */
+struct AccessSet
+{
+    std::set<std::string> reads;
+    std::set<std::string> writes;
+    bool barrier = false;
+    bool impure = false;
+};
+
+void collectJinja2Identifiers(std::set<std::string> &identifiers,
+                              const std::string &input);
+void collectReads(std::set<std::string> &reads,
+                  const ValueItem &valueItem);
+void collectReads(std::set<std::string> &reads,
+                  const ValueItemMap &valueItemMap);
+void collectAccess(AccessSet &accessSet,
+                   SakuraItem* item,
+                   SakuraGarden* garden);
+bool collectAllReads(std::set<std::string> &reads,
+                     SakuraItem* item,
+                     SakuraGarden* garden);
+
+bool dependsOn(const AccessSet &later,
+               const AccessSet &earlier);
+void createDependencyLevels(std::vector<std::vector<uint64_t>> &levels,
+                            const std::vector<SakuraItem*> &childs,
+                            SakuraGarden* garden);
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_DEPENDENCY_ANALYSIS_H
@@ -0,0 +1,417 @@
+/**
+ * @file        parse_cache.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "parse_cache.h"
+
+#include <items/sakura_items.h>
+
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor
+ *
+ * @param maxSize maximum number of bytes of all cached tree-contents and trees. 0 disables the
+ *                cache.
+ */
+ParseCache::ParseCache(const uint64_t maxSize)
+{
+    m_maxSize = maxSize;
+}
+
+/**
+ * @brief destructor
+ */
+ParseCache::~ParseCache() {}
+
+/**
+ * @brief request a cached tree
+ *
+ * @param content content of the tree
+ *
+ * @return copy of the cached tree, if found, else nullptr
+ */
+TreeItem*
+ParseCache::get(const std::string &content)
+{
+    const uint64_t hash = std::hash<std::string>()(content);
+    std::shared_ptr<TreeItem> tree;
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        std::unordered_map<uint64_t, std::list<CacheEntry>::iterator>::const_iterator it;
+        it = m_index.find(hash);
+
+        // compare the content too, because different contents can have the same hash
+        if(it == m_index.end()
+                || it->second->tree->unparsedConent != content)
+        {
+            m_misses++;
+            return nullptr;
+        }
+
+        // mark as most recently used
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        m_hits++;
+
+        tree = it->second->tree;
+    }
+
+    // the copy of big trees takes time, so it is done outside of the lock. The tree stays valid
+    // even if it is removed from the cache in the meantime.
+    return dynamic_cast<TreeItem*>(tree->copy());
+}
+
+/**
+ * @brief add a copy of a parsed and validated tree to the cache
+ *
+ * @param content content of the tree
+ * @param tree tree, which was parsed from the content
+ * @param generation generation of the cache, before the tree was validated
+ */
+void
+ParseCache::add(const std::string &content,
+                TreeItem* tree,
+                const uint64_t generation)
+{
+    const uint64_t hash = std::hash<std::string>()(content);
+
+    // create the copy outside of the lock
+    std::shared_ptr<TreeItem> copy(dynamic_cast<TreeItem*>(tree->copy()));
+    copy->unparsedConent = content;
+    const uint64_t size = content.size() + estimateItemSize(copy.get());
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // the cache was invalidated while the tree was validated, so the tree can be outdated
+    if(generation != m_generation) {
+        return;
+    }
+
+    // trees, which are bigger than the whole cache, are not cached
+    if(size > m_maxSize) {
+        return;
+    }
+
+    // replace old entry with the same hash
+    std::unordered_map<uint64_t, std::list<CacheEntry>::iterator>::iterator it;
+    it = m_index.find(hash);
+    if(it != m_index.end()) {
+        removeEntry(it->second);
+    }
+
+    CacheEntry entry;
+    entry.hash = hash;
+    entry.size = size;
+    entry.tree = copy;
+
+    m_entries.push_front(entry);
+    m_index.insert(std::make_pair(hash, m_entries.begin()));
+    m_usedSize += size;
+
+    evict();
+}
+
+/**
+ * @brief get the actual generation of the cache, which has to be requested before a tree is
+ *        validated and given to the add-function together with the tree
+ *
+ * @return actual generation
+ */
+uint64_t
+ParseCache::getGeneration()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_generation;
+}
+
+/**
+ * @brief remove all entries and start a new generation
+ */
+void
+ParseCache::invalidate()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    while(m_entries.size() > 0) {
+        removeEntry(m_entries.begin());
+    }
+
+    m_generation++;
+    m_invalidations++;
+}
+
+/**
+ * @brief change the maximum size of the cache and remove entries, which don't fit anymore
+ *
+ * @param maxSize maximum number of bytes of all cached tree-contents and trees. 0 disables the
+ *                cache.
+ */
+void
+ParseCache::setMaxSize(const uint64_t maxSize)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_maxSize = maxSize;
+    evict();
+}
+
+/**
+ * @brief get metrics of the cache
+ *
+ * @param result reference for the resulting map
+ */
+void
+ParseCache::getMetrics(DataMap &result)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    result.insert("hits", new DataValue(static_cast<long>(m_hits)), true);
+    result.insert("misses", new DataValue(static_cast<long>(m_misses)), true);
+    result.insert("evictions", new DataValue(static_cast<long>(m_evictions)), true);
+    result.insert("invalidations", new DataValue(static_cast<long>(m_invalidations)), true);
+    result.insert("number_of_entries",
+                  new DataValue(static_cast<long>(m_entries.size())),
+                  true);
+    result.insert("used_size", new DataValue(static_cast<long>(m_usedSize)), true);
+    result.insert("max_size", new DataValue(static_cast<long>(m_maxSize)), true);
+}
+
+/**
+ * @brief remove a single entry from the cache
+ *
+ * @param entry iterator to the entry to remove
+ */
+void
+ParseCache::removeEntry(std::list<CacheEntry>::iterator entry)
+{
+    m_usedSize -= entry->size;
+    m_index.erase(entry->hash);
+    m_entries.erase(entry);
+}
+
+/**
+ * @brief remove least recently used entries, until all remaining fit into the maximum size
+ */
+void
+ParseCache::evict()
+{
+    while(m_usedSize > m_maxSize
+          && m_entries.size() > 0)
+    {
+        std::list<CacheEntry>::iterator last = m_entries.end();
+        last--;
+        removeEntry(last);
+        m_evictions++;
+    }
+}
+
+/**
+ * @brief estimate the number of bytes of a sakura-item and all of its childs in memory. The
+ *        estimation doesn't have to be exact, but it has to grow with the number and content of
+ *        the items, so big trees don't fill the cache with only a small content-size.
+ *
+ * @param item item to estimate
+ *
+ * @return estimated number of bytes
+ */
+uint64_t
+estimateItemSize(SakuraItem* item)
+{
+    if(item == nullptr) {
+        return 0;
+    }
+
+    uint64_t size = estimateValueMapSize(item->values);
+
+    switch(item->getType())
+    {
+        case SakuraItem::BLOSSOM_ITEM:
+        {
+            BlossomItem* blossomItem = dynamic_cast<BlossomItem*>(item);
+            size += sizeof(BlossomItem);
+            size += blossomItem->blossomName.size();
+            size += blossomItem->blossomType.size();
+            size += blossomItem->blossomGroupType.size();
+            break;
+        }
+        case SakuraItem::BLOSSOM_GROUP_ITEM:
+        {
+            BlossomGroupItem* groupItem = dynamic_cast<BlossomGroupItem*>(item);
+            size += sizeof(BlossomGroupItem);
+            size += groupItem->id.size();
+            size += groupItem->blossomGroupType.size();
+            for(const std::string &name : groupItem->nameHirarchie) {
+                size += sizeof(std::string) + name.size();
+            }
+            for(BlossomItem* blossomItem : groupItem->blossoms) {
+                size += sizeof(BlossomItem*) + estimateItemSize(blossomItem);
+            }
+            break;
+        }
+        case SakuraItem::TREE_ITEM:
+        {
+            // the unparsed content is already counted by the cache itself
+            TreeItem* treeItem = dynamic_cast<TreeItem*>(item);
+            size += sizeof(TreeItem);
+            size += treeItem->id.size();
+            size += treeItem->relativePath.size();
+            size += treeItem->rootPath.size();
+            size += estimateItemSize(treeItem->childs);
+            break;
+        }
+        case SakuraItem::SUBTREE_ITEM:
+        {
+            SubtreeItem* subtreeItem = dynamic_cast<SubtreeItem*>(item);
+            size += sizeof(SubtreeItem);
+            size += subtreeItem->nameOrPath.size();
+            size += subtreeItem->resolvedId.size();
+            for(const std::string &name : subtreeItem->nameHirarchie) {
+                size += sizeof(std::string) + name.size();
+            }
+            break;
+        }
+        case SakuraItem::SEQUENTIELL_ITEM:
+        {
+            SequentiellPart* sequentiell = dynamic_cast<SequentiellPart*>(item);
+            size += sizeof(SequentiellPart);
+            for(SakuraItem* child : sequentiell->childs) {
+                size += sizeof(SakuraItem*) + estimateItemSize(child);
+            }
+            for(const std::vector<uint64_t> &level : sequentiell->dependencyLevels) {
+                size += sizeof(std::vector<uint64_t>) + level.size() * sizeof(uint64_t);
+            }
+            break;
+        }
+        case SakuraItem::PARALLEL_ITEM:
+        {
+            ParallelPart* parallel = dynamic_cast<ParallelPart*>(item);
+            size += sizeof(ParallelPart);
+            size += estimateValueMapSize(parallel->reductions);
+            size += estimateItemSize(parallel->childs);
+            break;
+        }
+        case SakuraItem::IF_ITEM:
+        {
+            IfBranching* ifBranching = dynamic_cast<IfBranching*>(item);
+            size += sizeof(IfBranching);
+            size += estimateValueSize(ifBranching->leftSide);
+            size += estimateValueSize(ifBranching->rightSide);
+            size += estimateItemSize(ifBranching->ifContent);
+            size += estimateItemSize(ifBranching->elseContent);
+            break;
+        }
+        case SakuraItem::FOR_EACH_ITEM:
+        {
+            ForEachBranching* forEachBranching = dynamic_cast<ForEachBranching*>(item);
+            size += sizeof(ForEachBranching);
+            size += forEachBranching->tempVarName.size();
+            size += estimateValueMapSize(forEachBranching->iterateArray);
+            size += estimateValueMapSize(forEachBranching->reductions);
+            size += estimateItemSize(forEachBranching->content);
+            break;
+        }
+        case SakuraItem::FOR_ITEM:
+        {
+            ForBranching* forBranching = dynamic_cast<ForBranching*>(item);
+            size += sizeof(ForBranching);
+            size += forBranching->tempVarName.size();
+            size += estimateValueSize(forBranching->start);
+            size += estimateValueSize(forBranching->end);
+            size += estimateValueMapSize(forBranching->reductions);
+            size += estimateItemSize(forBranching->content);
+            break;
+        }
+        default:
+            break;
+    }
+
+    return size;
+}
+
+/**
+ * @brief estimate the number of bytes of a value-item-map and its child-maps in memory
+ *
+ * @param valueMap value-item-map to estimate
+ *
+ * @return estimated number of bytes
+ */
+uint64_t
+estimateValueMapSize(const ValueItemMap &valueMap)
+{
+    uint64_t size = 0;
+
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = valueMap.m_valueMap.begin();
+        it != valueMap.m_valueMap.end();
+        it++)
+    {
+        size += it->first.size() + estimateValueSize(it->second);
+    }
+
+    std::map<std::string, ValueItemMap*>::const_iterator childIt;
+    for(childIt = valueMap.m_childMaps.begin();
+        childIt != valueMap.m_childMaps.end();
+        childIt++)
+    {
+        size += childIt->first.size() + sizeof(ValueItemMap);
+        size += estimateValueMapSize(*childIt->second);
+    }
+
+    return size;
+}
+
+/**
+ * @brief estimate the number of bytes of a value-item and its function-calls in memory
+ *
+ * @param value value-item to estimate
+ *
+ * @return estimated number of bytes
+ */
+uint64_t
+estimateValueSize(const ValueItem &value)
+{
+    uint64_t size = sizeof(ValueItem);
+
+    // the string-representation grows with the content of the data-item
+    if(value.item != nullptr) {
+        size += value.item->toString().size();
+    }
+
+    for(const FunctionItem &function : value.functions)
+    {
+        size += sizeof(FunctionItem) + function.type.size();
+        for(const ValueItem &argument : function.arguments) {
+            size += estimateValueSize(argument);
+        }
+    }
+
+    return size;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,105 @@
+/**
+ * @file        parse_cache.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_PARSE_CACHE_H
+#define KITSUNEMIMI_SAKURA_LANG_PARSE_CACHE_H
+
+#include <string>
+#include <stdint.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Kitsunemimi
+{
+class DataMap;
+
+namespace Sakura
+{
+class SakuraItem;
+class TreeItem;
+class ValueItemMap;
+struct ValueItem;
+
+/**
+ * @brief The ParseCache class holds already parsed and validated trees, identified by the hash
+ *        of their content. If the estimated size of all cached contents and trees exceeds the
+ *        maximum size, the least recently used trees are removed. The validation of a tree depends on the
+ *        registered blossoms and the content of the garden, so the cache is invalidated on each
+ *        change of them. Every invalidation starts a new generation and trees, which were
+ *        validated in an older generation, are not added anymore.
+ */
+class ParseCache
+{
+public:
+    ParseCache(const uint64_t maxSize = 16 * 1024 * 1024);
+    ~ParseCache();
+
+    TreeItem* get(const std::string &content);
+    void add(const std::string &content,
+             TreeItem* tree,
+             const uint64_t generation);
+
+    uint64_t getGeneration();
+    void invalidate();
+
+    void setMaxSize(const uint64_t maxSize);
+    void getMetrics(DataMap &result);
+
+private:
+    struct CacheEntry
+    {
+        uint64_t hash = 0;
+        uint64_t size = 0;
+        // cached trees are never changed, so they can be copied outside of the lock
+        std::shared_ptr<TreeItem> tree;
+    };
+
+    std::mutex m_lock;
+
+    // most recently used entry at the front
+    std::list<CacheEntry> m_entries;
+    std::unordered_map<uint64_t, std::list<CacheEntry>::iterator> m_index;
+
+    uint64_t m_maxSize = 0;
+    uint64_t m_usedSize = 0;
+    uint64_t m_generation = 0;
+
+    // metrics
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    uint64_t m_invalidations = 0;
+
+    void removeEntry(std::list<CacheEntry>::iterator entry);
+    void evict();
+};
+
+uint64_t estimateItemSize(SakuraItem* item);
+uint64_t estimateValueMapSize(const ValueItemMap &valueMap);
+uint64_t estimateValueSize(const ValueItem &value);
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_PARSE_CACHE_H
@@ -25,8 +25,6 @@
 #include <parsing/sakura_parsing.h>
 #include <items/sakura_items.h>
 
-#include <libKitsunemimiCommon/common_methods/string_methods.h>
-
 # define YY_DECL \
     Kitsunemimi::Sakura::SakuraParser::symbol_type sakuralex (Kitsunemimi::Sakura::SakuraParserInterface& driver)
 YY_DECL;
@@ -40,7 +38,6 @@ namespace Kitsunemimi
 {
 namespace Sakura
 {
-using Kitsunemimi::splitStringByDelimiter;
 
 /**
  * @brief constructor
@@ -80,10 +77,17 @@ bool
 SakuraParserInterface::parse(const std::string &inputString,
                              const std::string &filePath)
 {
-    // init global values
-    m_inputString = inputString;
+    // init global values. The scanner works directly on the internal copy of the input, which
+    // needs two terminating null-characters for this. The scanner temporary writes
+    // null-characters into the copy, so error-messages are created from the original input.
+    m_originalInput = &inputString;
+    m_inputSize = inputString.size();
+    m_inputString.clear();
+    m_inputString.reserve(m_inputSize + 2);
+    m_inputString.append(inputString);
+    m_inputString.append(2, '\0');
     m_registeredKeys.clear();
-    m_registeredKeys.push_back("blossom_output");
+    m_registeredKeys.insert("blossom_output");
 
     // init error-message
     m_errorMessage.clearTable();
@@ -103,10 +107,11 @@ SakuraParserInterface::parse(const std::string &inputString,
     }
 
     // run parser-code
-    this->scan_begin(inputString);
+    this->scan_begin();
     Kitsunemimi::Sakura::SakuraParser parser(*this);
     const int res = parser.parse();
     this->scan_end();
+    m_originalInput = nullptr;
 
     if(res != 0) {
         return false;
@@ -150,9 +155,7 @@ SakuraParserInterface::error(const Kitsunemimi::Sakura::location& location,
     const uint32_t errorStart = location.begin.column;
     const uint32_t errorLength = location.end.column - location.begin.column;
     const uint32_t linenumber = location.begin.line;
-
-    std::vector<std::string> splittedContent;
-    splitStringByDelimiter(splittedContent, m_inputString, '\n');
+    const std::string brokenLine = getLine(linenumber);
 
     // build error-message
     std::string errorString = "";
@@ -164,7 +167,7 @@ SakuraParserInterface::error(const Kitsunemimi::Sakura::location& location,
     // add additional position information
     if(customError == false)
     {
-        if(splittedContent[linenumber - 1].size() > errorStart-1+errorLength)
+        if(brokenLine.size() > errorStart-1+errorLength)
         {
             m_errorMessage.addRow(std::vector<std::string>
             {
@@ -174,7 +177,7 @@ SakuraParserInterface::error(const Kitsunemimi::Sakura::location& location,
             m_errorMessage.addRow(std::vector<std::string>
             {
                 "broken part in string",
-                "\"" + splittedContent[linenumber - 1].substr(errorStart - 1, errorLength) + "\""
+                "\"" + brokenLine.substr(errorStart - 1, errorLength) + "\""
             });
         }
         else
@@ -208,16 +211,58 @@ TableItem SakuraParserInterface::getErrorMessage() const
 bool
 SakuraParserInterface::isKeyRegistered(const std::string &key)
 {
-    std::vector<std::string>::const_iterator it;
-    for(it = m_registeredKeys.begin();
-        it != m_registeredKeys.end();
-        it++)
+    return m_registeredKeys.find(key) != m_registeredKeys.end();
+}
+
+/**
+ * @brief get a single line of the actual input. Only the lines until the requested one are
+ *        searched, so the input is not splitted completely only for an error-message. The line
+ *        is taken from the original input, because the scanner modifies its internal copy.
+ *
+ * @param lineNumber number of the requested line, beginning with 1
+ *
+ * @return requested line, or empty string, if the line doesn't exist
+ */
+const std::string
+SakuraParserInterface::getLine(const uint32_t lineNumber) const
+{
+    if(m_originalInput == nullptr) {
+        return "";
+    }
+
+    const std::string &input = *m_originalInput;
+    uint64_t lineStart = 0;
+    for(uint32_t i = 1; i < lineNumber; i++)
     {
-        if(*it == key) {
-            return true;
+        lineStart = input.find('\n', lineStart);
+        if(lineStart == std::string::npos) {
+            return "";
         }
+        lineStart++;
     }
-    return false;
+
+    uint64_t lineEnd = input.find('\n', lineStart);
+    if(lineEnd == std::string::npos) {
+        lineEnd = input.size();
+    }
+
+    return input.substr(lineStart, lineEnd - lineStart);
+}
+
+/**
+ * @brief store the position of an item within the parsed file in the item
+ *
+ * @param item item, which was created by the parser
+ * @param location location of the item within the parsed file
+ */
+void
+SakuraParserInterface::setSpan(SakuraItem* item,
+                               const Kitsunemimi::Sakura::location &location)
+{
+    item->span.line = static_cast<uint32_t>(location.begin.line);
+    item->span.column = static_cast<uint32_t>(location.begin.column);
+    item->span.endLine = static_cast<uint32_t>(location.end.line);
+    item->span.endColumn = static_cast<uint32_t>(location.end.column);
 }
 
 /**
@@ -236,14 +281,11 @@ SakuraParserInterface::removeQuotes(const std::string &input)
     }
 
     // remove double-quotes
-    if(input[0] == '\"' && input[input.length()-1] == '\"')
+    if(input.length() >= 2
+            && input[0] == '\"'
+            && input[input.length()-1] == '\"')
     {
-        std::string result = "";
-        for(uint32_t i = 1; i < input.length()-1; i++) {
-            result += input[i];
-        }
-
-        return result;
+        return input.substr(1, input.length() - 2);
     }
 
     return input;
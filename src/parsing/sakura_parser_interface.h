@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_set>
 
 #include <libKitsunemimiCommon/common_items/data_items.h>
 #include <libKitsunemimiCommon/common_items/table_item.h>
@@ -48,7 +49,7 @@ public:
     ~SakuraParserInterface();
 
     // connection the the scanner and parser
-    void scan_begin(const std::string &inputString);
+    void scan_begin();
     void scan_end();
     bool parse(const std::string &inputString,
                const std::string &filePath);
@@ -63,16 +64,25 @@ public:
                const bool customError=false);
     TableItem getErrorMessage() const;
 
+    void setSpan(SakuraItem* item,
+                 const Kitsunemimi::Sakura::location &location);
+
     const std::string removeQuotes(const std::string &input);
-    std::vector<std::string> m_registeredKeys;
+    std::unordered_set<std::string> m_registeredKeys;
     bool isKeyRegistered(const std::string &key);
 
     SakuraParsing* m_sakuraParsing = nullptr;
 private:
     bool m_traceParsing = false;
     std::string m_inputString = "";
+    uint64_t m_inputSize = 0;
+    // original input of the caller, which is not modified by the scanner. Only valid while
+    // parsing, which is the only time, where error-messages are created.
+    const std::string* m_originalInput = nullptr;
     SakuraItem* m_output = nullptr;
     TableItem m_errorMessage;
+
+    const std::string getLine(const uint32_t lineNumber) const;
 };
 
 }  // namespace Sakura
@@ -24,7 +24,6 @@
 
 #include <items/sakura_items.h>
 #include <sakura_garden.h>
-#include <validator.h>
 #include <parsing/sakura_parser_interface.h>
 
 #include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
@@ -49,7 +48,6 @@ namespace Sakura
  */
 SakuraParsing::SakuraParsing(const bool debug)
 {
-    m_validator = new Validator();
     m_parserInterface = new SakuraParserInterface(debug, this);
 }
 
@@ -76,6 +74,7 @@ SakuraParsing::parseTreeString(const std::string &name,
                                std::string &errorMessage)
 {
     // parse
+    m_parseFiles = false;
     TreeItem* parsetItem = parseStringToTree(content, "", errorMessage);
     if(parsetItem == nullptr) {
         return nullptr;
@@ -91,8 +90,10 @@ SakuraParsing::parseTreeString(const std::string &name,
 /**
  * @brief parse all sakura-files at a specific location
  *
- * @param garden reference to the sakura-garden-object to store all found data
+ * @param garden reference to the sakura-garden-object to store all found resources, templates
+ *               and files
  * @param initialFilePath path to file initial file to parse
+ * @param parsedTrees reference for the parsed trees, which are not already in the garden
  * @param errorMessage reference to error-message
  *
  * @return true, if pasing all files was successful, else false
@@ -100,6 +101,7 @@ SakuraParsing::parseTreeString(const std::string &name,
 bool
 SakuraParsing::parseTreeFiles(SakuraGarden &garden,
                               const bfs::path &initialFilePath,
+                              std::map<std::string, TreeItem*> &parsedTrees,
                               std::string &errorMessage)
 {
     LOG_DEBUG("start parsing all files in " + initialFilePath.string());
@@ -122,11 +124,75 @@ SakuraParsing::parseTreeFiles(SakuraGarden &garden,
     const bfs::path fileName = initialFilePath.leaf();
 
     // set global stuff
-    garden.rootPath = rootPath.string();
+    garden.setRootPath(rootPath.string());
     m_rootPath = rootPath;
+    m_fileQueue.clear();
     m_fileQueue.push_back(fileName.string());
 
     // process all files in queue
+    return processFileQueue(garden, parsedTrees, errorMessage);
+}
+
+/**
+ * @brief parse new versions of already known trees, whose files were changed, without adding
+ *        them to the sakura-garden
+ *
+ * @param garden reference to the sakura-garden-object, which holds the current versions
+ * @param changedTrees map with the ids of the changed trees and their root-paths
+ * @param parsedTrees reference for the new parsed trees, which includes also files, which are
+ *                    referenced for the first time by the new versions
+ * @param errorMessage reference to error-message
+ *
+ * @return true, if pasing all files was successful, else false
+ */
+bool
+SakuraParsing::parseChangedTreeFiles(SakuraGarden &garden,
+                                     const std::map<std::string, std::string> &changedTrees,
+                                     std::map<std::string, TreeItem*> &parsedTrees,
+                                     std::string &errorMessage)
+{
+    std::map<std::string, std::string>::const_iterator it;
+    for(it = changedTrees.begin();
+        it != changedTrees.end();
+        it++)
+    {
+        LOG_DEBUG("reparse changed file " + it->first);
+
+        m_rootPath = it->second;
+        m_currentFilePath = m_rootPath / it->first;
+        m_fileQueue.clear();
+
+        TreeItem* parsedTree = parseSingleFile(it->first, m_rootPath, errorMessage);
+        if(parsedTree == nullptr)
+        {
+            deleteTrees(parsedTrees);
+            return false;
+        }
+        parsedTrees.insert(std::make_pair(it->first, parsedTree));
+
+        // parse files, which are referenced for the first time by the new version
+        if(processFileQueue(garden, parsedTrees, errorMessage) == false) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief parse all files in the file-queue, which are not already parsed
+ *
+ * @param garden reference to the sakura-garden-object to store resources, templates and files
+ * @param parsedTrees reference for the parsed trees
+ * @param errorMessage reference to error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+SakuraParsing::processFileQueue(SakuraGarden &garden,
+                                std::map<std::string, TreeItem*> &parsedTrees,
+                                std::string &errorMessage)
+{
     while(m_fileQueue.size() > 0)
     {
         // get path from queue
@@ -134,12 +200,14 @@ SakuraParsing::parseTreeFiles(SakuraGarden &garden,
         m_fileQueue.pop_front();
 
         // check if already parsed
-        if(garden.containsTree(currentRelPath)) {
+        if(garden.containsTree(currentRelPath)
+                || parsedTrees.find(currentRelPath) != parsedTrees.end())
+        {
             continue;
         }
 
         // build absolute path
-        const bfs::path filePath = rootPath / currentRelPath;
+        const bfs::path filePath = m_rootPath / currentRelPath;
         m_currentFilePath = filePath;
 
         // precheck if file exist
@@ -152,39 +220,29 @@ SakuraParsing::parseTreeFiles(SakuraGarden &garden,
                                                         "path doesn't exist: "
                                                         + filePath.string()});
             errorMessage = errorOutput.toString();
+            deleteTrees(parsedTrees);
             return false;
         }
 
         // parse file
-        TreeItem* parsedTree = parseSingleFile(currentRelPath, rootPath, errorMessage);
-        if(parsedTree == nullptr) {
-            return false;
-        }
-
-        // add parsed sakura-file to results
-        if(garden.addTree(currentRelPath, dynamic_cast<TreeItem*>(parsedTree)) == false)
+        TreeItem* parsedTree = parseSingleFile(currentRelPath, m_rootPath, errorMessage);
+        if(parsedTree == nullptr)
         {
-            TableItem errorOutput;
-            initErrorOutput(errorOutput);
-            errorOutput.addRow({"source", "while reading trees"});
-            errorOutput.addRow({"message", "id already used: " + currentRelPath});
-            errorMessage = errorOutput.toString();
+            deleteTrees(parsedTrees);
             return false;
         }
+        parsedTrees.insert(std::make_pair(currentRelPath, parsedTree));
 
-        // get additional files
+        // get additional files. The directory is registered in the garden, so it is collected
+        // again, if the collected content is not published.
         const bfs::path dirPath = filePath.parent_path();
-        if(alreadyCollected(dirPath) == false)
+        if(garden.addCollectedDirectory(dirPath.string()))
         {
-            m_collectedDirectories.push_back(dirPath.string());
-
-            if(collectFiles(garden, dirPath, errorMessage) == false) {
-                return false;
-            }
-            if(collectResources(garden, dirPath, errorMessage) == false) {
-                return false;
-            }
-            if(collectTemplates(garden, dirPath, errorMessage) == false) {
+            if(collectFiles(garden, dirPath, errorMessage) == false
+                    || collectResources(garden, dirPath, errorMessage) == false
+                    || collectTemplates(garden, dirPath, errorMessage) == false)
+            {
+                deleteTrees(parsedTrees);
                 return false;
             }
         }
@@ -194,13 +252,40 @@ SakuraParsing::parseTreeFiles(SakuraGarden &garden,
 }
 
 /**
- * @brief add subtree to parsing-queue. This function is used in sakura_parser.y
+ * @brief delete all trees of a map and clear the map
  *
- * @param relativePath relative path of the file to add
+ * @param trees map with the trees to delete
  */
 void
+SakuraParsing::deleteTrees(std::map<std::string, TreeItem*> &trees)
+{
+    std::map<std::string, TreeItem*>::iterator it;
+    for(it = trees.begin();
+        it != trees.end();
+        it++)
+    {
+        delete it->second;
+    }
+
+    trees.clear();
+}
+
+/**
+ * @brief add subtree to parsing-queue and resolve its id within the garden. This function is
+ *        used in sakura_parser.y
+ *
+ * @param relativePath relative path of the file to add
+ *
+ * @return id of the subtree within the garden
+ */
+const std::string
 SakuraParsing::addFileToQueue(bfs::path relativePath)
 {
+    // trees, which are given as string, call their subtrees directly by id
+    if(m_parseFiles == false) {
+        return relativePath.string();
+    }
+
     const bfs::path rootPath = m_currentFilePath.parent_path();
     if(bfs::is_directory(rootPath / relativePath)) {
         relativePath /= bfs::path("root.sakura");
@@ -210,6 +295,8 @@ SakuraParsing::addFileToQueue(bfs::path relativePath)
     const bfs::path newRelativePath = bfs::relative(oldAbsolutePath, m_rootPath);
 
     m_fileQueue.push_back(newRelativePath.string());
+
+    return newRelativePath.string();
 }
 
 /**
@@ -230,6 +317,8 @@ SakuraParsing::parseSingleFile(const bfs::path &relativePath,
 
     LOG_DEBUG("parse file " + filePath.string());
 
+    m_parseFiles = true;
+
     // read file
     std::string fileContent = "";
     bool readResult = readFile(fileContent, filePath.string(), errorMessage);
@@ -492,26 +581,6 @@ SakuraParsing::getFilesInDir(SakuraGarden &garden,
     return true;
 }
 
-/**
- * @brief check if templates, resources and file of a location are already read
- *
- * @return true, if location was already corrected, else false
- */
-bool
-SakuraParsing::alreadyCollected(const bfs::path &path)
-{
-    std::vector<std::string>::iterator it;
-    it = std::find(m_collectedDirectories.begin(),
-                   m_collectedDirectories.end(),
-                   path.string());
-
-    if(it != m_collectedDirectories.end()) {
-        return true;
-    }
-
-    return false;
-}
-
 /**
  * @brief parse a string
  *
@@ -43,7 +43,6 @@ namespace Sakura
 class TreeItem;
 class SakuraItem;
 class SakuraGarden;
-class Validator;
 
 class SakuraParserInterface;
 
@@ -59,19 +58,27 @@ public:
 
     bool parseTreeFiles(SakuraGarden &garden,
                         const bfs::path &initialFilePath,
+                        std::map<std::string, TreeItem*> &parsedTrees,
                         std::string &errorMessage);
+    bool parseChangedTreeFiles(SakuraGarden &garden,
+                               const std::map<std::string, std::string> &changedTrees,
+                               std::map<std::string, TreeItem*> &parsedTrees,
+                               std::string &errorMessage);
 
     // for internal usage
-    void addFileToQueue(bfs::path relativePath);
+    const std::string addFileToQueue(bfs::path relativePath);
 
 private:
     SakuraParserInterface* m_parserInterface = nullptr;
-    Validator* m_validator = nullptr;
     std::deque<std::string> m_fileQueue;
-    std::vector<std::string> m_collectedDirectories;
     bfs::path m_rootPath;
     bfs::path m_currentFilePath;
+    bool m_parseFiles = false;
 
+    bool processFileQueue(SakuraGarden &garden,
+                          std::map<std::string, TreeItem*> &parsedTrees,
+                          std::string &errorMessage);
+    void deleteTrees(std::map<std::string, TreeItem*> &trees);
     TreeItem* parseSingleFile(const bfs::path &relativePath,
                               const bfs::path &rootPath,
                               std::string &errorMessage);
@@ -93,7 +100,6 @@ private:
                        const bfs::path &directory,
                        const std::string &type,
                        std::string &errorMessage);
-    bool alreadyCollected(const bfs::path &path);
 };
 
 } // namespace Sakura
@@ -0,0 +1,276 @@
+/**
+ * @file        blossom_cache.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "blossom_cache.h"
+
+#include <processing/blossom_trace.h>
+
+#include <libKitsunemimiSakuraLang/blossom.h>
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor
+ *
+ * @param maxSize maximum number of bytes of all cached inputs and outputs. 0 disables the cache.
+ * @param numberOfShards number of independent parts of the cache
+ */
+BlossomCache::BlossomCache(const uint64_t maxSize,
+                           const uint32_t numberOfShards)
+{
+    for(uint32_t i = 0; i < numberOfShards; i++) {
+        m_shards.push_back(new CacheShard());
+    }
+
+    setMaxSize(maxSize);
+}
+
+/**
+ * @brief destructor
+ */
+BlossomCache::~BlossomCache()
+{
+    for(uint64_t i = 0; i < m_shards.size(); i++) {
+        delete m_shards.at(i);
+    }
+}
+
+/**
+ * @brief create the key to identify the result of a blossom for a specific input. The name of
+ *        the blossom-call is not part of the key, so all calls of the same blossom with the same
+ *        input share their result.
+ *
+ * @param blossomLeaf blossom-leaf with the filled input
+ *
+ * @return key of the blossom-call
+ */
+const std::string
+BlossomCache::createKey(BlossomLeaf &blossomLeaf)
+{
+    std::string key = blossomLeaf.blossomGroupType;
+    key.push_back('\0');
+    key.append(blossomLeaf.blossomType);
+    key.push_back('\0');
+    BlossomTrace::serializeItem(key, &blossomLeaf.input);
+
+    return key;
+}
+
+/**
+ * @brief request the cached result of a blossom-call
+ *
+ * @param key key of the blossom-call
+ * @param blossomLeaf blossom-leaf, which gets the cached output
+ *
+ * @return true, if found, else false
+ */
+bool
+BlossomCache::get(const std::string &key,
+                  BlossomLeaf &blossomLeaf)
+{
+    const uint64_t hash = std::hash<std::string>()(key);
+    CacheShard* shard = m_shards.at(hash % m_shards.size());
+
+    std::string serializedOutput = "";
+    {
+        std::lock_guard<std::mutex> guard(shard->lock);
+
+        std::unordered_map<uint64_t, std::list<CacheEntry>::iterator>::const_iterator it;
+        it = shard->index.find(hash);
+
+        // compare the key too, because different keys can have the same hash
+        if(it == shard->index.end()
+                || it->second->key != key)
+        {
+            shard->misses++;
+            return false;
+        }
+
+        // mark as most recently used
+        shard->entries.splice(shard->entries.begin(), shard->entries, it->second);
+        shard->hits++;
+
+        serializedOutput = it->second->serializedOutput;
+        blossomLeaf.terminalOutput = it->second->terminalOutput;
+    }
+
+    // convert the output outside of the lock
+    uint64_t position = 0;
+    DataItem* output = nullptr;
+    if(BlossomTrace::deserializeItem(serializedOutput, position, output) == false
+            || output == nullptr
+            || output->isMap() == false)
+    {
+        delete output;
+        return false;
+    }
+
+    blossomLeaf.output.clear();
+    std::swap(blossomLeaf.output.m_map, output->toMap()->m_map);
+    delete output;
+
+    return true;
+}
+
+/**
+ * @brief add the result of a successful blossom-call to the cache
+ *
+ * @param key key of the blossom-call
+ * @param blossomLeaf blossom-leaf after the processing
+ */
+void
+BlossomCache::add(const std::string &key,
+                  BlossomLeaf &blossomLeaf)
+{
+    const uint64_t hash = std::hash<std::string>()(key);
+    CacheShard* shard = m_shards.at(hash % m_shards.size());
+
+    CacheEntry entry;
+    entry.hash = hash;
+    entry.key = key;
+    entry.terminalOutput = blossomLeaf.terminalOutput;
+    BlossomTrace::serializeItem(entry.serializedOutput, &blossomLeaf.output);
+    entry.size = entry.key.size()
+                 + entry.serializedOutput.size()
+                 + entry.terminalOutput.size();
+
+    std::lock_guard<std::mutex> guard(shard->lock);
+
+    // results, which are bigger than the whole shard, are not cached
+    if(entry.size > shard->maxSize) {
+        return;
+    }
+
+    // replace old entry with the same hash
+    std::unordered_map<uint64_t, std::list<CacheEntry>::iterator>::iterator it;
+    it = shard->index.find(hash);
+    if(it != shard->index.end()) {
+        removeEntry(*shard, it->second);
+    }
+
+    shard->usedSize += entry.size;
+    shard->entries.push_front(std::move(entry));
+    shard->index.insert(std::make_pair(hash, shard->entries.begin()));
+
+    evict(*shard);
+}
+
+/**
+ * @brief change the maximum size of the cache and remove entries, which don't fit anymore
+ *
+ * @param maxSize maximum number of bytes of all cached inputs and outputs. 0 disables the cache.
+ */
+void
+BlossomCache::setMaxSize(const uint64_t maxSize)
+{
+    for(uint64_t i = 0; i < m_shards.size(); i++)
+    {
+        CacheShard* shard = m_shards.at(i);
+        std::lock_guard<std::mutex> guard(shard->lock);
+
+        shard->maxSize = maxSize / m_shards.size();
+        evict(*shard);
+    }
+}
+
+/**
+ * @brief get metrics of the cache
+ *
+ * @param result reference for the resulting map
+ */
+void
+BlossomCache::getMetrics(DataMap &result)
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t numberOfEntries = 0;
+    uint64_t usedSize = 0;
+    uint64_t maxSize = 0;
+
+    for(uint64_t i = 0; i < m_shards.size(); i++)
+    {
+        CacheShard* shard = m_shards.at(i);
+        std::lock_guard<std::mutex> guard(shard->lock);
+
+        hits += shard->hits;
+        misses += shard->misses;
+        evictions += shard->evictions;
+        numberOfEntries += shard->entries.size();
+        usedSize += shard->usedSize;
+        maxSize += shard->maxSize;
+    }
+
+    double hitRate = 0.0;
+    if(hits + misses > 0) {
+        hitRate = static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+
+    result.insert("hits", new DataValue(static_cast<long>(hits)), true);
+    result.insert("misses", new DataValue(static_cast<long>(misses)), true);
+    result.insert("hit_rate", new DataValue(hitRate), true);
+    result.insert("evictions", new DataValue(static_cast<long>(evictions)), true);
+    result.insert("number_of_entries", new DataValue(static_cast<long>(numberOfEntries)), true);
+    result.insert("used_size", new DataValue(static_cast<long>(usedSize)), true);
+    result.insert("max_size", new DataValue(static_cast<long>(maxSize)), true);
+}
+
+/**
+ * @brief remove a single entry from a shard
+ *
+ * @param shard shard, which contains the entry
+ * @param entry iterator to the entry to remove
+ */
+void
+BlossomCache::removeEntry(CacheShard &shard,
+                          std::list<CacheEntry>::iterator entry)
+{
+    shard.usedSize -= entry->size;
+    shard.index.erase(entry->hash);
+    shard.entries.erase(entry);
+}
+
+/**
+ * @brief remove least recently used entries of a shard, until all remaining fit into the
+ *        maximum size of the shard
+ *
+ * @param shard shard to clean up
+ */
+void
+BlossomCache::evict(CacheShard &shard)
+{
+    while(shard.usedSize > shard.maxSize
+          && shard.entries.size() > 0)
+    {
+        std::list<CacheEntry>::iterator last = shard.entries.end();
+        last--;
+        removeEntry(shard, last);
+        shard.evictions++;
+    }
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,98 @@
+/**
+ * @file        blossom_cache.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_BLOSSOM_CACHE_H
+#define KITSUNEMIMI_SAKURA_LANG_BLOSSOM_CACHE_H
+
+#include <string>
+#include <stdint.h>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+namespace Kitsunemimi
+{
+class DataMap;
+
+namespace Sakura
+{
+struct BlossomLeaf;
+
+/**
+ * @brief The BlossomCache class holds the results of pure blossoms, identified by the blossom
+ *        and the hash of its input. The cache is split into multiple shards with their own lock
+ *        and their own least-recently-used order, so parallel worker-threads rarely wait for
+ *        each other.
+ */
+class BlossomCache
+{
+public:
+    BlossomCache(const uint64_t maxSize = 16 * 1024 * 1024,
+                 const uint32_t numberOfShards = 16);
+    ~BlossomCache();
+
+    static const std::string createKey(BlossomLeaf &blossomLeaf);
+
+    bool get(const std::string &key, BlossomLeaf &blossomLeaf);
+    void add(const std::string &key, BlossomLeaf &blossomLeaf);
+
+    void setMaxSize(const uint64_t maxSize);
+    void getMetrics(DataMap &result);
+
+private:
+    struct CacheEntry
+    {
+        uint64_t hash = 0;
+        uint64_t size = 0;
+        std::string key = "";
+        std::string serializedOutput = "";
+        std::string terminalOutput = "";
+    };
+
+    struct CacheShard
+    {
+        std::mutex lock;
+
+        // most recently used entry at the front
+        std::list<CacheEntry> entries;
+        std::unordered_map<uint64_t, std::list<CacheEntry>::iterator> index;
+
+        uint64_t maxSize = 0;
+        uint64_t usedSize = 0;
+
+        // metrics
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    std::vector<CacheShard*> m_shards;
+
+    void removeEntry(CacheShard &shard, std::list<CacheEntry>::iterator entry);
+    void evict(CacheShard &shard);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_BLOSSOM_CACHE_H
@@ -0,0 +1,653 @@
+/**
+ * @file        blossom_trace.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "blossom_trace.h"
+
+#include <cstring>
+
+#include <libKitsunemimiSakuraLang/blossom.h>
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+// identifier at the beginning of each trace
+const std::string TRACE_HEADER = "SAKURA-TRACE-1";
+
+// type-tags of the serialized items
+enum TraceItemType
+{
+    NULL_TRACE_ITEM = 0,
+    STRING_TRACE_ITEM = 1,
+    INT_TRACE_ITEM = 2,
+    FLOAT_TRACE_ITEM = 3,
+    BOOL_TRACE_ITEM = 4,
+    MAP_TRACE_ITEM = 5,
+    ARRAY_TRACE_ITEM = 6,
+};
+
+/**
+ * @brief constructor
+ *
+ * @param flushSize number of bytes of recorded calls, which are buffered before they are written
+ *                  into the trace-file
+ */
+BlossomTrace::BlossomTrace(const uint64_t flushSize)
+{
+    m_mode = NO_TRACE;
+    m_flushSize = flushSize;
+}
+
+/**
+ * @brief destructor, which writes the rest of a running recording
+ */
+BlossomTrace::~BlossomTrace()
+{
+    closeRecording();
+}
+
+/**
+ * @brief get the current mode of the trace
+ *
+ * @return current mode
+ */
+BlossomTrace::TraceMode
+BlossomTrace::getMode() const
+{
+    return static_cast<TraceMode>(m_mode.load());
+}
+
+/**
+ * @brief start a new recording into a file and finish the old recording or drop the loaded trace
+ *
+ * @param filePath path of the file, where the trace should be written
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if the file can not be opened, else true
+ */
+bool
+BlossomTrace::startRecording(const std::string &filePath,
+                             std::string &errorMessage)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    closeRecording();
+    m_entries.clear();
+    m_index.clear();
+    m_mode = NO_TRACE;
+
+    m_file.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(m_file.is_open() == false)
+    {
+        errorMessage = "failed to open trace-file: " + filePath;
+        return false;
+    }
+
+    m_buffer = TRACE_HEADER;
+    m_writeFailed = false;
+    m_mode = RECORD_TRACE;
+
+    return true;
+}
+
+/**
+ * @brief stop the current recording and write the rest of the buffer into the trace-file
+ *
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if no recording was running or writing the file failed, else true
+ */
+bool
+BlossomTrace::stopRecording(std::string &errorMessage)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if(m_mode != RECORD_TRACE)
+    {
+        errorMessage = "no trace-recording is running";
+        return false;
+    }
+
+    m_mode = NO_TRACE;
+    if(closeRecording() == false)
+    {
+        errorMessage = "failed to write trace-file";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief write the buffered calls into the trace-file and clear the buffer. Must be called
+ *        while the lock is held.
+ */
+void
+BlossomTrace::flushBuffer()
+{
+    // after a failed write the rest of the recording is dropped, because the file is
+    // incomplete anyway. The error is reported, when the recording is stopped.
+    if(m_writeFailed == false)
+    {
+        m_file.write(m_buffer.c_str(), static_cast<std::streamsize>(m_buffer.size()));
+        m_file.flush();
+        m_writeFailed = m_file.good() == false;
+    }
+
+    m_buffer.clear();
+}
+
+/**
+ * @brief write the rest of the buffer and close the trace-file, if open. Must be called while
+ *        the lock is held.
+ *
+ * @return false, if writing the file failed, else true
+ */
+bool
+BlossomTrace::closeRecording()
+{
+    if(m_file.is_open() == false) {
+        return true;
+    }
+
+    flushBuffer();
+    m_file.close();
+    if(m_file.fail()) {
+        m_writeFailed = true;
+    }
+
+    return m_writeFailed == false;
+}
+
+/**
+ * @brief add a processed blossom-call to the recording
+ *
+ * @param blossomLeaf blossom-leaf after the processing
+ * @param serializedInput serialized input of the blossom before the processing
+ * @param success true, if the blossom was successful, else false
+ * @param errorMessage error-message of the blossom, if failed
+ */
+void
+BlossomTrace::record(BlossomLeaf &blossomLeaf,
+                     const std::string &serializedInput,
+                     const bool success,
+                     const std::string &errorMessage)
+{
+    // serialize outside of the lock, so parallel blossoms only wait for the append
+    std::string entry = "";
+    appendString(entry, createKey(blossomLeaf, serializedInput));
+
+    std::string serializedOutput = "";
+    serializeItem(serializedOutput, &blossomLeaf.output);
+    appendString(entry, serializedOutput);
+
+    appendString(entry, blossomLeaf.terminalOutput);
+    appendString(entry, errorMessage);
+    entry.push_back(static_cast<char>(success));
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // the recording could be stopped, while the blossom was processed
+    if(m_mode != RECORD_TRACE) {
+        return;
+    }
+
+    m_buffer.append(entry);
+    if(m_buffer.size() >= m_flushSize) {
+        flushBuffer();
+    }
+}
+
+/**
+ * @brief start the replay of a recorded trace
+ *
+ * @param trace binary trace, which was created by a recording
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if the trace is broken, else true
+ */
+bool
+BlossomTrace::startReplay(const std::string &trace,
+                          std::string &errorMessage)
+{
+    if(trace.compare(0, TRACE_HEADER.size(), TRACE_HEADER) != 0)
+    {
+        errorMessage = "input is not a blossom-trace";
+        return false;
+    }
+
+    std::vector<TraceEntry> entries;
+    std::unordered_map<std::string, std::deque<uint64_t>> index;
+
+    uint64_t position = TRACE_HEADER.size();
+    while(position < trace.size())
+    {
+        std::string key = "";
+        TraceEntry entry;
+
+        if(readString(trace, position, key) == false
+                || readString(trace, position, entry.serializedOutput) == false
+                || readString(trace, position, entry.terminalOutput) == false
+                || readString(trace, position, entry.errorMessage) == false
+                || position >= trace.size())
+        {
+            errorMessage = "blossom-trace is incomplete";
+            return false;
+        }
+
+        entry.success = trace[position] != 0;
+        position++;
+
+        index[key].push_back(entries.size());
+        entries.push_back(entry);
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    // a running recording is finished, so its file is complete
+    closeRecording();
+
+    std::swap(m_entries, entries);
+    std::swap(m_index, index);
+    m_mode = REPLAY_TRACE;
+
+    return true;
+}
+
+/**
+ * @brief stop the replay and drop the loaded trace
+ */
+void
+BlossomTrace::stopReplay()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    m_mode = NO_TRACE;
+    m_entries.clear();
+    m_index.clear();
+}
+
+/**
+ * @brief replace the processing of a blossom by the next recorded call of the same blossom with
+ *        the same input
+ *
+ * @param blossomLeaf blossom-leaf with the input, which gets the recorded output
+ * @param success reference for the recorded result of the blossom
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if no matching call was recorded, else true
+ */
+bool
+BlossomTrace::replay(BlossomLeaf &blossomLeaf,
+                     bool &success,
+                     std::string &errorMessage)
+{
+    std::string serializedInput = "";
+    serializeItem(serializedInput, &blossomLeaf.input);
+    const std::string key = createKey(blossomLeaf, serializedInput);
+
+    std::string serializedOutput = "";
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        std::unordered_map<std::string, std::deque<uint64_t>>::iterator it;
+        it = m_index.find(key);
+        if(it == m_index.end()
+                || it->second.size() == 0)
+        {
+            errorMessage = "no recorded call of the blossom with the given input";
+            return false;
+        }
+
+        TraceEntry &entry = m_entries[it->second.front()];
+        it->second.pop_front();
+
+        serializedOutput = entry.serializedOutput;
+        blossomLeaf.terminalOutput = entry.terminalOutput;
+        errorMessage = entry.errorMessage;
+        success = entry.success;
+    }
+
+    // convert the recorded output
+    uint64_t position = 0;
+    DataItem* output = nullptr;
+    if(deserializeItem(serializedOutput, position, output) == false
+            || output == nullptr
+            || output->isMap() == false)
+    {
+        delete output;
+        errorMessage = "recorded output of the blossom is broken";
+        return false;
+    }
+
+    std::swap(blossomLeaf.output.m_map, output->toMap()->m_map);
+    delete output;
+
+    return true;
+}
+
+/**
+ * @brief convert a data-item into its binary form
+ *
+ * @param output reference to the string, where the binary form should be appended
+ * @param item item, which should be converted
+ */
+void
+BlossomTrace::serializeItem(std::string &output, DataItem* item)
+{
+    if(item == nullptr)
+    {
+        output.push_back(static_cast<char>(NULL_TRACE_ITEM));
+        return;
+    }
+
+    if(item->isMap())
+    {
+        DataMap* map = item->toMap();
+        output.push_back(static_cast<char>(MAP_TRACE_ITEM));
+        appendNumber(output, map->m_map.size());
+
+        // the map is sorted, so equal maps result in equal binary forms
+        std::map<std::string, DataItem*>::const_iterator it;
+        for(it = map->m_map.begin();
+            it != map->m_map.end();
+            it++)
+        {
+            appendString(output, it->first);
+            serializeItem(output, it->second);
+        }
+
+        return;
+    }
+
+    if(item->isArray())
+    {
+        DataArray* array = item->toArray();
+        output.push_back(static_cast<char>(ARRAY_TRACE_ITEM));
+        appendNumber(output, array->m_array.size());
+
+        for(uint64_t i = 0; i < array->m_array.size(); i++) {
+            serializeItem(output, array->m_array.at(i));
+        }
+
+        return;
+    }
+
+    if(item->isIntValue())
+    {
+        output.push_back(static_cast<char>(INT_TRACE_ITEM));
+        appendNumber(output, static_cast<uint64_t>(item->getLong()));
+        return;
+    }
+
+    if(item->isFloatValue())
+    {
+        const double value = item->getDouble();
+        uint64_t number = 0;
+        memcpy(&number, &value, sizeof(double));
+
+        output.push_back(static_cast<char>(FLOAT_TRACE_ITEM));
+        appendNumber(output, number);
+        return;
+    }
+
+    if(item->isBoolValue())
+    {
+        output.push_back(static_cast<char>(BOOL_TRACE_ITEM));
+        output.push_back(static_cast<char>(item->getBool()));
+        return;
+    }
+
+    output.push_back(static_cast<char>(STRING_TRACE_ITEM));
+    appendString(output, item->getString());
+}
+
+/**
+ * @brief convert the binary form of a data-item back into a data-item
+ *
+ * @param input string with the binary form
+ * @param position reference to the read-position within the input, which is moved behind the
+ *                 converted item
+ * @param item reference for the resulting item, which can be a nullptr
+ *
+ * @return false, if the binary form is broken, else true
+ */
+bool
+BlossomTrace::deserializeItem(const std::string &input,
+                              uint64_t &position,
+                              DataItem* &item)
+{
+    item = nullptr;
+    if(position >= input.size()) {
+        return false;
+    }
+
+    const uint8_t type = static_cast<uint8_t>(input[position]);
+    position++;
+
+    switch(type)
+    {
+        case NULL_TRACE_ITEM:
+        {
+            return true;
+        }
+        case STRING_TRACE_ITEM:
+        {
+            std::string value = "";
+            if(readString(input, position, value) == false) {
+                return false;
+            }
+            item = new DataValue(value);
+            return true;
+        }
+        case INT_TRACE_ITEM:
+        {
+            uint64_t value = 0;
+            if(readNumber(input, position, value) == false) {
+                return false;
+            }
+            item = new DataValue(static_cast<long>(value));
+            return true;
+        }
+        case FLOAT_TRACE_ITEM:
+        {
+            uint64_t number = 0;
+            if(readNumber(input, position, number) == false) {
+                return false;
+            }
+            double value = 0.0;
+            memcpy(&value, &number, sizeof(double));
+            item = new DataValue(value);
+            return true;
+        }
+        case BOOL_TRACE_ITEM:
+        {
+            if(position >= input.size()) {
+                return false;
+            }
+            item = new DataValue(input[position] != 0);
+            position++;
+            return true;
+        }
+        case MAP_TRACE_ITEM:
+        {
+            uint64_t size = 0;
+            if(readNumber(input, position, size) == false) {
+                return false;
+            }
+
+            DataMap* map = new DataMap();
+            for(uint64_t i = 0; i < size; i++)
+            {
+                std::string key = "";
+                DataItem* value = nullptr;
+                if(readString(input, position, key) == false
+                        || deserializeItem(input, position, value) == false)
+                {
+                    delete map;
+                    return false;
+                }
+                map->insert(key, value);
+            }
+
+            item = map;
+            return true;
+        }
+        case ARRAY_TRACE_ITEM:
+        {
+            uint64_t size = 0;
+            if(readNumber(input, position, size) == false) {
+                return false;
+            }
+
+            DataArray* array = new DataArray();
+            for(uint64_t i = 0; i < size; i++)
+            {
+                DataItem* value = nullptr;
+                if(deserializeItem(input, position, value) == false)
+                {
+                    delete array;
+                    return false;
+                }
+                array->append(value);
+            }
+
+            item = array;
+            return true;
+        }
+        default:
+            break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief create the key to identify the calls of a blossom with a specific input
+ *
+ * @param blossomLeaf blossom-leaf of the call
+ * @param serializedInput serialized input of the call
+ *
+ * @return key of the call
+ */
+const std::string
+BlossomTrace::createKey(const BlossomLeaf &blossomLeaf,
+                        const std::string &serializedInput)
+{
+    std::string key = "";
+    appendString(key, blossomLeaf.blossomGroupType);
+    appendString(key, blossomLeaf.blossomType);
+    appendString(key, blossomLeaf.blossomName);
+    key.append(serializedInput);
+
+    return key;
+}
+
+/**
+ * @brief append a number with a fixed size of 8 byte and little-endian byte-order
+ *
+ * @param output reference to the string, where the number should be appended
+ * @param number number to append
+ */
+void
+BlossomTrace::appendNumber(std::string &output, const uint64_t number)
+{
+    for(uint32_t i = 0; i < 8; i++) {
+        output.push_back(static_cast<char>((number >> (i * 8)) & 0xFF));
+    }
+}
+
+/**
+ * @brief append a string together with its length
+ *
+ * @param output reference to the string, where the value should be appended
+ * @param value string to append
+ */
+void
+BlossomTrace::appendString(std::string &output, const std::string &value)
+{
+    appendNumber(output, value.size());
+    output.append(value);
+}
+
+/**
+ * @brief read a number, which was written by appendNumber
+ *
+ * @param input string with the binary data
+ * @param position reference to the read-position, which is moved behind the number
+ * @param number reference for the resulting number
+ *
+ * @return false, if the input is too short, else true
+ */
+bool
+BlossomTrace::readNumber(const std::string &input,
+                         uint64_t &position,
+                         uint64_t &number)
+{
+    if(input.size() < 8
+            || position > input.size() - 8)
+    {
+        return false;
+    }
+
+    number = 0;
+    for(uint32_t i = 0; i < 8; i++)
+    {
+        const uint64_t byte = static_cast<uint8_t>(input[position + i]);
+        number |= byte << (i * 8);
+    }
+    position += 8;
+
+    return true;
+}
+
+/**
+ * @brief read a string, which was written by appendString
+ *
+ * @param input string with the binary data
+ * @param position reference to the read-position, which is moved behind the string
+ * @param value reference for the resulting string
+ *
+ * @return false, if the input is too short, else true
+ */
+bool
+BlossomTrace::readString(const std::string &input,
+                         uint64_t &position,
+                         std::string &value)
+{
+    uint64_t size = 0;
+    if(readNumber(input, position, size) == false
+            || size > input.size() - position)
+    {
+        return false;
+    }
+
+    value = input.substr(position, size);
+    position += size;
+
+    return true;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,125 @@
+/**
+ * @file        blossom_trace.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_BLOSSOM_TRACE_H
+#define KITSUNEMIMI_SAKURA_LANG_BLOSSOM_TRACE_H
+
+#include <string>
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+namespace Kitsunemimi
+{
+class DataItem;
+
+namespace Sakura
+{
+struct BlossomLeaf;
+
+/**
+ * @brief The BlossomTrace class records the inputs and results of all blossom-calls in a compact
+ *        binary log. The recorded calls are collected in a buffer, which is written into the
+ *        trace-file each time it reaches the flush-size, so long recordings don't grow in
+ *        memory. In replay-mode the recorded results are returned instead of processing the
+ *        blossoms, so a run can be repeated without the side-effects of the blossoms.
+ */
+class BlossomTrace
+{
+public:
+    enum TraceMode
+    {
+        NO_TRACE = 0,
+        RECORD_TRACE = 1,
+        REPLAY_TRACE = 2,
+    };
+
+    BlossomTrace(const uint64_t flushSize = 1024 * 1024);
+    ~BlossomTrace();
+
+    TraceMode getMode() const;
+
+    // record
+    bool startRecording(const std::string &filePath,
+                        std::string &errorMessage);
+    bool stopRecording(std::string &errorMessage);
+    void record(BlossomLeaf &blossomLeaf,
+                const std::string &serializedInput,
+                const bool success,
+                const std::string &errorMessage);
+
+    // replay
+    bool startReplay(const std::string &trace,
+                     std::string &errorMessage);
+    void stopReplay();
+    bool replay(BlossomLeaf &blossomLeaf,
+                bool &success,
+                std::string &errorMessage);
+
+    // serialization
+    static void serializeItem(std::string &output, DataItem* item);
+    static bool deserializeItem(const std::string &input,
+                                uint64_t &position,
+                                DataItem* &item);
+
+private:
+    struct TraceEntry
+    {
+        std::string serializedOutput = "";
+        std::string terminalOutput = "";
+        std::string errorMessage = "";
+        bool success = false;
+    };
+
+    std::atomic<int> m_mode;
+    std::mutex m_lock;
+
+    // record
+    std::ofstream m_file;
+    std::string m_buffer = "";
+    uint64_t m_flushSize = 0;
+    bool m_writeFailed = false;
+
+    // replay, the entries of each call are replayed in order of their recording
+    std::vector<TraceEntry> m_entries;
+    std::unordered_map<std::string, std::deque<uint64_t>> m_index;
+
+    void flushBuffer();
+    bool closeRecording();
+
+    static const std::string createKey(const BlossomLeaf &blossomLeaf,
+                                       const std::string &serializedInput);
+
+    static void appendNumber(std::string &output, const uint64_t number);
+    static void appendString(std::string &output, const std::string &value);
+    static bool readNumber(const std::string &input, uint64_t &position, uint64_t &number);
+    static bool readString(const std::string &input, uint64_t &position, std::string &value);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_BLOSSOM_TRACE_H
@@ -0,0 +1,213 @@
+/**
+ * @file        cpu_topology.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "cpu_topology.h"
+
+#include <thread>
+#include <fstream>
+#include <algorithm>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief read a file of the sysfs, which contains a list in the format of the cpu-lists
+ *
+ * @param ids reference for the resulting ids
+ * @param path path of the file
+ *
+ * @return false, if the file doesn't exist or is invalid, else true
+ */
+bool
+readSysfsList(std::vector<uint32_t> &ids,
+              const std::string &path)
+{
+    std::ifstream listFile(path);
+    if(listFile.is_open() == false) {
+        return false;
+    }
+
+    std::string list = "";
+    std::getline(listFile, list);
+
+    return parseCpuList(ids, list);
+}
+
+/**
+ * @brief get the cpu-threads of all numa-nodes of the host. If the numa-information are not
+ *        available, all cpu-threads are handled as part of a single node.
+ *
+ * @param nodes reference for the resulting list of nodes, which contain their cpu-ids
+ */
+void
+getNumaNodes(std::vector<std::vector<uint32_t>> &nodes)
+{
+    nodes.clear();
+
+    // the ids of the nodes don't have to be continuous, so the online-nodes are read first and
+    // then the cpu-list of each of these nodes
+    const std::string nodeDir = "/sys/devices/system/node";
+    std::vector<uint32_t> nodeIds;
+    if(readSysfsList(nodeIds, nodeDir + "/online"))
+    {
+        for(const uint32_t nodeId : nodeIds)
+        {
+            const std::string cpuListPath = nodeDir + "/node" + std::to_string(nodeId) + "/cpulist";
+            std::vector<uint32_t> cpuIds;
+            if(readSysfsList(cpuIds, cpuListPath)
+                    && cpuIds.size() > 0)
+            {
+                nodes.push_back(cpuIds);
+            }
+        }
+    }
+
+    // fallback, if no numa-information are available
+    if(nodes.size() == 0)
+    {
+        uint32_t numberOfCpus = std::thread::hardware_concurrency();
+        if(numberOfCpus == 0) {
+            numberOfCpus = 1;
+        }
+
+        std::vector<uint32_t> cpuIds;
+        for(uint32_t i = 0; i < numberOfCpus; i++) {
+            cpuIds.push_back(i);
+        }
+        nodes.push_back(cpuIds);
+    }
+}
+
+/**
+ * @brief create an ordered list of cpu-threads for pinning worker-threads. The list alternates
+ *        between the numa-nodes, so consecutive worker-threads are spread over all nodes.
+ *
+ * @param cpuSlots reference for the resulting list
+ * @param allowedCpuIds list of cpu-ids, which are allowed to use. If empty, all cpu-ids are
+ *                      allowed.
+ */
+void
+getCpuSlots(std::vector<CpuSlot> &cpuSlots,
+            const std::vector<uint32_t> &allowedCpuIds)
+{
+    cpuSlots.clear();
+
+    std::vector<std::vector<uint32_t>> nodes;
+    getNumaNodes(nodes);
+
+    // filter by the allowed cpu-ids
+    if(allowedCpuIds.size() > 0)
+    {
+        for(std::vector<uint32_t> &cpuIds : nodes)
+        {
+            std::vector<uint32_t> filtered;
+            for(const uint32_t cpuId : cpuIds)
+            {
+                if(std::find(allowedCpuIds.begin(), allowedCpuIds.end(), cpuId)
+                        != allowedCpuIds.end())
+                {
+                    filtered.push_back(cpuId);
+                }
+            }
+            cpuIds = filtered;
+        }
+    }
+
+    // interleave the nodes
+    bool found = true;
+    for(uint32_t pos = 0; found; pos++)
+    {
+        found = false;
+        for(uint32_t nodeId = 0; nodeId < nodes.size(); nodeId++)
+        {
+            if(pos < nodes.at(nodeId).size())
+            {
+                CpuSlot slot;
+                slot.cpuId = nodes.at(nodeId).at(pos);
+                slot.nodeId = nodeId;
+                cpuSlots.push_back(slot);
+                found = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief parse a cpu-list in the format of the linux-kernel (for example "0-3,8,10-11")
+ *
+ * @param cpuIds reference for the resulting cpu-ids
+ * @param cpuList string with the cpu-list
+ *
+ * @return false, if the string is invalid, else true
+ */
+bool
+parseCpuList(std::vector<uint32_t> &cpuIds,
+             const std::string &cpuList)
+{
+    cpuIds.clear();
+
+    uint64_t pos = 0;
+    while(pos < cpuList.size())
+    {
+        uint64_t end = cpuList.find(',', pos);
+        if(end == std::string::npos) {
+            end = cpuList.size();
+        }
+
+        const std::string part = cpuList.substr(pos, end - pos);
+        pos = end + 1;
+        if(part.size() == 0
+                || part == "\n")
+        {
+            continue;
+        }
+
+        try
+        {
+            const uint64_t rangePos = part.find('-');
+            if(rangePos == std::string::npos)
+            {
+                cpuIds.push_back(static_cast<uint32_t>(std::stoul(part)));
+            }
+            else
+            {
+                const uint32_t first = static_cast<uint32_t>(std::stoul(part.substr(0, rangePos)));
+                const uint32_t last = static_cast<uint32_t>(std::stoul(part.substr(rangePos + 1)));
+                for(uint32_t i = first; i <= last; i++) {
+                    cpuIds.push_back(i);
+                }
+            }
+        }
+        catch(const std::exception &)
+        {
+            cpuIds.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,56 @@
+/**
+ * @file        cpu_topology.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_CPU_TOPOLOGY_H
+#define KITSUNEMIMI_SAKURA_LANG_CPU_TOPOLOGY_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief The CpuSlot struct describes a single cpu-thread together with the numa-node, where it
+ *        belongs to
+ */
+struct CpuSlot
+{
+    uint32_t cpuId = 0;
+    uint32_t nodeId = 0;
+};
+
+void getNumaNodes(std::vector<std::vector<uint32_t>> &nodes);
+void getCpuSlots(std::vector<CpuSlot> &cpuSlots,
+                 const std::vector<uint32_t> &allowedCpuIds);
+bool readSysfsList(std::vector<uint32_t> &ids,
+                   const std::string &path);
+bool parseCpuList(std::vector<uint32_t> &cpuIds,
+                  const std::string &cpuList);
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_CPU_TOPOLOGY_H
@@ -0,0 +1,126 @@
+/**
+ * @file        loop_source.cpp
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "loop_source.h"
+
+#include <items/value_item_functions.h>
+
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief constructor to iterate over a range of numbers
+ *
+ * @param startPos first value of the counter
+ * @param endPos end of the range, which is not included anymore
+ */
+LoopSource::LoopSource(const uint64_t startPos,
+                       const uint64_t endPos)
+{
+    m_type = RANGE_SOURCE;
+    m_startPos = startPos;
+    if(endPos > startPos) {
+        m_size = endPos - startPos;
+    }
+}
+
+/**
+ * @brief constructor to iterate over all entries of an array
+ *
+ * @param array array-item, which must exist as long as the loop-source is used
+ */
+LoopSource::LoopSource(DataArray* array)
+{
+    m_type = ARRAY_SOURCE;
+    m_array = array;
+    m_size = array->size();
+}
+
+/**
+ * @brief constructor to iterate over the parts of a string, which is splitted by a delimiter
+ *
+ * @param content string, which should be splitted. It is not copied, so it must exist as long
+ *                as the loop-source is used.
+ * @param delimiter not empty delimiter with already resolved escape-sequences
+ */
+LoopSource::LoopSource(const std::string &content,
+                       const std::string &delimiter)
+{
+    m_type = SPLIT_SOURCE;
+    m_content = &content;
+    m_delimiter = delimiter;
+    m_size = countSplitParts(*m_content, m_delimiter);
+}
+
+/**
+ * @brief get the number of iterations
+ *
+ * @return number of values, which are provided by the source
+ */
+uint64_t
+LoopSource::size() const
+{
+    return m_size;
+}
+
+/**
+ * @brief get the value for the next iteration
+ *
+ * @return new data-item, which is owned by the caller, or nullptr, if all values were already
+ *         provided
+ */
+DataItem*
+LoopSource::next()
+{
+    if(m_counter >= m_size) {
+        return nullptr;
+    }
+
+    DataItem* result = nullptr;
+    switch(m_type)
+    {
+        case RANGE_SOURCE:
+            result = new DataValue(static_cast<long>(m_startPos + m_counter));
+            break;
+        case ARRAY_SOURCE:
+            result = m_array->get(m_counter)->copy();
+            break;
+        case SPLIT_SOURCE:
+        {
+            std::string part;
+            getNextSplitPart(part, *m_content, m_delimiter, m_contentPos);
+            result = new DataValue(part);
+            break;
+        }
+    }
+
+    m_counter++;
+
+    return result;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
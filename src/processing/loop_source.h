@@ -0,0 +1,81 @@
+/**
+ * @file        loop_source.h
+ *
+ * @author      Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright   Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef KITSUNEMIMI_SAKURA_LANG_LOOP_SOURCE_H
+#define KITSUNEMIMI_SAKURA_LANG_LOOP_SOURCE_H
+
+#include <string>
+#include <stdint.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class DataArray;
+
+namespace Sakura
+{
+
+/**
+ * @brief The LoopSource class provides the values of the counter-variable of a loop one after
+ *        another. It iterates over a range, over an existing array or directly over the parts
+ *        of a splitted string, without creating an array with all parts before.
+ */
+class LoopSource
+{
+public:
+    LoopSource(const uint64_t startPos,
+               const uint64_t endPos);
+    LoopSource(DataArray* array);
+    LoopSource(const std::string &content,
+               const std::string &delimiter);
+
+    uint64_t size() const;
+    DataItem* next();
+
+private:
+    enum SourceType
+    {
+        RANGE_SOURCE = 0,
+        ARRAY_SOURCE = 1,
+        SPLIT_SOURCE = 2,
+    };
+
+    SourceType m_type = RANGE_SOURCE;
+    uint64_t m_size = 0;
+    uint64_t m_counter = 0;
+
+    // range
+    uint64_t m_startPos = 0;
+
+    // array
+    DataArray* m_array = nullptr;
+
+    // splitted string
+    const std::string* m_content = nullptr;
+    std::string m_delimiter = "";
+    uint64_t m_contentPos = 0;
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // KITSUNEMIMI_SAKURA_LANG_LOOP_SOURCE_H
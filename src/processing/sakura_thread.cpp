@@ -23,10 +23,15 @@
 #include "sakura_thread.h"
 
 #include <items/item_methods.h>
+#include <items/value_item_functions.h>
 #include <sakura_garden.h>
 
 #include <processing/subtree_queue.h>
 #include <processing/thread_pool.h>
+#include <processing/loop_source.h>
+#include <processing/blossom_trace.h>
+#include <processing/blossom_cache.h>
+#include <optimizer/dependency_analysis.h>
 
 #include <libKitsunemimiSakuraLang/blossom.h>
 #include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
@@ -43,11 +48,48 @@ namespace Sakura
 /**
  * @brief constructor
  *
- * @param queue pointer to the subtree-queue, where new separated subtrees should be added
+ * @param queue pointer to the queue, where the thread takes its subtrees from
+ * @param threadPool pointer to the pool, which contains this thread
+ * @param threadId id of the thread within the pool
  */
-SakuraThread::SakuraThread(SakuraLangInterface* interface)
+SakuraThread::SakuraThread(SubtreeQueue* queue,
+                           ThreadPool* threadPool,
+                           const uint32_t threadId)
 {
-    m_interface = interface;
+    m_queue = queue;
+    m_threadPool = threadPool;
+    m_threadId = threadId;
+}
+
+/**
+ * @brief pin the thread to the cpu-thread, which is assigned by the pool, or restore the
+ *        original affinity, if pinning is disabled
+ */
+void
+SakuraThread::updateCpuPinning()
+{
+    m_pinningVersion = m_threadPool->getPinningVersion();
+
+    CpuSlot cpuSlot;
+    if(m_threadPool->getCpuAssignment(m_threadId, cpuSlot))
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(cpuSlot.cpuId, &cpuSet);
+        if(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0)
+        {
+            LOG_WARNING("failed to pin thread " + std::to_string(m_threadId)
+                        + " to cpu " + std::to_string(cpuSlot.cpuId));
+            return;
+        }
+
+        SubtreeQueue::setLocalNode(cpuSlot.nodeId);
+    }
+    else
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &m_originalAffinity);
+        SubtreeQueue::setLocalNode(0);
+    }
 }
 
 /**
@@ -58,34 +100,26 @@ void
 SakuraThread::run()
 {
     m_started = true;
+    SubtreeQueue::setLocalWorker(this);
+
+    // save the affinity, which is restored when pinning is disabled again
+    CPU_ZERO(&m_originalAffinity);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &m_originalAffinity);
+
     while(m_abort == false)
     {
-        m_currentSubtree = m_interface->m_queue->getSubtreeObject();
+        if(m_pinningVersion != m_threadPool->getPinningVersion()) {
+            updateCpuPinning();
+        }
+
+        m_currentSubtree = m_queue->getSubtreeObject();
 
         if(m_currentSubtree != nullptr)
         {
-            if(m_currentSubtree->subtree != nullptr)
-            {
-                // process input-values
-                m_hierarchy = m_currentSubtree->hirarchy;
-                overrideItems(m_parentValues, m_currentSubtree->subtree->values, ALL);
-                overrideItems(m_parentValues, m_currentSubtree->items, ALL);
-
-                // run the real task
-                std::string errorMessage = "";
-                const bool result = processSakuraItem(m_currentSubtree->subtree,
-                                                      m_currentSubtree->filePath,
-                                                      errorMessage);
-                // handle result
-                if(result) {
-                    overrideItems(m_currentSubtree->items, m_parentValues, ONLY_EXISTING);
-                } else {
-                    m_currentSubtree->activeCounter->registerError(errorMessage);
-                }
-
-                // increase active-counter as last step, so the source subtree can check, if all
-                // spawned subtrees are finished
-                m_currentSubtree->activeCounter->increaseCounter();
+            if(m_currentSubtree->subtree != nullptr) {
+                processSubtreeObject();
+            } else if(m_currentSubtree->task) {
+                processTaskObject(m_currentSubtree);
             }
         }
         else
@@ -96,6 +130,113 @@ SakuraThread::run()
     }
 }
 
+/**
+ * @brief process a subtree-object, which was taken from the queue by a waiting thread. The state
+ *        of the waiting subtree is restored afterwards, so the thread can continue it.
+ *
+ * @param object subtree-object, which should be processed
+ */
+void
+SakuraThread::processWhileWaiting(SubtreeQueue::SubtreeObject* object)
+{
+    // backup the state of the waiting subtree by moving it instead of copying it
+    SubtreeQueue::SubtreeObject* waitingSubtree = m_currentSubtree;
+    SakuraLangInterface* waitingInterface = m_interface;
+    DataMap parentBackup;
+    std::swap(parentBackup.m_map, m_parentValues.m_map);
+    std::set<std::string> writtenBackup;
+    std::swap(writtenBackup, m_writtenItems);
+    std::vector<std::string> hierarchyBackup;
+    std::swap(hierarchyBackup, m_hierarchy);
+
+    m_currentSubtree = object;
+    if(m_currentSubtree->subtree != nullptr) {
+        processSubtreeObject();
+    } else if(m_currentSubtree->task) {
+        processTaskObject(m_currentSubtree);
+    }
+
+    // restore the state of the waiting subtree
+    std::swap(parentBackup.m_map, m_parentValues.m_map);
+    std::swap(writtenBackup, m_writtenItems);
+    std::swap(hierarchyBackup, m_hierarchy);
+    m_currentSubtree = waitingSubtree;
+    m_interface = waitingInterface;
+}
+
+/**
+ * @brief process an object, which contains a task instead of a subtree
+ *
+ * @param object object with the task, which should be processed
+ */
+void
+SakuraThread::processTaskObject(SubtreeQueue::SubtreeObject* object)
+{
+    object->task();
+
+    // increase active-counter as last step, so the source can check, if all tasks are finished
+    object->activeCounter->increaseCounter();
+}
+
+/**
+ * @brief process the current subtree-object and write its results back into the object
+ */
+void
+SakuraThread::processSubtreeObject()
+{
+    // the pool can be shared by multiple interfaces, so the interface is taken from
+    // the context of the run
+    m_interface = m_currentSubtree->runContext->interface;
+
+    // process input-values
+    m_hierarchy = m_currentSubtree->hirarchy;
+    overrideItems(m_parentValues, m_currentSubtree->subtree->values, ALL);
+    overrideItems(m_parentValues, m_currentSubtree->items, ALL);
+
+    // run the real task
+    std::string errorMessage = "";
+    const bool result = processSakuraItem(m_currentSubtree->subtree,
+                                          m_currentSubtree->filePath,
+                                          errorMessage);
+    // handle result
+    if(result)
+    {
+        // reduce the contribution of this subtree to a partial result, which is combined with
+        // the partial results of the other subtrees afterwards
+        if(m_currentSubtree->reductions != nullptr)
+        {
+            initReduceValues(m_currentSubtree->reduceValues, *m_currentSubtree->reductions);
+            if(reduceIteration(*m_currentSubtree->reductions,
+                               m_currentSubtree->reduceValues,
+                               errorMessage) == false)
+            {
+                m_currentSubtree->activeCounter->registerError(errorMessage);
+            }
+        }
+
+        // take the written values last, because the reductions still read them
+        if(m_currentSubtree->trackChanges) {
+            collectChangedItems(m_currentSubtree->changedItems, m_parentValues, m_writtenItems);
+        }
+
+        // the values are not used by the thread anymore, so they can be moved
+        moveExistingItems(m_currentSubtree->items, m_parentValues);
+    }
+    else
+    {
+        m_currentSubtree->activeCounter->registerError(errorMessage);
+    }
+
+    // values of this subtree must not be visible for the next one and are not kept
+    // until the thread gets its next subtree
+    m_parentValues.clear();
+    m_writtenItems.clear();
+
+    // increase active-counter as last step, so the source subtree can check, if all
+    // spawned subtrees are finished
+    m_currentSubtree->activeCounter->increaseCounter();
+}
+
 /**
  * @brief central method of the thread to process the current part of the execution-tree
  *
@@ -120,7 +261,18 @@ SakuraThread::processSakuraItem(SakuraItem* sakuraItem,
     if(sakuraItem->getType() == SakuraItem::SEQUENTIELL_ITEM)
     {
         SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(sakuraItem);
-        return processSequeniellPart(sequential, filePath, errorMessage);
+        if(sequential->values.m_valueMap.size() == 0) {
+            return processSequeniellPart(sequential, filePath, errorMessage);
+        }
+
+        // values of a sequential part, like the counter-variable of an unrolled loop, are only
+        // visible within the part
+        const std::vector<std::string> parentKeys = m_parentValues.getKeys();
+        registerWrites(sequential->values, false);
+        overrideItems(m_parentValues, sequential->values, ALL);
+        const bool result = processSequeniellPart(sequential, filePath, errorMessage);
+        removeAdditionalItems(m_parentValues, parentKeys);
+        return result;
     }
     //----------------------------------------------------------------------------------------------
     if(sakuraItem->getType() == SakuraItem::TREE_ITEM)
@@ -195,6 +347,58 @@ bool
 SakuraThread::processBlossom(BlossomItem &blossomItem,
                              const std::string &filePath,
                              std::string &errorMessage)
+{
+    Blossom* blossom = nullptr;
+    BlossomLeaf blossomLeaf;
+    if(prepareBlossom(blossomItem, filePath, blossom, blossomLeaf, errorMessage) == false) {
+        return false;
+    }
+
+    // results of pure blossoms are cached, but not while the calls are recorded or replayed
+    bool ret = false;
+    std::string cacheKey = "";
+    if(blossom->isPure
+            && m_interface->m_trace->getMode() == BlossomTrace::NO_TRACE)
+    {
+        cacheKey = BlossomCache::createKey(blossomLeaf);
+        ret = m_interface->m_blossomCache->get(cacheKey, blossomLeaf);
+    }
+
+    // process blossom
+    if(ret == false)
+    {
+        ret = blossom->growBlossom(blossomLeaf, errorMessage, m_interface->m_trace);
+        if(ret
+                && cacheKey.size() > 0)
+        {
+            m_interface->m_blossomCache->add(cacheKey, blossomLeaf);
+        }
+    }
+
+    if(ret == false) {
+        return false;
+    }
+
+    return finishBlossom(blossomItem, blossomLeaf, filePath, errorMessage);
+}
+
+/**
+ * @brief fill the values of a blossom and create the blossom-leaf for its processing
+ *
+ * @param blossomItem item with all information for the blossom
+ * @param filePath of the current file
+ * @param blossom reference for the requested blossom
+ * @param blossomLeaf reference to the blossom-leaf, which should be filled
+ * @param errorMessage reference for error-message
+ *
+ * @return true if successful, else false
+ */
+bool
+SakuraThread::prepareBlossom(BlossomItem &blossomItem,
+                             const std::string &filePath,
+                             Blossom* &blossom,
+                             BlossomLeaf &blossomLeaf,
+                             std::string &errorMessage)
 {
     // only debug-output
     LOG_DEBUG("process blossom:");
@@ -213,9 +417,9 @@ SakuraThread::processBlossom(BlossomItem &blossomItem,
 
     LOG_DEBUG("    values:\n" + blossomItem.values.toString());
 
-    // get and prcess the requested blossom
-    Blossom* blossom = m_interface->getBlossom(blossomItem.blossomGroupType,
-                                               blossomItem.blossomType);
+    // get the requested blossom
+    blossom = m_interface->getBlossom(blossomItem.blossomGroupType,
+                                      blossomItem.blossomType);
     if(blossom == nullptr)
     {
         errorMessage = createError(blossomItem,
@@ -225,30 +429,60 @@ SakuraThread::processBlossom(BlossomItem &blossomItem,
         return false;
     }
 
-    BlossomLeaf blossomLeaf;
-
     // update blossom-leaf for processing
+    blossomLeaf.blossomType = blossomItem.blossomType;
+    blossomLeaf.blossomGroupType = blossomItem.blossomGroupType;
+    blossomLeaf.blossomName = blossomItem.blossomName;
     blossomLeaf.blossomPath = filePath;
     blossomLeaf.nameHirarchie = m_hierarchy;
-    blossomLeaf.parentValues = &m_parentValues;
     blossomLeaf.nameHirarchie.push_back("BLOSSOM: " + blossomItem.blossomName);
 
-    convertValueMap(blossomLeaf.input, blossomItem.values);
-
-    // process blossom
-    const bool ret = blossom->growBlossom(blossomLeaf, errorMessage);
-    if(ret == false) {
-        return false;
+    // the results of pure blossoms are cached only by their input, so they don't get the
+    // parent-values, which could change their result
+    if(blossom->isPure == false) {
+        blossomLeaf.parentValues = &m_parentValues;
     }
 
+    // the filled values are only moved into the blossom-leaf, so large inputs are not copied
+    moveValueMap(blossomLeaf.input, blossomItem.values);
+
+    return true;
+}
+
+/**
+ * @brief print the result of a successful processed blossom and write its outputs back into
+ *        the parent-values. The inputs were moved into the blossom-leaf, so only the outputs
+ *        of the blossom-item are used here.
+ *
+ * @param blossomItem item with all information for the blossom
+ * @param blossomLeaf processed blossom-leaf
+ * @param filePath of the current file
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if an output of the blossom is missing, else true
+ */
+bool
+SakuraThread::finishBlossom(BlossomItem &blossomItem,
+                            BlossomLeaf &blossomLeaf,
+                            const std::string &filePath,
+                            std::string &errorMessage)
+{
     // send result to root
     m_interface->printOutput(blossomLeaf);
 
-    // write processing result back to parent
-    fillOutputValueItemMap(blossomItem.values, blossomLeaf.output);
+    // write only the outputs of the processing back to parent
+    if(fillOutputValueItemMap(blossomItem.values, blossomLeaf.output, errorMessage) == false)
+    {
+        errorMessage = createError(blossomItem,
+                                   filePath,
+                                   "processing",
+                                   "error while writing back the blossom output:\n    "
+                                   + errorMessage);
+        return false;
+    }
 
-    // TODO: override only with the output-values to avoid unnecessary conflicts
-    overrideItems(m_parentValues, blossomItem.values, ONLY_EXISTING);
+    registerWrites(blossomItem.values, true);
+    moveOutputItems(m_parentValues, blossomItem.values);
 
     return true;
 }
@@ -267,27 +501,10 @@ SakuraThread::processBlossomGroup(BlossomGroupItem &blossomGroupItem,
                                   const std::string &filePath,
                                   std::string &errorMessage)
 {
-    // convert name as jinja2-string
-    std::string convertResult = "";
-    Jinja2::Jinja2Converter* converter = Jinja2::Jinja2Converter::getInstance();
-    const bool ret = converter->convert(convertResult,
-                                        blossomGroupItem.id,
-                                        &m_parentValues,
-                                        errorMessage);
-    if(ret == false)
-    {
-        errorMessage = createError("jinja2-converter", errorMessage);
+    if(prepareBlossomGroup(blossomGroupItem, errorMessage) == false) {
         return false;
     }
 
-    LOG_DEBUG("process blossom group: " + convertResult);
-
-    // print blossom-group
-    blossomGroupItem.id = convertResult;
-    blossomGroupItem.nameHirarchie = m_hierarchy;
-    blossomGroupItem.nameHirarchie.push_back("BLOSSOM-GROUP: " + blossomGroupItem.id);
-    m_interface->printOutput(blossomGroupItem);
-
     // iterate over all blossoms of the group and process one after another
     for(BlossomItem* blossomItem : blossomGroupItem.blossoms)
     {
@@ -306,16 +523,7 @@ SakuraThread::processBlossomGroup(BlossomGroupItem &blossomGroupItem,
             return ret;
         }
 
-        // update blossom-item with group-values for console-output
-        blossomItem->blossomGroupType = blossomGroupItem.blossomGroupType;
-        blossomItem->blossomName = blossomGroupItem.id;
-        blossomItem->blossomGroupType = blossomGroupItem.blossomGroupType;
-
-        // copy values of the blossom-group into the blossom, but only values, which are not defined
-        // which in the blossom
-        overrideItems(blossomItem->values,
-                      blossomGroupItem.values,
-                      ONLY_NON_EXISTING);
+        updateBlossomItem(*blossomItem, blossomGroupItem);
 
         if(processBlossom(*blossomItem, filePath, errorMessage) == false) {
             return false;
@@ -325,6 +533,63 @@ SakuraThread::processBlossomGroup(BlossomGroupItem &blossomGroupItem,
     return true;
 }
 
+/**
+ * @brief convert the name of a blossom-group and print the group
+ *
+ * @param blossomGroupItem object, which should be processed
+ * @param errorMessage reference for error-message
+ *
+ * @return true if successful, else false
+ */
+bool
+SakuraThread::prepareBlossomGroup(BlossomGroupItem &blossomGroupItem,
+                                  std::string &errorMessage)
+{
+    // convert name as jinja2-string
+    std::string convertResult = "";
+    Jinja2::Jinja2Converter* converter = Jinja2::Jinja2Converter::getInstance();
+    const bool ret = converter->convert(convertResult,
+                                        blossomGroupItem.id,
+                                        &m_parentValues,
+                                        errorMessage);
+    if(ret == false)
+    {
+        errorMessage = createError("jinja2-converter", errorMessage);
+        return false;
+    }
+
+    LOG_DEBUG("process blossom group: " + convertResult);
+
+    // print blossom-group
+    blossomGroupItem.id = convertResult;
+    blossomGroupItem.nameHirarchie = m_hierarchy;
+    blossomGroupItem.nameHirarchie.push_back("BLOSSOM-GROUP: " + blossomGroupItem.id);
+    m_interface->printOutput(blossomGroupItem);
+
+    return true;
+}
+
+/**
+ * @brief update a blossom-item with the information of its blossom-group
+ *
+ * @param blossomItem blossom-item to update
+ * @param blossomGroupItem group of the blossom-item
+ */
+void
+SakuraThread::updateBlossomItem(BlossomItem &blossomItem,
+                                BlossomGroupItem &blossomGroupItem)
+{
+    // update blossom-item with group-values for console-output
+    blossomItem.blossomGroupType = blossomGroupItem.blossomGroupType;
+    blossomItem.blossomName = blossomGroupItem.id;
+
+    // copy values of the blossom-group into the blossom, but only values, which are not defined
+    // which in the blossom
+    overrideItems(blossomItem.values,
+                  blossomGroupItem.values,
+                  ONLY_NON_EXISTING);
+}
+
 /**
  * @brief process a new tree
  *
@@ -375,15 +640,13 @@ SakuraThread::processSubtree(SubtreeItem* subtreeItem,
                              const std::string &filePath,
                              std::string &errorMessage)
 {
-    // get sakura-file based on the required path
-    Kitsunemimi::Sakura::SakuraGarden* garden = m_interface->m_garden;
-    const bfs::path relPath = garden->getRelativePath(filePath, subtreeItem->nameOrPath);
-
-    // get and check tree
-    TreeItem* newSubtree = garden->getTree(relPath.string());
+    // get and check tree by the id, which was already resolved while parsing
+    TreeItem* newSubtree = m_interface->m_garden->getTree(subtreeItem->resolvedId);
     if(newSubtree == nullptr)
     {
-        errorMessage = createError("subtree-processing",
+        errorMessage = createError(*subtreeItem,
+                                   filePath,
+                                   "subtree-processing",
                                    "subtree doesn't exist: " + subtreeItem->nameOrPath);
         return false;
     }
@@ -415,12 +678,13 @@ SakuraThread::processIf(IfBranching* ifCondition,
 {
     // initialize
     bool ifMatch = false;
-    ValueItem valueItem;
 
     // get left side of the comparism
     if(fillValueItem(ifCondition->leftSide, m_parentValues, errorMessage) == false)
     {
-        errorMessage = createError("subtree-processing",
+        errorMessage = createError(*ifCondition,
+                                   filePath,
+                                   "subtree-processing",
                                    "error processing if-condition:\n"
                                    + errorMessage);
         return false;
@@ -429,33 +693,27 @@ SakuraThread::processIf(IfBranching* ifCondition,
     // get right side of the comparism
     if(fillValueItem(ifCondition->rightSide, m_parentValues, errorMessage) == false)
     {
-        errorMessage = createError("subtree-processing",
+        errorMessage = createError(*ifCondition,
+                                   filePath,
+                                   "subtree-processing",
                                    "error processing if-condition:\n"
                                    + errorMessage);
         return false;
     }
 
-    // convert values into strings
-    const std::string leftSide = ifCondition->leftSide.item->toString();
-    const std::string rightSide = ifCondition->rightSide.item->toString();
-
     // compare based on the compare-type
-    switch(ifCondition->ifType)
+    if(compareItems(ifMatch,
+                    ifCondition->leftSide.item,
+                    ifCondition->rightSide.item,
+                    ifCondition->ifType,
+                    errorMessage) == false)
     {
-        case IfBranching::EQUAL:
-            {
-                ifMatch = leftSide == rightSide;
-                break;
-            }
-        case IfBranching::UNEQUAL:
-            {
-                ifMatch = leftSide != rightSide;
-                break;
-            }
-        default:
-            // not implemented
-            assert(false);
-            break;
+        errorMessage = createError(*ifCondition,
+                                   filePath,
+                                   "subtree-processing",
+                                   "error processing if-condition:\n"
+                                   + errorMessage);
+        return false;
     }
 
     // based on the result, process the if-subtree or the else-subtree
@@ -480,16 +738,84 @@ SakuraThread::processForEach(ForEachBranching* forEachItem,
                              const std::string &filePath,
                              std::string &errorMessage)
 {
+    // a split-function at the end of the array-definition is not processed, because the loop
+    // can iterate directly over the parts of the string without creating all of them before
+    ValueItem arrayItem = forEachItem->iterateArray.getValueItem("array");
+    FunctionItem splitFunction;
+    const bool lazySplit = arrayItem.functions.size() > 0
+                           && arrayItem.functions.back().type == "split"
+                           && arrayItem.functions.back().arguments.size() == 1;
+    if(lazySplit)
+    {
+        splitFunction = arrayItem.functions.back();
+        arrayItem.functions.pop_back();
+    }
+
     // initialize the array, over twhich the loop should iterate
-    if(fillInputValueItemMap(forEachItem->iterateArray, m_parentValues, errorMessage) == false)
+    if(fillValueItem(arrayItem, m_parentValues, errorMessage) == false)
     {
-        errorMessage = createError("subtree-processing",
+        errorMessage = createError(*forEachItem,
+                                   filePath,
+                                   "subtree-processing",
                                    "error processing for-loop:\n"
                                    + errorMessage);
         return false;
     }
 
-    DataArray* array = forEachItem->iterateArray.get("array")->toArray();
+    LoopSource* source = nullptr;
+    std::string content = "";
+    if(lazySplit)
+    {
+        if(arrayItem.item->isStringValue() == false)
+        {
+            errorMessage = createError(*forEachItem,
+                                       filePath,
+                                       "subtree-processing",
+                                       "error processing for-loop:\n"
+                                       "item, which should be splitted, is not a string");
+            return false;
+        }
+
+        ValueItem delimiter = splitFunction.arguments.at(0);
+        if(fillValueItem(delimiter, m_parentValues, errorMessage) == false)
+        {
+            errorMessage = createError(*forEachItem,
+                                       filePath,
+                                       "subtree-processing",
+                                       "error processing for-loop:\n"
+                                       + errorMessage);
+            return false;
+        }
+
+        const std::string delimiterString = resolveDelimiter(delimiter.item->toString());
+        if(delimiterString.size() == 0)
+        {
+            errorMessage = createError(*forEachItem,
+                                       filePath,
+                                       "subtree-processing",
+                                       "error processing for-loop:\n"
+                                       "delimiter for split-function is empty");
+            return false;
+        }
+
+        // the source only references the content, so it must exist until the loop is finished
+        content = arrayItem.item->toValue()->getString();
+        source = new LoopSource(content, delimiterString);
+    }
+    else
+    {
+        if(arrayItem.item->isArray() == false)
+        {
+            errorMessage = createError(*forEachItem,
+                                       filePath,
+                                       "subtree-processing",
+                                       "error processing for-loop:\n"
+                                       "item to iterate over is not an array");
+            return false;
+        }
+
+        source = new LoopSource(arrayItem.item->toArray());
+    }
 
     // process content normal or parallel via worker-threads
     bool result = false;
@@ -497,25 +823,28 @@ SakuraThread::processForEach(ForEachBranching* forEachItem,
     {
         result = runLoop(forEachItem->content,
                          forEachItem->values,
+                         forEachItem->reductions,
                          filePath,
                          forEachItem->tempVarName,
-                         array,
-                         errorMessage,
-                         array->size());
+                         *source,
+                         errorMessage);
     }
     else
     {
-        result = m_interface->m_queue->spawnParallelSubtreesLoop(forEachItem->content,
-                                                                 forEachItem->values,
-                                                                 filePath,
-                                                                 m_hierarchy,
-                                                                 m_parentValues,
-                                                                 forEachItem->tempVarName,
-                                                                 array,
-                                                                 errorMessage,
-                                                                 array->size());
+        result = m_queue->spawnParallelSubtreesLoop(m_currentSubtree->runContext,
+                                                    forEachItem->content,
+                                                    forEachItem->values,
+                                                    forEachItem->reductions,
+                                                    filePath,
+                                                    m_hierarchy,
+                                                    m_parentValues,
+                                                    forEachItem->tempVarName,
+                                                    *source,
+                                                    errorMessage);
     }
 
+    delete source;
+
     return result;
 }
 
@@ -536,7 +865,9 @@ SakuraThread::processFor(ForBranching* forItem,
     // get start-value
     if(fillValueItem(forItem->start, m_parentValues, errorMessage) == false)
     {
-        errorMessage = createError("subtree-processing",
+        errorMessage = createError(*forItem,
+                                   filePath,
+                                   "subtree-processing",
                                    "error processing for-loop:\n"
                                    + errorMessage);
         return false;
@@ -545,7 +876,9 @@ SakuraThread::processFor(ForBranching* forItem,
     // get end-value
     if(fillValueItem(forItem->end, m_parentValues, errorMessage) == false)
     {
-        errorMessage = createError("subtree-processing",
+        errorMessage = createError(*forItem,
+                                   filePath,
+                                   "subtree-processing",
                                    "error processing for-loop:\n"
                                    + errorMessage);
         return false;
@@ -556,30 +889,30 @@ SakuraThread::processFor(ForBranching* forItem,
     const uint64_t endValue = static_cast<uint64_t>(forItem->end.item->toValue()->getLong());
 
     // process content normal or parallel via worker-threads
+    LoopSource source(startValue, endValue);
     bool result = false;
     if(forItem->parallel == false)
     {
         result = runLoop(forItem->content,
                          forItem->values,
+                         forItem->reductions,
                          filePath,
                          forItem->tempVarName,
-                         nullptr,
-                         errorMessage,
-                         endValue,
-                         startValue);
+                         source,
+                         errorMessage);
     }
     else
     {
-        result = m_interface->m_queue->spawnParallelSubtreesLoop(forItem->content,
-                                                                 forItem->values,
-                                                                 filePath,
-                                                                 m_hierarchy,
-                                                                 m_parentValues,
-                                                                 forItem->tempVarName,
-                                                                 nullptr,
-                                                                 errorMessage,
-                                                                 endValue,
-                                                                 startValue);
+        result = m_queue->spawnParallelSubtreesLoop(m_currentSubtree->runContext,
+                                                    forItem->content,
+                                                    forItem->values,
+                                                    forItem->reductions,
+                                                    filePath,
+                                                    m_hierarchy,
+                                                    m_parentValues,
+                                                    forItem->tempVarName,
+                                                    source,
+                                                    errorMessage);
     }
 
     return result;
@@ -599,6 +932,48 @@ SakuraThread::processSequeniellPart(SequentiellPart* subtree,
                                     const std::string &filePath,
                                     std::string &errorMessage)
 {
+    // process levels of independent items in parallel, if enabled and useful
+    if(m_interface->m_autoParallelization
+            && subtree->dependencyLevels.size() > 0
+            && subtree->dependencyLevels.size() < subtree->childs.size())
+    {
+        for(const std::vector<uint64_t> &level : subtree->dependencyLevels)
+        {
+            if(level.size() == 1)
+            {
+                if(processSakuraItem(subtree->childs.at(level.at(0)),
+                                     filePath,
+                                     errorMessage) == false)
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            std::vector<SakuraItem*> levelItems;
+            for(const uint64_t pos : level) {
+                levelItems.push_back(subtree->childs.at(pos));
+            }
+
+            DataMap resultingItems;
+            if(m_queue->spawnParallelSubtrees(m_currentSubtree->runContext,
+                                              resultingItems,
+                                              levelItems,
+                                              ValueItemMap(),
+                                              filePath,
+                                              m_hierarchy,
+                                              m_parentValues,
+                                              errorMessage) == false)
+            {
+                return false;
+            }
+            registerWrites(resultingItems);
+            moveItems(m_parentValues, resultingItems);
+        }
+
+        return true;
+    }
+
     for(SakuraItem* item : subtree->childs)
     {
         if(processSakuraItem(item, filePath, errorMessage) == false) {
@@ -626,15 +1001,23 @@ SakuraThread::processParallelPart(ParallelPart* parallelPart,
     SequentiellPart* parts = dynamic_cast<SequentiellPart*>(parallelPart->childs);
 
     DataMap resultingItems;
-    const bool result = m_interface->m_queue->spawnParallelSubtrees(resultingItems,
-                                                                    parts->childs,
-                                                                    filePath,
-                                                                    m_hierarchy,
-                                                                    m_parentValues,
-                                                                    errorMessage,
-                                                                    parts->childs.size());
+    const bool result = m_queue->spawnParallelSubtrees(m_currentSubtree->runContext,
+                                                       resultingItems,
+                                                       parts->childs,
+                                                       parallelPart->reductions,
+                                                       filePath,
+                                                       m_hierarchy,
+                                                       m_parentValues,
+                                                       errorMessage);
+    if(result == false) {
+        return false;
+    }
 
-    return result;
+    // write the changed values and the results of the reductions back
+    registerWrites(resultingItems);
+    moveItems(m_parentValues, resultingItems);
+
+    return true;
 }
 
 /**
@@ -663,26 +1046,39 @@ SakuraThread::runSubtreeCall(SakuraItem* newSubtree,
         return false;
     }
 
-    // backup and reset parent
-    DataMap parentBackup = m_parentValues;
-    m_parentValues.clear();
+    // backup and reset parent by moving its items instead of copying them. Writes within the
+    // called subtree are only internal and not tracked for the parent.
+    DataMap parentBackup;
+    std::swap(parentBackup.m_map, m_parentValues.m_map);
+    std::set<std::string> writtenBackup;
+    std::swap(writtenBackup, m_writtenItems);
 
     // set values
     overrideItems(newSubtree->values, values, ALL);
     overrideItems(m_parentValues, newSubtree->values, ALL);
 
-    // process tree-item
-    if(processSakuraItem(newSubtree, filePath, errorMessage) == false) {
-        return false;
+    // process tree-item and collect its output
+    bool result = processSakuraItem(newSubtree, filePath, errorMessage);
+    if(result
+            && fillOutputValueItemMap(newSubtree->values, m_parentValues, errorMessage) == false)
+    {
+        errorMessage = createError("subtree-processing",
+                                   "error while writing back the subtree output:\n"
+                                   + errorMessage);
+        result = false;
     }
 
-    // write output back after restoring the parent-values to resume normally
-    if(fillOutputValueItemMap(newSubtree->values, m_parentValues) == false) {
+    // restore the parent-values on every path, so the caller sees its own scope again also in
+    // case of an error. The internal values of the subtree are deleted together with the
+    // backup-object
+    std::swap(parentBackup.m_map, m_parentValues.m_map);
+    std::swap(writtenBackup, m_writtenItems);
+    if(result == false) {
         return false;
     }
 
     // write values back
-    m_parentValues = parentBackup;
+    registerWrites(newSubtree->values, false);
     overrideItems(m_parentValues, newSubtree->values, ONLY_EXISTING);
 
     return true;
@@ -693,55 +1089,347 @@ SakuraThread::runSubtreeCall(SakuraItem* newSubtree,
  *
  * @param loopContent content of the loop, which should be executed multiple times
  * @param values input-values
+ * @param reductions reduce-values of the loop
  * @param filePath of the current file
  * @param tempVarName temporary variable name for usage within the loop to forward the object
  *                    over which is generated of the counter-variable
- * @param array nullptr if iterate over a range or pointer to array-item to iterate over this array
+ * @param source source of the values of the counter-variable
  * @param errorMessage reference for error-message
- * @param endPos start-position in the array or of the counter
- * @param startPos start-position in the array or of the counter
  *
  * @return true, if check successful, else false
  */
 bool
 SakuraThread::runLoop(SakuraItem* loopContent,
                       const ValueItemMap &values,
+                      const ValueItemMap &reductions,
                       const std::string &filePath,
                       const std::string &tempVarName,
-                      DataArray* array,
-                      std::string &errorMessage,
-                      const uint64_t endPos,
-                      const uint64_t startPos)
+                      LoopSource &source,
+                      std::string &errorMessage)
 {
-    // backup the parent-values to avoid permanent merging with loop-internal values
-    DataMap preBalueBackup = m_parentValues;
+    // remember the keys of the parent-values to remove the loop-internal values afterwards
+    const std::vector<std::string> parentKeys = m_parentValues.getKeys();
+    registerWrites(values, false);
+    registerWrite(tempVarName);
     overrideItems(m_parentValues, values, ALL);
 
-    for(uint64_t i = startPos; i < endPos; i++)
+    DataMap reduceResult;
+    initReduceValues(reduceResult, reductions);
+
+    // independent iterations, which only call a blossom with batch-support, are processed in
+    // batches
+    Blossom* batchBlossom = getBatchBlossom(loopContent, reductions, tempVarName);
+    if(batchBlossom != nullptr)
     {
-        // add the counter-variable as new value to be accessable within the loop
-        if(array != nullptr) {
-            m_parentValues.insert(tempVarName, array->get(i)->copy(), true);
-        } else {
-            m_parentValues.insert(tempVarName, new DataValue(static_cast<long>(i)), true);
+        if(runBatchLoop(loopContent,
+                        batchBlossom,
+                        reductions,
+                        reduceResult,
+                        filePath,
+                        tempVarName,
+                        source,
+                        errorMessage) == false)
+        {
+            return false;
         }
+    }
+    else
+    {
+        for(DataItem* loopValue = source.next();
+            loopValue != nullptr;
+            loopValue = source.next())
+        {
+            // add the counter-variable as new value to be accessable within the loop
+            m_parentValues.insert(tempVarName, loopValue, true);
 
-        // process content
-        SakuraItem* tempItem = loopContent->copy();
-        if(processSakuraItem(tempItem, filePath, errorMessage) == false) {
-            return false;
+            // process content
+            SakuraItem* tempItem = loopContent->copy();
+            const bool result = processSakuraItem(tempItem, filePath, errorMessage);
+            delete tempItem;
+            if(result == false) {
+                return false;
+            }
+
+            if(reduceIteration(reductions, reduceResult, errorMessage) == false) {
+                return false;
+            }
         }
-        delete tempItem;
     }
 
-    // restore the old parent values and update only the existing values with the one form the
-    // loop. That way, variables like the counter-variable are not added to the parent.
-    DataMap postBalueBackup = m_parentValues;
-    m_parentValues = preBalueBackup;
-    overrideItems(m_parentValues, postBalueBackup, ONLY_EXISTING);
+    // remove all values, which didn't exist before the loop, but keep the updated values of
+    // the existing ones. That way, variables like the counter-variable are not added to the
+    // parent.
+    removeAdditionalItems(m_parentValues, parentKeys);
+    registerWrites(reduceResult);
+    moveItems(m_parentValues, reduceResult);
 
     return true;
 }
 
+/**
+ * @brief merge the contribution of the current iteration of a loop or of a parallel subtree
+ *        directly into the reductions
+ *
+ * @param reductions reduce-values of the loop
+ * @param reduceResult reference to the current results of the reductions
+ * @param errorMessage reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+SakuraThread::reduceIteration(const ValueItemMap &reductions,
+                              DataMap &reduceResult,
+                              std::string &errorMessage)
+{
+    DataMap contribution;
+    if(collectReduceValues(contribution, reductions, m_parentValues, errorMessage) == false
+            || mergeReduceValues(reduceResult, reductions, contribution, errorMessage) == false)
+    {
+        errorMessage = createError("subtree-processing",
+                                   "error processing reduction of for-loop:\n"
+                                   + errorMessage);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief check if the iterations of a sequential loop can be processed in batches. This is the
+ *        case, if the content of the loop is a single blossom with batch-support and no
+ *        iteration reads a value, which is written by the blossom.
+ *
+ * @param loopContent content of the loop
+ * @param reductions reduce-values of the loop
+ * @param tempVarName name of the counter-variable of the loop
+ *
+ * @return blossom with batch-support, if the loop can be batched, else nullptr
+ */
+Blossom*
+SakuraThread::getBatchBlossom(SakuraItem* loopContent,
+                              const ValueItemMap &reductions,
+                              const std::string &tempVarName)
+{
+    // the trace records and replays single calls
+    if(m_interface->m_batchSize < 2
+            || m_interface->m_trace->getMode() != BlossomTrace::NO_TRACE
+            || loopContent->getType() != SakuraItem::SEQUENTIELL_ITEM)
+    {
+        return nullptr;
+    }
+
+    SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(loopContent);
+    if(sequential->childs.size() != 1
+            || sequential->childs.at(0)->getType() != SakuraItem::BLOSSOM_GROUP_ITEM)
+    {
+        return nullptr;
+    }
+
+    BlossomGroupItem* blossomGroupItem = dynamic_cast<BlossomGroupItem*>(sequential->childs.at(0));
+    if(blossomGroupItem->blossoms.size() != 1) {
+        return nullptr;
+    }
+
+    Blossom* blossom = m_interface->getBlossom(blossomGroupItem->blossomGroupType,
+                                               blossomGroupItem->blossoms.at(0)->blossomType);
+    if(blossom == nullptr
+            || blossom->supportsBatch == false)
+    {
+        return nullptr;
+    }
+
+    // the iterations are independent, if none of them reads an output of another one. The blossom
+    // doesn't have to be pure, because it processes the whole batch by itself.
+    AccessSet accessSet;
+    collectAccess(accessSet, blossomGroupItem, m_interface->m_garden);
+    if(accessSet.barrier) {
+        return nullptr;
+    }
+
+    for(const std::string &name : accessSet.writes)
+    {
+        if(name == tempVarName
+                || accessSet.reads.find(name) != accessSet.reads.end())
+        {
+            return nullptr;
+        }
+    }
+
+    // the reductions are collected after the whole batch, where the counter-variable has
+    // already the value of the last iteration of the batch
+    std::set<std::string> reductionReads;
+    collectReads(reductionReads, reductions);
+    if(reductionReads.find(tempVarName) != reductionReads.end()) {
+        return nullptr;
+    }
+
+    return blossom;
+}
+
+/**
+ * @brief run a sequential loop, whose iterations only call a single blossom, in batches. The
+ *        inputs of all iterations of a batch are filled before the blossom processes the whole
+ *        batch at once. Afterwards the outputs and reductions are handled in the order of the
+ *        iterations, so the result is the same like processing the iterations one by one.
+ *
+ * @param loopContent content of the loop, which should be executed multiple times
+ * @param blossom blossom with batch-support, which is called by the loop
+ * @param reductions reduce-values of the loop
+ * @param reduceResult reference to the results of the reductions
+ * @param filePath of the current file
+ * @param tempVarName name of the counter-variable of the loop
+ * @param source source of the values of the counter-variable
+ * @param errorMessage reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+SakuraThread::runBatchLoop(SakuraItem* loopContent,
+                           Blossom* blossom,
+                           const ValueItemMap &reductions,
+                           DataMap &reduceResult,
+                           const std::string &filePath,
+                           const std::string &tempVarName,
+                           LoopSource &source,
+                           std::string &errorMessage)
+{
+    const uint32_t batchSize = m_interface->m_batchSize;
+    bool result = true;
+
+    // the blossom-leafs are not moved, when the vectors have the full size from the beginning
+    std::vector<SakuraItem*> tempItems;
+    std::vector<BlossomLeaf> blossomLeafs;
+    tempItems.reserve(batchSize);
+    blossomLeafs.reserve(batchSize);
+
+    DataItem* loopValue = source.next();
+    while(loopValue != nullptr
+          && result)
+    {
+        // fill the inputs of all iterations of the next batch
+        while(loopValue != nullptr
+              && tempItems.size() < batchSize)
+        {
+            // add the counter-variable as new value to be accessable within the loop
+            m_parentValues.insert(tempVarName, loopValue, true);
+
+            SakuraItem* tempItem = loopContent->copy();
+            tempItems.push_back(tempItem);
+            blossomLeafs.emplace_back();
+
+            SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(tempItem);
+            BlossomGroupItem* groupItem = dynamic_cast<BlossomGroupItem*>(sequential->childs.at(0));
+            BlossomItem* blossomItem = groupItem->blossoms.at(0);
+
+            Blossom* preparedBlossom = nullptr;
+            if(prepareBlossomGroup(*groupItem, errorMessage) == false)
+            {
+                result = false;
+                break;
+            }
+
+            updateBlossomItem(*blossomItem, *groupItem);
+            if(prepareBlossom(*blossomItem,
+                              filePath,
+                              preparedBlossom,
+                              blossomLeafs.back(),
+                              errorMessage) == false)
+            {
+                result = false;
+                break;
+            }
+
+            // the parent-values are changed by the following iterations of the batch, before
+            // the blossom is processed, so they are not given to batched calls
+            blossomLeafs.back().parentValues = nullptr;
+
+            loopValue = source.next();
+        }
+
+        // process the whole batch
+        if(result) {
+            result = blossom->growBlossomBatch(blossomLeafs, errorMessage);
+        }
+
+        // write the results back in the order of the iterations
+        for(uint64_t i = 0; i < tempItems.size(); i++)
+        {
+            if(result)
+            {
+                SequentiellPart* sequential = dynamic_cast<SequentiellPart*>(tempItems.at(i));
+                BlossomGroupItem* groupItem =
+                        dynamic_cast<BlossomGroupItem*>(sequential->childs.at(0));
+                BlossomItem* blossomItem = groupItem->blossoms.at(0);
+
+                result = finishBlossom(*blossomItem, blossomLeafs[i], filePath, errorMessage);
+                if(result) {
+                    result = reduceIteration(reductions, reduceResult, errorMessage);
+                }
+            }
+
+            delete tempItems.at(i);
+        }
+
+        tempItems.clear();
+        blossomLeafs.clear();
+    }
+
+    return result;
+}
+
+/**
+ * @brief register a write to the parent-values, so it is returned to the parent of a parallel
+ *        part, even if the new value is equal to the old one
+ *
+ * @param key name of the written value
+ */
+void
+SakuraThread::registerWrite(const std::string &key)
+{
+    if(m_currentSubtree->trackChanges) {
+        m_writtenItems.insert(key);
+    }
+}
+
+/**
+ * @brief register writes of all values of a data-map to the parent-values
+ *
+ * @param items data-map with the written values
+ */
+void
+SakuraThread::registerWrites(const DataMap &items)
+{
+    std::map<std::string, DataItem*>::const_iterator it;
+    for(it = items.m_map.begin();
+        it != items.m_map.end();
+        it++)
+    {
+        registerWrite(it->first);
+    }
+}
+
+/**
+ * @brief register writes of the values of a value-item-map to the parent-values
+ *
+ * @param items value-item-map with the written values
+ * @param onlyOutputs true to register only the output-values of the map
+ */
+void
+SakuraThread::registerWrites(const ValueItemMap &items,
+                             const bool onlyOutputs)
+{
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = items.m_valueMap.begin();
+        it != items.m_valueMap.end();
+        it++)
+    {
+        if(onlyOutputs == false
+                || it->second.type == ValueItem::OUTPUT_PAIR_TYPE)
+        {
+            registerWrite(it->first);
+        }
+    }
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
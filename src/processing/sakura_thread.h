@@ -24,8 +24,10 @@
 #define KITSUNEMIMI_SAKURA_LANG_THREAD_H
 
 #include <thread>
+#include <set>
 #include <string>
 #include <vector>
+#include <pthread.h>
 
 #include <processing/subtree_queue.h>
 #include <items/sakura_items.h>
@@ -38,22 +40,41 @@ namespace Kitsunemimi
 namespace Sakura
 {
 class SakuraLangInterface;
+class ThreadPool;
+class Blossom;
+struct BlossomLeaf;
 
 class SakuraThread
         : public Kitsunemimi::Thread
 {
 public:
-    SakuraThread(SakuraLangInterface* interface);
+    SakuraThread(SubtreeQueue* queue,
+                 ThreadPool* threadPool,
+                 const uint32_t threadId);
+
+    void processWhileWaiting(SubtreeQueue::SubtreeObject* object);
+    static void processTaskObject(SubtreeQueue::SubtreeObject* object);
 
 private:
     bool m_started = false;
-    SakuraLangInterface* m_interface;
+    SakuraLangInterface* m_interface = nullptr;
+    SubtreeQueue* m_queue;
+    ThreadPool* m_threadPool;
+    uint32_t m_threadId = 0;
+
+    // cpu-pinning
+    uint64_t m_pinningVersion = 0;
+    cpu_set_t m_originalAffinity;
+
+    void updateCpuPinning();
     SubtreeQueue::SubtreeObject* m_currentSubtree = nullptr;
 
     DataMap m_parentValues;
+    std::set<std::string> m_writtenItems;
     std::vector<std::string> m_hierarchy;
 
     void run();
+    void processSubtreeObject();
 
     bool processSakuraItem(SakuraItem* sakuraItem,
                            const std::string &filePath,
@@ -62,9 +83,22 @@ private:
     bool processBlossom(BlossomItem &blossomItem,
                         const std::string &filePath,
                         std::string &errorMessage);
+    bool prepareBlossom(BlossomItem &blossomItem,
+                        const std::string &filePath,
+                        Blossom* &blossom,
+                        BlossomLeaf &blossomLeaf,
+                        std::string &errorMessage);
+    bool finishBlossom(BlossomItem &blossomItem,
+                       BlossomLeaf &blossomLeaf,
+                       const std::string &filePath,
+                       std::string &errorMessage);
     bool processBlossomGroup(BlossomGroupItem &blossomGroupItem,
                              const std::string &filePath,
                              std::string &errorMessage);
+    bool prepareBlossomGroup(BlossomGroupItem &blossomGroupItem,
+                             std::string &errorMessage);
+    void updateBlossomItem(BlossomItem &blossomItem,
+                           BlossomGroupItem &blossomGroupItem);
     bool processTree(TreeItem* treeItem,
                      std::string &errorMessage);
     bool processSubtree(SubtreeItem* subtreeItem,
@@ -92,12 +126,30 @@ private:
                         std::string &errorMessage);
     bool runLoop(SakuraItem* loopContent,
                  const ValueItemMap &values,
+                 const ValueItemMap &reductions,
                  const std::string &filePath,
                  const std::string &tempVarName,
-                 DataArray* array,
-                 std::string &errorMessage,
-                 const uint64_t endPos,
-                 const uint64_t startPos = 0);
+                 LoopSource &source,
+                 std::string &errorMessage);
+    Blossom* getBatchBlossom(SakuraItem* loopContent,
+                             const ValueItemMap &reductions,
+                             const std::string &tempVarName);
+    bool runBatchLoop(SakuraItem* loopContent,
+                      Blossom* blossom,
+                      const ValueItemMap &reductions,
+                      DataMap &reduceResult,
+                      const std::string &filePath,
+                      const std::string &tempVarName,
+                      LoopSource &source,
+                      std::string &errorMessage);
+    bool reduceIteration(const ValueItemMap &reductions,
+                         DataMap &reduceResult,
+                         std::string &errorMessage);
+
+    void registerWrite(const std::string &key);
+    void registerWrites(const DataMap &items);
+    void registerWrites(const ValueItemMap &items,
+                        const bool onlyOutputs);
 };
 
 } // namespace Sakura
@@ -22,6 +22,7 @@
 
 #include "subtree_queue.h"
 
+#include <processing/sakura_thread.h>
 #include <items/item_methods.h>
 
 #include <libKitsunemimiPersistence/logger/logger.h>
@@ -31,87 +32,223 @@ namespace Kitsunemimi
 namespace Sakura
 {
 
+// numa-node of the current thread, which is set by the worker-threads, if they are pinned
+thread_local uint32_t t_localNode = 0;
+
+// worker-thread of the current thread, which is set by the worker-threads, so a waiting worker
+// can process queued subtrees by itself
+thread_local SakuraThread* t_localWorker = nullptr;
+
+// base-value for the increase of the pass of a run, which is divided by the weight of the
+// priority-class of the run
+#define STRIDE_BASE 1048576
+
+// minimum number of pairs of partial results, which are combined in parallel by the
+// worker-threads. Smaller merges are done by the waiting thread, because the combination of two
+// partial results is cheaper than the scheduling of a task.
+#define MIN_PARALLEL_MERGES 4
+
+/**
+ * @brief get the weight of a priority-class for the scheduling
+ *
+ * @param priority priority-class
+ *
+ * @return weight of the class
+ */
+uint64_t
+getPriorityWeight(const SakuraLangInterface::RunPriority priority)
+{
+    switch(priority)
+    {
+        case SakuraLangInterface::INTERACTIVE_PRIORITY:
+            return 8;
+        case SakuraLangInterface::NORMAL_PRIORITY:
+            return 4;
+        case SakuraLangInterface::BATCH_PRIORITY:
+            return 1;
+    }
+
+    return 1;
+}
+
 /**
  * @brief constructor
+ *
+ * @param numberOfNodes number of numa-nodes, which get their own queue
+ */
+SubtreeQueue::SubtreeQueue(const uint32_t numberOfNodes)
+{
+    m_size = 0;
+    m_nextRunId = 1;
+
+    for(uint32_t i = 0; i < numberOfNodes || i == 0; i++) {
+        m_nodeQueues.push_back(new NodeQueue());
+    }
+}
+
+/**
+ * @brief destructor
+ */
+SubtreeQueue::~SubtreeQueue()
+{
+    for(NodeQueue* nodeQueue : m_nodeQueues) {
+        delete nodeQueue;
+    }
+}
+
+/**
+ * @brief set the numa-node of the current thread
+ *
+ * @param nodeId id of the numa-node
+ */
+void
+SubtreeQueue::setLocalNode(const uint32_t nodeId)
+{
+    t_localNode = nodeId;
+}
+
+/**
+ * @brief set the worker-thread of the current thread
+ *
+ * @param worker worker-thread, which runs in the current thread
  */
-SubtreeQueue::SubtreeQueue() {}
+void
+SubtreeQueue::setLocalWorker(SakuraThread* worker)
+{
+    t_localWorker = worker;
+}
 
 /**
- * @brief add a new subtree-object to the queue
+ * @brief create a new unique id for a run
+ *
+ * @return new run-id
+ */
+uint64_t
+SubtreeQueue::createRunId()
+{
+    return m_nextRunId.fetch_add(1);
+}
+
+/**
+ * @brief add a new subtree-object to the queue of the numa-node of the current thread
  *
  * @param newObject the new subtree-object, which should be added to the queue
  */
 void
 SubtreeQueue::addSubtreeObject(SubtreeObject* newObject)
 {
-    m_lock.lock();
-    m_queue.push(newObject);
-    m_lock.unlock();
+    NodeQueue* nodeQueue = m_nodeQueues.at(t_localNode % m_nodeQueues.size());
+    const RunContext* context = newObject->runContext;
+    newObject->queuedAt = chronoClock::now();
+
+    nodeQueue->lock.lock();
+
+    // a run, which has no waiting objects, starts at the current virtual time of the node, so
+    // it can not claim the time, where it had nothing to do
+    std::map<uint64_t, RunQueue>::iterator it = nodeQueue->runQueues.find(context->runId);
+    if(it == nodeQueue->runQueues.end())
+    {
+        RunQueue runQueue;
+        runQueue.pass = nodeQueue->virtualTime;
+        runQueue.stride = STRIDE_BASE / getPriorityWeight(context->priority);
+        it = nodeQueue->runQueues.insert(std::make_pair(context->runId, runQueue)).first;
+    }
+    it->second.objects.push(newObject);
+    m_size++;
+
+    nodeQueue->lock.unlock();
+
+    m_metricsLock.lock();
+    m_metrics[context->priority].queuedSubtrees++;
+    m_metricsLock.unlock();
+}
+
+/**
+ * @brief get the number of objects, which are waiting in the queue
+ *
+ * @return number of objects in all node-queues
+ */
+uint64_t
+SubtreeQueue::size() const
+{
+    return m_size;
 }
 
 /**
  * @brief run a parallel loop
  *
+ * @param runContext context of the run, where the subtrees belong to
  * @param subtree subtree, which should be executed multiple times by multiple threads
  * @param postProcessing post-aggregation information
+ * @param reductions reduce-values of the loop
  * @param filePath path of the file, where the subtree belongs to
  * @param hierarchy actual hierarchy for terminal output
  * @param parentValues data-map with parent-values
  * @param tempVarName loop-internal variable
- * @param array data-array in case of an iterator-loop, else false
+ * @param source source of the values of the loop-internal variable
  * @param errorMessage reference for error-message
- * @param endPos end position in array or counter end
- * @param startPos start position in array or counter start
  *
  * @return true, if successful, else false
  */
 bool
-SubtreeQueue::spawnParallelSubtreesLoop(SakuraItem* subtree,
+SubtreeQueue::spawnParallelSubtreesLoop(RunContext* runContext,
+                                        SakuraItem* subtree,
                                         ValueItemMap postProcessing,
+                                        const ValueItemMap &reductions,
                                         const std::string &filePath,
                                         const std::vector<std::string> &hierarchy,
                                         DataMap &parentValues,
                                         const std::string &tempVarName,
-                                        DataArray* array,
-                                        std::string &errorMessage,
-                                        uint64_t endPos,
-                                        const uint64_t startPos)
+                                        LoopSource &source,
+                                        std::string &errorMessage)
 {
     // create and initialize one counter-instance for all new subtrees
     ActiveCounter* activeCounter = new ActiveCounter();
-    activeCounter->shouldCount = static_cast<uint32_t>(endPos - startPos);
+    activeCounter->shouldCount = static_cast<uint32_t>(source.size());
     std::vector<SubtreeObject*> spawnedObjects;
 
-    for(uint64_t i = startPos; i < endPos; i++)
+    for(DataItem* loopValue = source.next();
+        loopValue != nullptr;
+        loopValue = source.next())
     {
         // encapsulate the content of the loop together with the values and the counter-object
         // as an subtree-object and add it to the subtree-queue
         SubtreeObject* object = new SubtreeObject();
+        object->runContext = runContext;
         object->subtree = subtree->copy();
         object->items = parentValues;
         object->hirarchy = hierarchy;
         object->activeCounter = activeCounter;
         object->filePath = filePath;
+        object->reductions = &reductions;
 
         // add the counter-variable as new value to be accessable within the loop
-        if(array != nullptr) {
-            object->items.insert(tempVarName, array->get(i)->copy(), true);
-        } else {
-            object->items.insert(tempVarName, new DataValue(static_cast<long>(i)), true);
-        }
+        object->items.insert(tempVarName, loopValue, true);
 
         addSubtreeObject(object);
         spawnedObjects.push_back(object);
     }
 
-    bool result = waitUntilFinish(activeCounter, errorMessage);
+    bool result = waitUntilFinish(activeCounter, runContext, errorMessage);
 
-    // post-processing and cleanup
-    for(uint64_t i = startPos; i < endPos; i++)
+    // merge the contributions of all iterations into the parent-values
+    if(result)
+    {
+        DataMap reduceResult;
+        result = reduceSpawnedObjects(runContext,
+                                      reduceResult,
+                                      reductions,
+                                      spawnedObjects,
+                                      errorMessage);
+        moveItems(parentValues, reduceResult);
+    }
+
+    // post-processing with the values of the last iteration
+    if(result
+            && spawnedObjects.size() > 0)
     {
-        std::string errorMessage = "";
         if(fillInputValueItemMap(postProcessing,
-                                 spawnedObjects.at(static_cast<uint32_t>(i))->items,
+                                 spawnedObjects.back()->items,
                                  errorMessage) == false)
         {
             errorMessage = createError("subtree-processing",
@@ -119,10 +256,12 @@ SubtreeQueue::spawnParallelSubtreesLoop(SakuraItem* subtree,
                                        + errorMessage);
             result = false;
         }
+        else
+        {
+            overrideItems(parentValues, postProcessing, ONLY_EXISTING);
+        }
     }
 
-    overrideItems(parentValues, postProcessing, ONLY_EXISTING);
-
     clearSpawnedObjects(spawnedObjects);
 
     return result;
@@ -131,56 +270,72 @@ SubtreeQueue::spawnParallelSubtreesLoop(SakuraItem* subtree,
 /**
  * @brief run multiple different subtrees in parallel threads
  *
- * @param resultingItems map for resulting items
+ * @param runContext context of the run, where the subtrees belong to
+ * @param resultingItems map for resulting items. It contains only the values, which were
+ *                       written or changed by the subtrees. If multiple subtrees wrote the same
+ *                       value, the subtree with the highest index wins. Additionally it
+ *                       contains the results of the reductions.
  * @param childs vector with subtrees, where each subtree should be executed by another thread
+ * @param reductions reduce-values over the results of all subtrees
  * @param filePath path of the file, where the subtree belongs to
  * @param hierarchy actual hierarchy for terminal output
  * @param parentValues data-map with parent-values
  * @param errorMessage reference for error-message
- * @param endPos end position in array or counter end
- * @param startPos start position in array or counter start
  *
  * @return true, if successful, else false
  */
 bool
-SubtreeQueue::spawnParallelSubtrees(DataMap &resultingItems,
+SubtreeQueue::spawnParallelSubtrees(RunContext* runContext,
+                                    DataMap &resultingItems,
                                     const std::vector<SakuraItem*> &childs,
+                                    const ValueItemMap &reductions,
                                     const std::string &filePath,
                                     const std::vector<std::string> &hierarchy,
                                     const DataMap &parentValues,
-                                    std::string &errorMessage,
-                                    const uint64_t endPos,
-                                    const uint64_t startPos)
+                                    std::string &errorMessage)
 {
     LOG_DEBUG("spawnParallelSubtrees");
 
-    // TODO: check that startPos and endPos are not outside of the childs
-
     // create and initialize all threads
     ActiveCounter* activeCounter = new ActiveCounter();
-    activeCounter->shouldCount = static_cast<uint32_t>(endPos - startPos);
+    activeCounter->shouldCount = static_cast<uint32_t>(childs.size());
     std::vector<SubtreeObject*> spawnedObjects;
 
     // encapsulate each subtree of the paralle part as subtree-object and add it to the
     // subtree-queue for parallel processing
-    for(uint64_t i = startPos; i < endPos; i++)
+    for(SakuraItem* child : childs)
     {
         SubtreeObject* object = new SubtreeObject();
-        object->subtree = childs.at(i)->copy();
+        object->runContext = runContext;
+        object->subtree = child->copy();
         object->hirarchy = hierarchy;
         object->items = parentValues;
         object->activeCounter = activeCounter;
         object->filePath = filePath;
+        object->reductions = &reductions;
+        object->trackChanges = true;
 
         addSubtreeObject(object);
         spawnedObjects.push_back(object);
     }
 
-    const bool ret = waitUntilFinish(activeCounter, errorMessage);
+    bool ret = waitUntilFinish(activeCounter, runContext, errorMessage);
 
     // write result back for output
-    if(spawnedObjects.size() == 1) {
-        overrideItems(resultingItems, spawnedObjects.at(0)->items, ALL);
+    if(ret)
+    {
+        // apply the changes ordered by the index of the subtrees, so the last writer wins
+        for(SubtreeObject* object : spawnedObjects) {
+            moveItems(resultingItems, object->changedItems);
+        }
+
+        DataMap reduceResult;
+        ret = reduceSpawnedObjects(runContext,
+                                   reduceResult,
+                                   reductions,
+                                   spawnedObjects,
+                                   errorMessage);
+        moveItems(resultingItems, reduceResult);
     }
 
     clearSpawnedObjects(spawnedObjects);
@@ -188,45 +343,188 @@ SubtreeQueue::spawnParallelSubtrees(DataMap &resultingItems,
     return ret;
 }
 
-
 /**
- * @brief getSubtreeObject take ta object from the queue and delete it from the queue
+ * @brief getSubtreeObject take ta object from the queue and delete it from the queue. The queue
+ *        of the numa-node of the current thread is checked first and only if this is empty, the
+ *        queues of the other nodes are checked.
+ *
+ * @param runId id of the run, from which the object should be taken, or 0 for any run
  *
  * @return first object in the queue or an empty-object, if nothing is in the queue
  */
 SubtreeQueue::SubtreeObject*
-SubtreeQueue::getSubtreeObject()
+SubtreeQueue::getSubtreeObject(const uint64_t runId)
 {
     SubtreeObject* subtree = nullptr;
 
-    m_lock.lock();
-    if(m_queue.empty() == false)
+    if(m_size == 0) {
+        return nullptr;
+    }
+
+    const uint64_t numberOfNodes = m_nodeQueues.size();
+    for(uint64_t i = 0; i < numberOfNodes; i++)
     {
-        subtree = m_queue.front();
-        m_queue.pop();
+        subtree = takeFromNode(m_nodeQueues.at((t_localNode + i) % numberOfNodes), runId);
+        if(subtree != nullptr)
+        {
+            updateMetrics(subtree);
+            return subtree;
+        }
     }
-    m_lock.unlock();
 
     return subtree;
 }
 
+/**
+ * @brief take the next object of the run with the lowest pass from the queue of a node
+ *
+ * @param nodeQueue queue of the node
+ * @param runId id of the run, from which the object should be taken, or 0 for any run
+ *
+ * @return taken object or nullptr, if the queue of the node is empty
+ */
+SubtreeQueue::SubtreeObject*
+SubtreeQueue::takeFromNode(NodeQueue* nodeQueue,
+                           const uint64_t runId)
+{
+    SubtreeObject* subtree = nullptr;
+
+    nodeQueue->lock.lock();
+
+    std::map<uint64_t, RunQueue>::iterator selected = nodeQueue->runQueues.end();
+    if(runId != 0)
+    {
+        selected = nodeQueue->runQueues.find(runId);
+    }
+    else
+    {
+        // get run with the lowest pass. In case of equal pass-values the older run is preferred
+        std::map<uint64_t, RunQueue>::iterator it;
+        for(it = nodeQueue->runQueues.begin();
+            it != nodeQueue->runQueues.end();
+            it++)
+        {
+            if(selected == nodeQueue->runQueues.end()
+                    || it->second.pass < selected->second.pass)
+            {
+                selected = it;
+            }
+        }
+    }
+
+    if(selected != nodeQueue->runQueues.end())
+    {
+        RunQueue* runQueue = &selected->second;
+        subtree = runQueue->objects.front();
+        runQueue->objects.pop();
+        m_size--;
+
+        nodeQueue->virtualTime = runQueue->pass;
+        runQueue->pass += runQueue->stride;
+        if(runQueue->objects.empty()) {
+            nodeQueue->runQueues.erase(selected);
+        }
+    }
+
+    nodeQueue->lock.unlock();
+
+    return subtree;
+}
+
+/**
+ * @brief update the metrics of the priority-class of a taken object
+ *
+ * @param object object, which was taken from the queue
+ */
+void
+SubtreeQueue::updateMetrics(SubtreeObject* object)
+{
+    const uint64_t waitTime = static_cast<uint64_t>(
+                std::chrono::duration_cast<chronoMicroSec>(
+                    chronoClock::now() - object->queuedAt).count());
+
+    m_metricsLock.lock();
+
+    PriorityMetrics* metrics = &m_metrics[object->runContext->priority];
+    metrics->processedSubtrees++;
+    metrics->totalWaitTime += waitTime;
+    if(waitTime > metrics->maxWaitTime) {
+        metrics->maxWaitTime = waitTime;
+    }
+
+    m_metricsLock.unlock();
+}
+
+/**
+ * @brief get the scheduling-metrics of all priority-classes
+ *
+ * @param result reference for the resulting map with one entry per priority-class
+ */
+void
+SubtreeQueue::getSchedulingMetrics(DataMap &result)
+{
+    const std::string names[3] = {"interactive", "normal", "batch"};
+
+    std::lock_guard<std::mutex> guard(m_metricsLock);
+
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        const PriorityMetrics* metrics = &m_metrics[i];
+        DataMap* classMetrics = new DataMap();
+
+        long averageWaitTime = 0;
+        if(metrics->processedSubtrees > 0)
+        {
+            averageWaitTime = static_cast<long>(metrics->totalWaitTime
+                                                / metrics->processedSubtrees);
+        }
+
+        const long waiting = static_cast<long>(metrics->queuedSubtrees
+                                               - metrics->processedSubtrees);
+        classMetrics->insert("processed_subtrees",
+                             new DataValue(static_cast<long>(metrics->processedSubtrees)));
+        classMetrics->insert("waiting_subtrees", new DataValue(waiting));
+        classMetrics->insert("average_wait_time_us", new DataValue(averageWaitTime));
+        classMetrics->insert("max_wait_time_us",
+                             new DataValue(static_cast<long>(metrics->maxWaitTime)));
+
+        result.insert(names[i], classMetrics, true);
+    }
+}
+
 
 
 /**
- * @brief wait until all spawned tasks are finished
+ * @brief wait until all spawned tasks are finished. If the waiting thread is a worker-thread, it
+ *        processes the queued subtrees of the same run by itself while waiting, so nested
+ *        parallel parts can not block all threads of the pool.
  *
  * @param activeCounter pointer to the active-counter, which was given each spawned thread
+ * @param runContext context of the run, where the spawned subtrees belong to
  * @param errorMessage reference for error-message
  *
  * @return true, if successful, else false
  */
 bool
 SubtreeQueue::waitUntilFinish(ActiveCounter* activeCounter,
+                              const RunContext* runContext,
                               std::string &errorMessage)
 {
     // wait until the created subtree was fully processed by the worker-threads
-    while(activeCounter->isEqual() == false) {
-        std::this_thread::sleep_for(chronoMilliSec(10));
+    while(activeCounter->isEqual() == false)
+    {
+        if(t_localWorker != nullptr)
+        {
+            SubtreeObject* object = getSubtreeObject(runContext->runId);
+            if(object != nullptr)
+            {
+                t_localWorker->processWhileWaiting(object);
+                continue;
+            }
+        }
+
+        // the counter wakes up the waiting thread, when the last spawned subtree has finished
+        activeCounter->waitUntilEqual(chronoMilliSec(1));
     }
 
     // in case of on error, forward this error to the upper layer
@@ -238,6 +536,96 @@ SubtreeQueue::waitUntilFinish(ActiveCounter* activeCounter,
     return result;
 }
 
+/**
+ * @brief combine the partial results of all spawned objects to the results of the reductions.
+ *        Neighbouring partial results are combined pairwise in rounds as tasks of the
+ *        worker-threads, so the depth of the merge only grows logarithmic with the number of
+ *        objects. The following partial result is always merged into the previous one, so the
+ *        result doesn't depend on the order in which the worker-threads have finished. When a
+ *        round has only a few pairs left, the remaining partial results are combined by the
+ *        waiting thread.
+ *
+ * @param runContext context of the run, where the spawned objects belong to
+ * @param result data-map for the results of the reductions
+ * @param reductions reduce-values
+ * @param spawnedObjects vector with all spawned and already finished queue-objects
+ * @param errorMessage reference for error-message
+ *
+ * @return true, if successful, else false
+ */
+bool
+SubtreeQueue::reduceSpawnedObjects(RunContext* runContext,
+                                   DataMap &result,
+                                   const ValueItemMap &reductions,
+                                   std::vector<SubtreeObject*> &spawnedObjects,
+                                   std::string &errorMessage)
+{
+    const uint64_t numberOfObjects = spawnedObjects.size();
+    uint64_t step = 1;
+
+    while(reductions.m_valueMap.size() > 0
+          && numberOfObjects > step)
+    {
+        // number of partial results at the positions 0, 2*step, 4*step, ..., which have a
+        // following partial result at the distance step
+        const uint64_t numberOfPairs = (numberOfObjects - step + 2 * step - 1) / (2 * step);
+        if(numberOfPairs < MIN_PARALLEL_MERGES) {
+            break;
+        }
+
+        ActiveCounter activeCounter;
+        activeCounter.shouldCount = static_cast<uint32_t>(numberOfPairs);
+        std::vector<SubtreeObject*> mergeTasks;
+
+        for(uint64_t i = 0; i + step < numberOfObjects; i += 2 * step)
+        {
+            DataMap* first = &spawnedObjects.at(i)->reduceValues;
+            DataMap* following = &spawnedObjects.at(i + step)->reduceValues;
+            ActiveCounter* counter = &activeCounter;
+
+            SubtreeObject* object = new SubtreeObject();
+            object->runContext = runContext;
+            object->activeCounter = counter;
+            object->task = [first, following, &reductions, counter]()
+            {
+                std::string taskError = "";
+                if(combineReduceValues(*first, reductions, *following, taskError) == false) {
+                    counter->registerError(taskError);
+                }
+            };
+
+            addSubtreeObject(object);
+            mergeTasks.push_back(object);
+        }
+
+        const bool ret = waitUntilFinish(&activeCounter, runContext, errorMessage);
+        for(SubtreeObject* object : mergeTasks) {
+            delete object;
+        }
+        if(ret == false) {
+            return false;
+        }
+
+        step *= 2;
+    }
+
+    // combine the remaining partial results
+    initReduceValues(result, reductions);
+    for(uint64_t i = 0; i < numberOfObjects; i += step)
+    {
+        if(combineReduceValues(result,
+                               reductions,
+                               spawnedObjects.at(i)->reduceValues,
+                               errorMessage) == false)
+        {
+            result.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /**
  * @brief free memory of all spawned objects
  *
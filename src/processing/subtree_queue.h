@@ -26,15 +26,23 @@
 #include <thread>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
 #include <queue>
+#include <map>
+#include <atomic>
+#include <functional>
 
 #include <items/sakura_items.h>
+#include <processing/loop_source.h>
+
+#include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
 
 namespace Kitsunemimi
 {
 namespace Sakura
 {
 class SakuraItem;
+class SakuraThread;
 
 typedef std::chrono::microseconds chronoMicroSec;
 typedef std::chrono::milliseconds chronoMilliSec;
@@ -46,7 +54,8 @@ typedef std::chrono::high_resolution_clock chronoClock;
 class SubtreeQueue
 {
 public:
-    SubtreeQueue();
+    SubtreeQueue(const uint32_t numberOfNodes = 1);
+    ~SubtreeQueue();
 
     /**
      * @brief The ActiveCounter struct is only a simple thread-save counter. This counter should be
@@ -58,6 +67,7 @@ public:
     struct ActiveCounter
     {
         std::mutex lock;
+        std::condition_variable condition;
         uint32_t isCounter = 0;
         uint32_t shouldCount = 0;
         bool success = true;
@@ -72,6 +82,7 @@ public:
         {
             lock.lock();
             isCounter++;
+            condition.notify_all();
             lock.unlock();
         }
 
@@ -89,6 +100,21 @@ public:
             return result;
         }
 
+        /**
+         * @brief wait until the counter has reached the expected value or the timeout is over
+         *
+         * @param timeout maximum time to wait
+         *
+         * @return true, if counter has reached the expected value, else false
+         */
+        bool waitUntilEqual(const std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            return condition.wait_for(guard,
+                                      timeout,
+                                      [this] { return isCounter == shouldCount; });
+        }
+
         /**
          * @brief register error in one of the spawned threads to inform the other threads
          *
@@ -103,6 +129,19 @@ public:
         }
     };
 
+    /**
+     * @brief The RunContext struct contains the information of a single triggered tree, which are
+     *        shared by all subtree-objects, which were spawned while processing this tree.
+     */
+    struct RunContext
+    {
+        // interface, which has started the processing and provides the garden and the blossoms
+        SakuraLangInterface* interface = nullptr;
+        // unique id of the run for the scheduling
+        uint64_t runId = 0;
+        SakuraLangInterface::RunPriority priority = SakuraLangInterface::NORMAL_PRIORITY;
+    };
+
     /**
      * @brief The SubtreeObject struct is basically a container to encapsulate a task. It contains
      *        all necessary information to process a subtree. These container are placed in the
@@ -110,6 +149,8 @@ public:
      */
     struct SubtreeObject
     {
+        // context of the run, where the subtree belongs to
+        RunContext* runContext = nullptr;
         // subtree, which should be processed by a worker-thread
         SakuraItem* subtree = nullptr;
         // map with all input-values for the subtree
@@ -120,39 +161,112 @@ public:
         std::vector<std::string> hirarchy;
 
         std::string filePath = "";
+
+        // reduce-values of the loop, which spawned the object and the partial result of the
+        // reductions over this object. The partial result is written only by the worker-thread,
+        // which processes the object, or by the merge-task, which owns it, so it doesn't need
+        // any lock.
+        const ValueItemMap* reductions = nullptr;
+        DataMap reduceValues;
+
+        // if true, the worker-thread collects all items, which were changed by the subtree, so
+        // the results of multiple parallel subtrees can be merged afterwards
+        bool trackChanges = false;
+        DataMap changedItems;
+
+        // timestamp, when the object was added to the queue
+        chronoTimePoint queuedAt;
+
+        // task, which is processed instead of a subtree, like the validation of a tree
+        std::function<void()> task;
     };
 
     void addSubtreeObject(SubtreeObject* newObject);
 
-    bool spawnParallelSubtrees(DataMap &resultingItems,
+    bool spawnParallelSubtrees(RunContext* runContext,
+                               DataMap &resultingItems,
                                const std::vector<SakuraItem *> &childs,
+                               const ValueItemMap &reductions,
                                const std::string &filePath,
                                const std::vector<std::string> &hierarchy,
                                const DataMap &parentValues,
-                               std::string &errorMessage,
-                               const uint64_t endPos = 1,
-                               const uint64_t startPos = 0);
-    bool spawnParallelSubtreesLoop(SakuraItem* subtree,
+                               std::string &errorMessage);
+    bool spawnParallelSubtreesLoop(RunContext* runContext,
+                                   SakuraItem* subtree,
                                    ValueItemMap postProcessing,
+                                   const ValueItemMap &reductions,
                                    const std::string &filePath,
                                    const std::vector<std::string> &hierarchy,
                                    DataMap &parentValues,
                                    const std::string &tempVarName,
-                                   DataArray* array,
-                                   std::string &errorMessage,
-                                   uint64_t endPos,
-                                   const uint64_t startPos = 0);
-
+                                   LoopSource &source,
+                                   std::string &errorMessage);
 
+    SubtreeObject* getSubtreeObject(const uint64_t runId = 0);
+    uint64_t size() const;
+    uint64_t createRunId();
+    void getSchedulingMetrics(DataMap &result);
 
-    SubtreeObject* getSubtreeObject();
+    static void setLocalNode(const uint32_t nodeId);
+    static void setLocalWorker(SakuraThread* worker);
 
 private:
-    std::mutex m_lock;
-    std::queue<SubtreeObject*> m_queue;
+    /**
+     * @brief The RunQueue struct contains all waiting subtree-objects of a single run. The pass
+     *        is the virtual time of the run, which increases with each taken object by a value,
+     *        which is smaller the higher the priority of the run is.
+     */
+    struct RunQueue
+    {
+        std::queue<SubtreeObject*> objects;
+        uint64_t pass = 0;
+        uint64_t stride = 1;
+    };
+
+    /**
+     * @brief The NodeQueue struct is the queue of a single numa-node. New objects are added to
+     *        the queue of the node of the spawning thread and worker-threads take objects from
+     *        the queue of their own node first, before they take objects from other nodes.
+     *        Within a node the runs are scheduled by their pass, so each run gets a share of the
+     *        threads based on its priority and a single huge run can not starve the others.
+     */
+    struct NodeQueue
+    {
+        std::mutex lock;
+        std::map<uint64_t, RunQueue> runQueues;
+        uint64_t virtualTime = 0;
+    };
+
+    /**
+     * @brief The PriorityMetrics struct contains the metrics of all runs of a priority-class
+     */
+    struct PriorityMetrics
+    {
+        uint64_t queuedSubtrees = 0;
+        uint64_t processedSubtrees = 0;
+        uint64_t totalWaitTime = 0;
+        uint64_t maxWaitTime = 0;
+    };
+
+    std::vector<NodeQueue*> m_nodeQueues;
+    std::atomic<uint64_t> m_size;
+    std::atomic<uint64_t> m_nextRunId;
+
+    std::mutex m_metricsLock;
+    PriorityMetrics m_metrics[3];
+
+    SubtreeObject* takeFromNode(NodeQueue* nodeQueue,
+                                const uint64_t runId);
+    void updateMetrics(SubtreeObject* object);
 
     bool waitUntilFinish(ActiveCounter* activeCounter,
+                         const RunContext* runContext,
                          std::string &errorMessage);
+    bool reduceSpawnedObjects(RunContext* runContext,
+                              DataMap &result,
+                              const ValueItemMap &reductions,
+                              std::vector<SubtreeObject*> &spawnedObjects,
+                              std::string &errorMessage);
     void clearSpawnedObjects(std::vector<SubtreeObject*> &spawnedObjects);
 };
 
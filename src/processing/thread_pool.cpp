@@ -29,21 +29,31 @@ namespace Kitsunemimi
 namespace Sakura
 {
 
+// number of scaling-cycles (10ms each) with waiting subtrees, before a new thread is added
+#define GROW_TICKS 3
+// number of scaling-cycles (10ms each) with an empty queue, before a thread is removed
+#define SHRINK_TICKS 100
+
 /**
  * @brief constructor
  *
  * @param numberOfThreads number of initial created threads for the pool
- * @param interface pointer to the interface-object to access the queue
+ * @param queue pointer to the queue, where the threads take their subtrees from
  */
 ThreadPool::ThreadPool(const uint32_t numberOfThreads,
-                       SakuraLangInterface* interface)
+                       SubtreeQueue* queue)
 {
-    for(uint32_t i = 0; i < numberOfThreads; i++)
-    {
-        SakuraThread* child = new SakuraThread(interface);
-        m_childThreads.push_back(child);
-        child->startThread();
+    m_queue = queue;
+    m_minThreads = numberOfThreads;
+    m_maxThreads = numberOfThreads;
+    m_pinningVersion = 0;
+
+    for(uint32_t i = 0; i < numberOfThreads; i++) {
+        addChildThread();
     }
+
+    // start thread to scale the pool based on the depth of the queue
+    startThread();
 }
 
 /**
@@ -51,9 +61,200 @@ ThreadPool::ThreadPool(const uint32_t numberOfThreads,
  */
 ThreadPool::~ThreadPool()
 {
+    stopThread();
     clearChildThreads();
 }
 
+/**
+ * @brief change the number of threads of the pool. If the minimum and the maximum differs, the
+ *        pool grows, when subtrees are waiting in the queue, and shrinks again, when the queue is
+ *        empty for a longer time.
+ *
+ * @param minThreads minimum number of threads
+ * @param maxThreads maximum number of threads
+ *
+ * @return false, if the values are invalid, else true
+ */
+bool
+ThreadPool::setNumberOfThreads(const uint32_t minThreads,
+                               const uint32_t maxThreads)
+{
+    // precheck
+    if(minThreads == 0
+            || maxThreads < minThreads)
+    {
+        return false;
+    }
+
+    std::vector<SakuraThread*> removedThreads;
+
+    m_lock.lock();
+
+    m_minThreads = minThreads;
+    m_maxThreads = maxThreads;
+    while(m_childThreads.size() < m_minThreads) {
+        addChildThread();
+    }
+    removeChildThreads(m_maxThreads, removedThreads);
+
+    m_lock.unlock();
+
+    // delete outside of the lock, because the threads finish their current subtree first
+    for(SakuraThread* thread : removedThreads) {
+        delete thread;
+    }
+
+    return true;
+}
+
+/**
+ * @brief get the current number of threads of the pool
+ *
+ * @return number of threads
+ */
+uint32_t
+ThreadPool::getNumberOfThreads()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    return static_cast<uint32_t>(m_childThreads.size());
+}
+
+/**
+ * @brief enable or disable the pinning of the threads to cpu-threads. The threads check the
+ *        pinning-version and update their affinity, before they take the next subtree.
+ *
+ * @param enable true to pin each thread to a single cpu-thread, false to remove the pinning
+ * @param cpuIds list of allowed cpu-ids. If empty, all cpu-threads of the host are used.
+ */
+void
+ThreadPool::setCpuPinning(const bool enable,
+                          const std::vector<uint32_t> &cpuIds)
+{
+    std::vector<CpuSlot> cpuSlots;
+    if(enable) {
+        getCpuSlots(cpuSlots, cpuIds);
+    }
+
+    m_lock.lock();
+    m_pinningEnabled = enable && cpuSlots.size() > 0;
+    m_cpuSlots = cpuSlots;
+    m_pinningVersion++;
+    m_lock.unlock();
+}
+
+/**
+ * @brief get the version of the pinning-configuration, which is increased with each change
+ *
+ * @return current pinning-version
+ */
+uint64_t
+ThreadPool::getPinningVersion() const
+{
+    return m_pinningVersion;
+}
+
+/**
+ * @brief get the cpu-thread and numa-node, where a specific thread should be pinned to
+ *
+ * @param threadId id of the thread within the pool
+ * @param cpuSlot reference for the result
+ *
+ * @return false, if pinning is disabled, else true
+ */
+bool
+ThreadPool::getCpuAssignment(const uint32_t threadId,
+                             CpuSlot &cpuSlot)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+
+    if(m_pinningEnabled == false) {
+        return false;
+    }
+
+    cpuSlot = m_cpuSlots.at(threadId % m_cpuSlots.size());
+    return true;
+}
+
+/**
+ * @brief scaling-loop of the pool, which adds threads, when subtrees have to wait in the queue,
+ *        and removes threads again, when the queue is empty for a longer time
+ */
+void
+ThreadPool::run()
+{
+    while(m_abort == false)
+    {
+        std::this_thread::sleep_for(chronoMilliSec(10));
+
+        std::vector<SakuraThread*> removedThreads;
+
+        m_lock.lock();
+
+        if(m_queue->size() > 0)
+        {
+            m_busyTicks++;
+            m_idleTicks = 0;
+        }
+        else
+        {
+            m_idleTicks++;
+            m_busyTicks = 0;
+        }
+
+        // grow
+        if(m_busyTicks >= GROW_TICKS
+                && m_childThreads.size() < m_maxThreads)
+        {
+            addChildThread();
+            m_busyTicks = 0;
+        }
+
+        // shrink
+        if(m_idleTicks >= SHRINK_TICKS
+                && m_childThreads.size() > m_minThreads)
+        {
+            removeChildThreads(static_cast<uint32_t>(m_childThreads.size()) - 1, removedThreads);
+            m_idleTicks = 0;
+        }
+
+        m_lock.unlock();
+
+        for(SakuraThread* thread : removedThreads) {
+            delete thread;
+        }
+    }
+}
+
+/**
+ * @brief create and start a new thread. The position in the list is used as id of the thread,
+ *        so the ids of the threads are always without gaps.
+ */
+void
+ThreadPool::addChildThread()
+{
+    const uint32_t threadId = static_cast<uint32_t>(m_childThreads.size());
+    SakuraThread* child = new SakuraThread(m_queue, this, threadId);
+    m_childThreads.push_back(child);
+    child->startThread();
+}
+
+/**
+ * @brief remove threads from the end of the list, until the list has the target-size
+ *
+ * @param targetNumber target number of threads
+ * @param removedThreads reference for the removed threads, which have to be deleted afterwards
+ */
+void
+ThreadPool::removeChildThreads(const uint32_t targetNumber,
+                               std::vector<SakuraThread*> &removedThreads)
+{
+    while(m_childThreads.size() > targetNumber)
+    {
+        removedThreads.push_back(m_childThreads.back());
+        m_childThreads.pop_back();
+    }
+}
+
 /**
  * @brief stop and delete all threads of the pool
  */
@@ -24,27 +24,59 @@
 #define KITSUNEMIMI_SAKURA_LANG_THREAD_POOL_H
 
 #include <vector>
+#include <mutex>
+#include <atomic>
 #include <libKitsunemimiCommon/threading/thread.h>
 #include <processing/subtree_queue.h>
+#include <processing/cpu_topology.h>
 
 namespace Kitsunemimi
 {
 namespace Sakura
 {
-class SakuraLangInterface;
 class SakuraThread;
 
 class ThreadPool
+        : public Kitsunemimi::Thread
 {
 public:
     ThreadPool(const uint32_t numberOfThreads,
-               SakuraLangInterface* interface);
+               SubtreeQueue* queue);
     ~ThreadPool();
 
-private:
-    void clearChildThreads();
+    bool setNumberOfThreads(const uint32_t minThreads,
+                            const uint32_t maxThreads);
+    uint32_t getNumberOfThreads();
+
+    void setCpuPinning(const bool enable,
+                       const std::vector<uint32_t> &cpuIds);
+    uint64_t getPinningVersion() const;
+    bool getCpuAssignment(const uint32_t threadId,
+                          CpuSlot &cpuSlot);
 
+protected:
+    void run();
+
+private:
+    SubtreeQueue* m_queue = nullptr;
+    std::mutex m_lock;
     std::vector<SakuraThread*> m_childThreads;
+
+    // scaling
+    uint32_t m_minThreads = 0;
+    uint32_t m_maxThreads = 0;
+    uint32_t m_busyTicks = 0;
+    uint32_t m_idleTicks = 0;
+
+    // pinning
+    bool m_pinningEnabled = false;
+    std::vector<CpuSlot> m_cpuSlots;
+    std::atomic<uint64_t> m_pinningVersion;
+
+    void addChildThread();
+    void removeChildThreads(const uint32_t targetNumber,
+                            std::vector<SakuraThread*> &removedThreads);
+    void clearChildThreads();
 };
 
 } // namespace Sakura
@@ -25,8 +25,10 @@
 #include <items/sakura_items.h>
 
 #include <libKitsunemimiCommon/common_methods/string_methods.h>
+#include <libKitsunemimiCommon/buffer/data_buffer.h>
 
 #include <libKitsunemimiPersistence/logger/logger.h>
+#include <libKitsunemimiPersistence/files/text_file.h>
 #include <libKitsunemimiPersistence/files/file_methods.h>
 
 namespace Kitsunemimi
@@ -37,13 +39,38 @@ namespace Sakura
 /**
  * @brief constructor
  */
-SakuraGarden::SakuraGarden() {}
+SakuraGarden::SakuraGarden()
+{
+    m_content = std::make_shared<const GardenContent>();
+}
+
+/**
+ * @brief create a garden to stage changes, which starts with the actual snapshot of another
+ *        garden. The base-garden is not changed by the staging-garden.
+ *
+ * @param base garden, whose content is used as initial content
+ */
+SakuraGarden::SakuraGarden(const SakuraGarden &base)
+{
+    m_content = base.getContent();
+}
 
 /**
  * @brief destructor
  */
 SakuraGarden::~SakuraGarden() {}
 
+/**
+ * @brief get the actual snapshot of the content
+ *
+ * @return shared-pointer to the actual content, which is valid until it is released
+ */
+std::shared_ptr<const SakuraGarden::GardenContent>
+SakuraGarden::getContent() const
+{
+    return std::atomic_load(&m_content);
+}
+
 /**
  * @brief convert path, which is relative to a sakura-file, into a path, which is relative to the
  *        root-path.
@@ -59,7 +86,7 @@ SakuraGarden::getRelativePath(const bfs::path &blossomFilePath,
 {
     // create source-path
     const bfs::path parentPath = blossomFilePath.parent_path();
-    const bfs::path relativePath = bfs::relative(parentPath, rootPath);
+    const bfs::path relativePath = bfs::relative(parentPath, getRootPath());
 
     // build new relative path for the new file-request
     if(relativePath == ".") {
@@ -81,15 +108,45 @@ bool
 SakuraGarden::addTree(const std::string &id,
                       TreeItem* tree)
 {
+    std::map<std::string, TreeItem*> trees;
+    trees.insert(std::make_pair(id, tree));
+
+    return addTrees(trees);
+}
+
+/**
+ * @brief add multiple new trees at once
+ *
+ * @param trees map with the ids and the new trees
+ *
+ * @return false, if one of the ids already exist, else true
+ */
+bool
+SakuraGarden::addTrees(const std::map<std::string, TreeItem*> &trees)
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
     // check if already exist
     std::map<std::string, TreeItem*>::const_iterator it;
-    it = m_trees.find(id);
-    if(it != m_trees.end()) {
-        return false;
+    for(it = trees.begin();
+        it != trees.end();
+        it++)
+    {
+        if(m_content->trees.find(it->first) != m_content->trees.end()) {
+            return false;
+        }
     }
 
     // add
-    m_trees.insert(std::make_pair(id, tree));
+    std::shared_ptr<GardenContent> newContent = std::make_shared<GardenContent>(*m_content);
+    for(it = trees.begin();
+        it != trees.end();
+        it++)
+    {
+        std::shared_ptr<TreeItem> newTree(it->second);
+        newContent->trees.insert(std::make_pair(it->first, newTree));
+    }
+    std::atomic_store(&m_content, std::shared_ptr<const GardenContent>(newContent));
 
     return true;
 }
@@ -106,15 +163,17 @@ bool
 SakuraGarden::addResource(const std::string &id,
                           TreeItem* resource)
 {
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
     // check if already exist
-    std::map<std::string, TreeItem*>::const_iterator it;
-    it = m_resources.find(id);
-    if(it != m_resources.end()) {
+    if(m_content->resources.find(id) != m_content->resources.end()) {
         return false;
     }
 
     // add
-    m_resources.insert(std::make_pair(id, resource));
+    std::shared_ptr<GardenContent> newContent = std::make_shared<GardenContent>(*m_content);
+    newContent->resources.insert(std::make_pair(id, std::shared_ptr<TreeItem>(resource)));
+    std::atomic_store(&m_content, std::shared_ptr<const GardenContent>(newContent));
 
     return true;
 }
@@ -131,15 +190,18 @@ bool
 SakuraGarden::addTemplate(const std::string &id,
                           const std::string &templateContent)
 {
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
     // check if already exist
-    std::map<std::string, std::string>::const_iterator it;
-    it = m_templates.find(id);
-    if(it != m_templates.end()) {
+    if(m_content->templates.find(id) != m_content->templates.end()) {
         return false;
     }
 
     // add
-    m_templates.insert(std::make_pair(id, templateContent));
+    std::shared_ptr<GardenContent> newContent = std::make_shared<GardenContent>(*m_content);
+    std::shared_ptr<const std::string> newTemplate(new std::string(templateContent));
+    newContent->templates.insert(std::make_pair(id, newTemplate));
+    std::atomic_store(&m_content, std::shared_ptr<const GardenContent>(newContent));
 
     return true;
 }
@@ -156,23 +218,195 @@ bool
 SakuraGarden::addFile(const std::string &id,
                       DataBuffer* fileContent)
 {
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
+    // check if already exist
+    if(m_content->files.find(id) != m_content->files.end()) {
+        return false;
+    }
+
+    // add
+    std::shared_ptr<GardenContent> newContent = std::make_shared<GardenContent>(*m_content);
+    newContent->files.insert(std::make_pair(id, fileContent));
+    std::atomic_store(&m_content, std::shared_ptr<const GardenContent>(newContent));
+
+    return true;
+}
+
+/**
+ * @brief register a directory, whose files, resources and templates were collected
+ *
+ * @param directoryPath path of the directory
+ *
+ * @return false, if the directory was already registered, else true
+ */
+bool
+SakuraGarden::addCollectedDirectory(const std::string &directoryPath)
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
     // check if already exist
-    std::map<std::string, DataBuffer*>::const_iterator it;
-    it = m_files.find(id);
-    if(it != m_files.end()) {
+    if(m_content->collectedDirectories.find(directoryPath)
+            != m_content->collectedDirectories.end())
+    {
         return false;
     }
 
     // add
-    m_files.insert(std::make_pair(id, fileContent));
+    std::shared_ptr<GardenContent> newContent = std::make_shared<GardenContent>(*m_content);
+    newContent->collectedDirectories.insert(directoryPath);
+    std::atomic_store(&m_content, std::shared_ptr<const GardenContent>(newContent));
+
+    return true;
+}
+
+/**
+ * @brief set the path of the directory, which contains the initial file of the last read
+ *        sakura-files
+ *
+ * @param rootPath new root-path
+ */
+void
+SakuraGarden::setRootPath(const std::string &rootPath)
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
+    std::shared_ptr<GardenContent> newContent = std::make_shared<GardenContent>(*m_content);
+    newContent->rootPath = rootPath;
+    std::atomic_store(&m_content, std::shared_ptr<const GardenContent>(newContent));
+}
+
+/**
+ * @brief publish the content of a staging-garden together with new trees at once. Resources,
+ *        templates, files and directories of the staging-garden, which don't exist in this
+ *        garden, are added. Changes, which were published in this garden after the
+ *        staging-garden was created, are kept.
+ *
+ * @param staging garden, which was created as copy of this garden and contains the new content
+ * @param trees map with the ids and the new trees
+ * @param replaceTrees true to replace existing trees with the same id, false to fail in this case
+ *
+ * @return false, if one of the ids of the trees already exist and should not be replaced,
+ *         else true
+ */
+bool
+SakuraGarden::publishStaged(const SakuraGarden &staging,
+                            const std::map<std::string, TreeItem*> &trees,
+                            const bool replaceTrees)
+{
+    std::lock_guard<std::mutex> guard(m_writeLock);
+
+    // check if already exist
+    std::map<std::string, TreeItem*>::const_iterator it;
+    if(replaceTrees == false)
+    {
+        for(it = trees.begin();
+            it != trees.end();
+            it++)
+        {
+            if(m_content->trees.find(it->first) != m_content->trees.end()) {
+                return false;
+            }
+        }
+    }
+
+    // existing entries are not overwritten by the insert, so only the staged ones are added
+    const std::shared_ptr<const GardenContent> staged = staging.getContent();
+    std::shared_ptr<GardenContent> newContent = std::make_shared<GardenContent>(*m_content);
+    newContent->resources.insert(staged->resources.begin(), staged->resources.end());
+    newContent->templates.insert(staged->templates.begin(), staged->templates.end());
+
+    // files are raw buffers, so a staged buffer, which is refused because of an already existing
+    // file with the same id, has to be deleted here. Buffers of the base-snapshot are the same
+    // objects in both gardens and are kept.
+    std::unordered_map<std::string, DataBuffer*>::const_iterator fileIt;
+    for(fileIt = staged->files.begin();
+        fileIt != staged->files.end();
+        fileIt++)
+    {
+        std::pair<std::unordered_map<std::string, DataBuffer*>::iterator, bool> ret;
+        ret = newContent->files.insert(*fileIt);
+        if(ret.second == false
+                && ret.first->second != fileIt->second)
+        {
+            delete fileIt->second;
+        }
+    }
+
+    newContent->collectedDirectories.insert(staged->collectedDirectories.begin(),
+                                            staged->collectedDirectories.end());
+
+    // add or replace trees. Old versions are deleted, when the last reader has released them.
+    for(it = trees.begin();
+        it != trees.end();
+        it++)
+    {
+        newContent->trees[it->first] = std::shared_ptr<TreeItem>(it->second);
+    }
+
+    if(staged->rootPath != "") {
+        newContent->rootPath = staged->rootPath;
+    }
+    std::atomic_store(&m_content, std::shared_ptr<const GardenContent>(newContent));
 
     return true;
 }
 
 /**
- * @brief SakuraGarden::containsTree
- * @param id
- * @return
+ * @brief collect all trees, which were read from files and whose files have another content
+ *        than at the time, when they were parsed. The content is compared instead of the
+ *        timestamp, because timestamps can be unchanged by a write or changed without any write.
+ *
+ * @param changedTrees reference for the result, which maps the id of each changed tree to the
+ *                     root-path, where it was read from
+ */
+void
+SakuraGarden::getChangedTrees(std::map<std::string, std::string> &changedTrees)
+{
+    const std::shared_ptr<const GardenContent> content = getContent();
+
+    std::unordered_map<std::string, std::shared_ptr<TreeItem>>::const_iterator it;
+    for(it = content->trees.begin();
+        it != content->trees.end();
+        it++)
+    {
+        const TreeItem* tree = it->second.get();
+
+        // trees, which were added as string, have no file to compare with
+        if(tree->rootPath == "") {
+            continue;
+        }
+
+        // deleted files are ignored, so the last valid version stays active
+        const bfs::path filePath = bfs::path(tree->rootPath) / tree->relativePath;
+        if(bfs::exists(filePath) == false) {
+            continue;
+        }
+
+        // different sizes are detected without reading the file
+        if(bfs::file_size(filePath) != tree->unparsedConent.size())
+        {
+            changedTrees.insert(std::make_pair(it->first, tree->rootPath));
+            continue;
+        }
+
+        // unreadable files are handled like deleted files
+        std::string fileContent = "";
+        std::string errorMessage = "";
+        if(Kitsunemimi::Persistence::readFile(fileContent, filePath.string(), errorMessage)
+                && fileContent != tree->unparsedConent)
+        {
+            changedTrees.insert(std::make_pair(it->first, tree->rootPath));
+        }
+    }
+}
+
+/**
+ * @brief check, if a tree with a specific id exist
+ *
+ * @param id id of the tree
+ *
+ * @return true, if exist, else false
  */
 bool
 SakuraGarden::containsTree(std::string id)
@@ -181,13 +415,37 @@ SakuraGarden::containsTree(std::string id)
        id = "root.sakura";
     }
 
-    std::map<std::string, TreeItem*>::const_iterator it;
-    it = m_trees.find(id);
-    if(it != m_trees.end()) {
-        return true;
-    }
+    const std::shared_ptr<const GardenContent> content = getContent();
+    return content->trees.find(id) != content->trees.end();
+}
 
-    return false;
+/**
+ * @brief check, if a resource with a specific id exist
+ *
+ * @param id id of the resource
+ *
+ * @return true, if exist, else false
+ */
+bool
+SakuraGarden::containsRessource(const std::string &id)
+{
+    const std::shared_ptr<const GardenContent> content = getContent();
+    return content->resources.find(id) != content->resources.end();
+}
+
+/**
+ * @brief check, if the files, resources and templates of a directory were already collected
+ *
+ * @param directoryPath path of the directory
+ *
+ * @return true, if collected, else false
+ */
+bool
+SakuraGarden::isDirectoryCollected(const std::string &directoryPath)
+{
+    const std::shared_ptr<const GardenContent> content = getContent();
+    return content->collectedDirectories.find(directoryPath)
+            != content->collectedDirectories.end();
 }
 
 /**
@@ -200,9 +458,11 @@ SakuraGarden::containsTree(std::string id)
 TreeItem*
 SakuraGarden::getRessource(const std::string &id)
 {
-    std::map<std::string, TreeItem*>::const_iterator it;
-    it = m_resources.find(id);
-    if(it != m_resources.end()) {
+    const std::shared_ptr<const GardenContent> content = getContent();
+
+    std::unordered_map<std::string, std::shared_ptr<TreeItem>>::const_iterator it;
+    it = content->resources.find(id);
+    if(it != content->resources.end()) {
         return dynamic_cast<TreeItem*>(it->second->copy());
     }
 
@@ -223,9 +483,11 @@ SakuraGarden::getTree(std::string id)
        id = "root.sakura";
     }
 
-    std::map<std::string, TreeItem*>::const_iterator it;
-    it = m_trees.find(id);
-    if(it != m_trees.end()) {
+    const std::shared_ptr<const GardenContent> content = getContent();
+
+    std::unordered_map<std::string, std::shared_ptr<TreeItem>>::const_iterator it;
+    it = content->trees.find(id);
+    if(it != content->trees.end()) {
         return dynamic_cast<TreeItem*>(it->second->copy());
     }
 
@@ -233,23 +495,27 @@ SakuraGarden::getTree(std::string id)
 }
 
 /**
- * @brief request template
+ * @brief request template. Templates can not be replaced or removed, so the returned reference
+ *        stays valid as long as the garden exist.
  *
  * @param id id of the template
  *
  * @return template, if id found, else empty string
  */
-const std::string
+const std::string&
 SakuraGarden::getTemplate(const std::string &id)
 {
-    std::map<std::string, std::string>::const_iterator it;
-    it = m_templates.find(id);
+    static const std::string emptyTemplate = "";
 
-    if(it != m_templates.end()) {
-        return it->second;
+    const std::shared_ptr<const GardenContent> content = getContent();
+
+    std::unordered_map<std::string, std::shared_ptr<const std::string>>::const_iterator it;
+    it = content->templates.find(id);
+    if(it != content->templates.end()) {
+        return *it->second;
     }
 
-    return "";
+    return emptyTemplate;
 }
 
 /**
@@ -262,15 +528,28 @@ SakuraGarden::getTemplate(const std::string &id)
 Kitsunemimi::DataBuffer*
 SakuraGarden::getFile(const std::string &id)
 {
-    std::map<std::string, Kitsunemimi::DataBuffer*>::const_iterator it;
-    it = m_files.find(id);
+    const std::shared_ptr<const GardenContent> content = getContent();
 
-    if(it != m_files.end()) {
+    std::unordered_map<std::string, Kitsunemimi::DataBuffer*>::const_iterator it;
+    it = content->files.find(id);
+    if(it != content->files.end()) {
         return it->second;
     }
 
     return nullptr;
 }
 
+/**
+ * @brief get the path of the directory, which contains the initial file of the last read
+ *        sakura-files
+ *
+ * @return copy of the root-path of the actual snapshot
+ */
+const std::string
+SakuraGarden::getRootPath() const
+{
+    return getContent()->rootPath;
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
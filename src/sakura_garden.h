@@ -26,6 +26,10 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
 
 #include <boost/filesystem.hpp>
 
@@ -38,41 +42,66 @@ struct DataBuffer;
 namespace Sakura
 {
 class TreeItem;
-class Validator;
 
+/**
+ * @brief The SakuraGarden class stores all trees, resources, templates and files. Readers access
+ *        an immutable snapshot of the content without any lock. Every change creates a new
+ *        snapshot, which is published atomically, so running readers keep their old snapshot
+ *        until they are finished. A garden, which is created as copy of another one, can be used
+ *        to stage changes, which are published together into the original garden.
+ */
 class SakuraGarden
 {
 public:
     SakuraGarden();
+    SakuraGarden(const SakuraGarden &base);
     ~SakuraGarden();
 
     const bfs::path getRelativePath(const bfs::path &blossomFilePath,
                                     const bfs::path &blossomInternalRelPath);
     // add
     bool addTree(const std::string &id, TreeItem* tree);
+    bool addTrees(const std::map<std::string, TreeItem*> &trees);
     bool addResource(const std::string &id, TreeItem* resource);
     bool addTemplate(const std::string &id, const std::string &templateContent);
     bool addFile(const std::string &id, Kitsunemimi::DataBuffer* fileContent);
 
+    bool addCollectedDirectory(const std::string &directoryPath);
+    void setRootPath(const std::string &rootPath);
+
+    // update
+    bool publishStaged(const SakuraGarden &staging,
+                       const std::map<std::string, TreeItem*> &trees,
+                       const bool replaceTrees);
+    void getChangedTrees(std::map<std::string, std::string> &changedTrees);
+
     // check
     bool containsTree(std::string id);
+    bool containsRessource(const std::string &id);
+    bool isDirectoryCollected(const std::string &directoryPath);
 
     // get
     TreeItem* getTree(std::string id);
     TreeItem* getRessource(const std::string &id);
-    const std::string getTemplate(const std::string &id);
+    const std::string& getTemplate(const std::string &id);
     DataBuffer* getFile(const std::string &id);
-
-    // object-handling
-    std::string rootPath = "";
+    const std::string getRootPath() const;
 
 private:
-    friend Validator;
+    struct GardenContent
+    {
+        std::unordered_map<std::string, std::shared_ptr<TreeItem>> trees;
+        std::unordered_map<std::string, std::shared_ptr<TreeItem>> resources;
+        std::unordered_map<std::string, std::shared_ptr<const std::string>> templates;
+        std::unordered_map<std::string, Kitsunemimi::DataBuffer*> files;
+        std::unordered_set<std::string> collectedDirectories;
+        std::string rootPath = "";
+    };
+
+    std::shared_ptr<const GardenContent> m_content;
+    std::mutex m_writeLock;
 
-    std::map<std::string, TreeItem*> m_trees;
-    std::map<std::string, TreeItem*> m_resources;
-    std::map<std::string, std::string> m_templates;
-    std::map<std::string, Kitsunemimi::DataBuffer*> m_files;
+    std::shared_ptr<const GardenContent> getContent() const;
 };
 
 } // namespace Sakura
@@ -26,11 +26,18 @@
 #include <validator.h>
 
 #include <parsing/sakura_parsing.h>
+#include <parsing/parse_cache.h>
 
 #include <processing/subtree_queue.h>
 #include <processing/thread_pool.h>
+#include <processing/cpu_topology.h>
+#include <processing/blossom_trace.h>
+#include <processing/blossom_cache.h>
+
+#include <optimizer/constant_folding.h>
 
 #include <items/item_methods.h>
+#include <items/error_container.h>
 
 #include <libKitsunemimiJinja2/jinja2_converter.h>
 #include <libKitsunemimiPersistence/logger/logger.h>
@@ -45,22 +52,55 @@ namespace Sakura
 Kitsunemimi::Sakura::SakuraLangInterface* SakuraLangInterface::m_instance = nullptr;
 
 /**
- * @brief constructor
+ * @brief constructor to create an independent interface with its own garden, blossoms and
+ *        thread-pool
  *
+ * @param numberOfThreads number of worker-threads of the thread-pool
  * @param enableDebug set to true to enable the debug-output of the parser
  */
 SakuraLangInterface::SakuraLangInterface(const uint16_t numberOfThreads,
                                          const bool enableDebug)
 {
-    m_validator = new Validator();
+    m_validator = new Validator(this);
+    m_parser = new SakuraParsing(enableDebug);
+    m_garden = new SakuraGarden();
+    m_parseCache = new ParseCache();
+    m_trace = new BlossomTrace();
+    m_blossomCache = new BlossomCache();
+    m_foldingStats = new FoldingStats();
+
+    std::vector<std::vector<uint32_t>> numaNodes;
+    getNumaNodes(numaNodes);
+    m_queue = new SubtreeQueue(static_cast<uint32_t>(numaNodes.size()));
+
+    m_threadPoos = new ThreadPool(numberOfThreads, m_queue);
+}
+
+/**
+ * @brief constructor to create an interface with its own garden and blossoms, which shares the
+ *        queue and the worker-threads of another interface. The other interface must exist
+ *        longer than the new one.
+ *
+ * @param poolProvider interface, which provides the queue and the thread-pool
+ * @param enableDebug set to true to enable the debug-output of the parser
+ */
+SakuraLangInterface::SakuraLangInterface(SakuraLangInterface* poolProvider,
+                                         const bool enableDebug)
+{
+    m_validator = new Validator(this);
     m_parser = new SakuraParsing(enableDebug);
     m_garden = new SakuraGarden();
-    m_queue = new SubtreeQueue();
-    m_threadPoos = new ThreadPool(numberOfThreads, this);
+    m_parseCache = new ParseCache();
+    m_trace = new BlossomTrace();
+    m_blossomCache = new BlossomCache();
+    m_foldingStats = new FoldingStats();
+    m_queue = poolProvider->m_queue;
+    m_threadPoos = poolProvider->m_threadPoos;
+    m_ownsThreadPool = false;
 }
 
 /**
- * @brief static methode to get instance of the interface
+ * @brief static methode to get a process-wide default-instance of the interface
  *
  * @return pointer to the static instance
  */
@@ -79,9 +119,269 @@ SakuraLangInterface::getInstance()
  */
 SakuraLangInterface::~SakuraLangInterface()
 {
+    // the pool has to be deleted first, because its threads still access the queue
+    if(m_ownsThreadPool)
+    {
+        delete m_threadPoos;
+        delete m_queue;
+    }
+
+    delete m_parseCache;
+    delete m_trace;
+    delete m_blossomCache;
+    delete m_foldingStats;
     delete m_garden;
-    delete m_queue;
-    delete m_threadPoos;
+    delete m_parser;
+    delete m_validator;
+}
+
+/**
+ * @brief change the number of worker-threads. If the thread-pool is shared with other
+ *        interfaces, the change affects all of them.
+ *
+ * @param numberOfThreads minimum number of threads, which are always running
+ * @param maxNumberOfThreads maximum number of threads. If greater than the minimum, the pool
+ *                           grows, when subtrees have to wait in the queue, and shrinks again,
+ *                           when idle. If 0, the pool has a fixed size.
+ *
+ * @return false, if the values are invalid, else true
+ */
+bool
+SakuraLangInterface::setNumberOfThreads(const uint16_t numberOfThreads,
+                                        const uint16_t maxNumberOfThreads)
+{
+    uint16_t maxThreads = maxNumberOfThreads;
+    if(maxThreads == 0) {
+        maxThreads = numberOfThreads;
+    }
+
+    return m_threadPoos->setNumberOfThreads(numberOfThreads, maxThreads);
+}
+
+/**
+ * @brief get the current number of worker-threads
+ *
+ * @return number of threads
+ */
+uint16_t
+SakuraLangInterface::getNumberOfThreads()
+{
+    return static_cast<uint16_t>(m_threadPoos->getNumberOfThreads());
+}
+
+/**
+ * @brief enable or disable the pinning of the worker-threads to cpu-threads. When enabled, the
+ *        threads are spread over all numa-nodes and new subtrees are preferred processed on the
+ *        numa-node of the thread, which spawned them.
+ *
+ * @param enable true to enable pinning
+ * @param cpuIds list of allowed cpu-ids. If empty, all cpu-threads of the host are used.
+ */
+void
+SakuraLangInterface::setCpuPinning(const bool enable,
+                                   const std::vector<uint32_t> &cpuIds)
+{
+    m_threadPoos->setCpuPinning(enable, cpuIds);
+}
+
+/**
+ * @brief get the metrics of the scheduling of the subtrees for each priority-class. If the
+ *        thread-pool is shared with other interfaces, the metrics contain the runs of all of them.
+ *
+ * @param result reference for the resulting map with one entry per priority-class
+ */
+void
+SakuraLangInterface::getSchedulingMetrics(DataMap &result)
+{
+    m_queue->getSchedulingMetrics(result);
+}
+
+/**
+ * @brief change the maximum size of the cache for trees, which are given as string to runTree
+ *        and addTree. Least recently used trees are removed, if the cache is full.
+ *
+ * @param maxSize maximum number of bytes of all cached tree-contents and the estimated size of
+ *                their parsed trees. 0 disables the cache.
+ */
+void
+SakuraLangInterface::setParseCacheSize(const uint64_t maxSize)
+{
+    m_parseCache->setMaxSize(maxSize);
+}
+
+/**
+ * @brief get the hits, misses, evictions, invalidations and the size of the parse-cache
+ *
+ * @param result reference for the resulting map
+ */
+void
+SakuraLangInterface::getParseCacheMetrics(DataMap &result)
+{
+    m_parseCache->getMetrics(result);
+}
+
+/**
+ * @brief change the maximum size of the cache for the results of pure blossoms
+ *
+ * @param maxSize maximum number of bytes of all cached inputs and outputs. 0 disables the cache.
+ */
+void
+SakuraLangInterface::setBlossomCacheSize(const uint64_t maxSize)
+{
+    m_blossomCache->setMaxSize(maxSize);
+}
+
+/**
+ * @brief get metrics of the cache for the results of pure blossoms
+ *
+ * @param result reference for the resulting map
+ */
+void
+SakuraLangInterface::getBlossomCacheMetrics(DataMap &result)
+{
+    m_blossomCache->getMetrics(result);
+}
+
+/**
+ * @brief select the format of the error-messages, which are returned by the interface
+ *
+ * @param enable true to get errors as json-array with one object per error, false to get
+ *               them as tables
+ */
+void
+SakuraLangInterface::setJsonErrorOutput(const bool enable)
+{
+    m_jsonErrorOutput = enable;
+}
+
+/**
+ * @brief enable or disable the parallel processing of independent blossom-groups within
+ *        sequential blocks. Two blossom-groups are independent, if none of them writes a value,
+ *        which is read or written by the other one. Blossoms, which are not pure, can read the
+ *        values of the parent directly, so groups with these blossoms are never processed at the
+ *        same time as their neighbours.
+ *
+ * @param enable true to enable
+ */
+void
+SakuraLangInterface::setAutoParallelization(const bool enable)
+{
+    m_autoParallelization = enable;
+}
+
+/**
+ * @brief change the maximum number of iterations of a sequential loop, which are given at once
+ *        to a blossom with batch-support
+ *
+ * @param batchSize maximum number of calls per batch. Values below 2 disable the batches.
+ */
+void
+SakuraLangInterface::setBatchSize(const uint32_t batchSize)
+{
+    m_batchSize = batchSize;
+}
+
+/**
+ * @brief get the number of optimizations of the constant-folding, which were applied to all
+ *        validated trees of this interface
+ *
+ * @param result reference for the resulting map
+ */
+void
+SakuraLangInterface::getFoldingMetrics(DataMap &result)
+{
+    std::lock_guard<std::mutex> guard(m_foldingLock);
+
+    result.insert("folded_values",
+                  new DataValue(static_cast<long>(m_foldingStats->foldedValues)),
+                  true);
+    result.insert("pruned_branches",
+                  new DataValue(static_cast<long>(m_foldingStats->prunedBranches)),
+                  true);
+    result.insert("unrolled_loops",
+                  new DataValue(static_cast<long>(m_foldingStats->unrolledLoops)),
+                  true);
+    result.insert("removed_loops",
+                  new DataValue(static_cast<long>(m_foldingStats->removedLoops)),
+                  true);
+}
+
+/**
+ * @brief add the optimizations of the constant-folding of a tree to the metrics
+ *
+ * @param stats optimizations of a single tree
+ */
+void
+SakuraLangInterface::addFoldingStats(const FoldingStats &stats)
+{
+    std::lock_guard<std::mutex> guard(m_foldingLock);
+
+    m_foldingStats->foldedValues += stats.foldedValues;
+    m_foldingStats->prunedBranches += stats.prunedBranches;
+    m_foldingStats->unrolledLoops += stats.unrolledLoops;
+    m_foldingStats->removedLoops += stats.removedLoops;
+}
+
+/**
+ * @brief start to record the inputs and results of all blossom-calls of this interface into a
+ *        binary trace-file. The calls are written into the file while recording, so the memory
+ *        doesn't grow with the length of the recording. An already running recording or
+ *        replay is stopped.
+ *
+ * @param filePath path of the file, where the trace should be written
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if the file can not be opened, else true
+ */
+bool
+SakuraLangInterface::startTraceRecording(const std::string &filePath,
+                                         std::string &errorMessage)
+{
+    return m_trace->startRecording(filePath, errorMessage);
+}
+
+/**
+ * @brief stop the recording of the blossom-calls and write the rest of the trace into the file
+ *
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if no recording was running or writing the file failed, else true
+ */
+bool
+SakuraLangInterface::stopTraceRecording(std::string &errorMessage)
+{
+    return m_trace->stopRecording(errorMessage);
+}
+
+/**
+ * @brief read a recorded trace and use the recorded results of the blossoms for all following
+ *        runs instead of processing the blossoms. Each recorded call is used only once and is
+ *        identified by the blossom and its input.
+ *
+ * @param filePath path of the file with the trace
+ * @param errorMessage reference for error-message
+ *
+ * @return false, if the file can not be read or is not a valid trace, else true
+ */
+bool
+SakuraLangInterface::startTraceReplay(const std::string &filePath,
+                                      std::string &errorMessage)
+{
+    std::string trace = "";
+    if(Kitsunemimi::Persistence::readFile(trace, filePath, errorMessage) == false) {
+        return false;
+    }
+
+    return m_trace->startReplay(trace, errorMessage);
+}
+
+/**
+ * @brief stop the replay, so the blossoms are processed again
+ */
+void
+SakuraLangInterface::stopTraceReplay()
+{
+    m_trace->stopReplay();
 }
 
 /**
@@ -91,6 +391,7 @@ SakuraLangInterface::~SakuraLangInterface()
  * @param id id of the tree to trigger
  * @param initialValues input-values for the tree
  * @param errorMessage reference for error-message
+ * @param priority priority-class of the run for the scheduling of its subtrees
  *
  * @return true, if successfule, else false
  */
@@ -98,36 +399,34 @@ bool
 SakuraLangInterface::triggerTree(DataMap &result,
                                  const std::string &id,
                                  DataMap &initialValues,
-                                 std::string &errorMessage)
+                                 std::string &errorMessage,
+                                 const RunPriority priority)
 {
     LOG_DEBUG("trigger tree");
 
-    m_lock.lock();
-
-    // get initial tree-item
+    // get initial tree-item. The garden can be read without lock.
     TreeItem* tree = m_garden->getTree(id);
     if(tree == nullptr)
     {
         errorMessage = "No tree found for the input-path " + id;
-        m_lock.unlock();
         return false;
     }
 
     overrideItems(initialValues, tree->values, ONLY_NON_EXISTING);
 
     // process sakura-file with initial values
-    if(runProcess(result,
-                  tree,
-                  initialValues,
-                  errorMessage) == false)
-    {
-        m_lock.unlock();
-        return false;
+    const bool ret = runProcess(result,
+                                tree,
+                                initialValues,
+                                priority,
+                                errorMessage);
+    delete tree;
+
+    if(ret == false) {
+        renderError(errorMessage);
     }
 
-    m_lock.unlock();
-
-    return true;
+    return ret;
 }
 
 /**
@@ -138,6 +437,7 @@ SakuraLangInterface::triggerTree(DataMap &result,
  * @param treeContent content of the tree-which should be parsed
  * @param initialValues input-values for the tree
  * @param errorMessage reference for error-message
+ * @param priority priority-class of the run for the scheduling of its subtrees
  *
  * @return true, if successfule, else false
  */
@@ -146,39 +446,33 @@ SakuraLangInterface::runTree(DataMap& result,
                              const std::string &id,
                              const std::string &treeContent,
                              const DataMap &initialValues,
-                             std::string &errorMessage)
+                             std::string &errorMessage,
+                             const RunPriority priority)
 {
+    // the lock is only necessary for the parser, but not for the processing
     m_lock.lock();
+    TreeItem* tree = getValidatedTree(id, treeContent, errorMessage);
+    m_lock.unlock();
 
-    // get initial tree-item
-    TreeItem* tree = m_parser->parseTreeString(id, treeContent, errorMessage);
     if(tree == nullptr)
     {
-        errorMessage = "Failed to parse " + id;
-        m_lock.unlock();
-        return false;
-    }
-
-    // validator parsed tree
-    if(m_validator->checkSakuraItem(tree, "", errorMessage) == false)
-    {
-        m_lock.unlock();
+        renderError(errorMessage);
         return false;
     }
 
     // process sakura-file with initial values
-    if(runProcess(result,
-                  tree,
-                  initialValues,
-                  errorMessage) == false)
-    {
-        m_lock.unlock();
-        return false;
+    const bool ret = runProcess(result,
+                                tree,
+                                initialValues,
+                                priority,
+                                errorMessage);
+    delete tree;
+
+    if(ret == false) {
+        renderError(errorMessage);
     }
 
-    m_lock.unlock();
-
-    return true;
+    return ret;
 }
 
 /**
@@ -243,6 +537,9 @@ SakuraLangInterface::addBlossom(const std::string &groupName,
     groupIt = m_registeredBlossoms.find(groupName);
     groupIt->second.insert(std::make_pair(itemName, newBlossom));
 
+    // cached trees were validated without the new blossom
+    m_parseCache->invalidate();
+
     return true;
 }
 
@@ -292,30 +589,27 @@ SakuraLangInterface::addTree(std::string id,
                              std::string &errorMessage)
 {
     m_lock.lock();
+    TreeItem* tree = getValidatedTree(id, treeContent, errorMessage);
+    m_lock.unlock();
 
-    // get initial tree-item
-    TreeItem* tree = m_parser->parseTreeString(id, treeContent, errorMessage);
     if(tree == nullptr)
     {
-        errorMessage = "Failed to parse " + id;
-        m_lock.unlock();
-        return false;
-    }
-
-    // validator parsed tree
-    if(m_validator->checkSakuraItem(tree, "", errorMessage) == false)
-    {
-        m_lock.unlock();
+        renderError(errorMessage);
         return false;
     }
 
     if(id == "") {
         id = tree->id;
     }
-    const bool result = m_garden->addTree(id, tree);
-    m_lock.unlock();
 
-    return result;
+    if(m_garden->addTree(id, tree) == false)
+    {
+        delete tree;
+        return false;
+    }
+    m_parseCache->invalidate();
+
+    return true;
 }
 
 /**
@@ -330,11 +624,12 @@ bool
 SakuraLangInterface::addTemplate(const std::string &id,
                                  const std::string &templateContent)
 {
-    m_lock.lock();
-    const bool result = m_garden->addTemplate(id, templateContent);
-    m_lock.unlock();
+    if(m_garden->addTemplate(id, templateContent) == false) {
+        return false;
+    }
+    m_parseCache->invalidate();
 
-    return result;
+    return true;
 }
 
 /**
@@ -349,11 +644,12 @@ bool
 SakuraLangInterface::addFile(const std::string &id,
                              DataBuffer* data)
 {
-    m_lock.lock();
-    const bool result = m_garden->addFile(id, data);
-    m_lock.unlock();
+    if(m_garden->addFile(id, data) == false) {
+        return false;
+    }
+    m_parseCache->invalidate();
 
-    return result;
+    return true;
 }
 
 /**
@@ -382,24 +678,101 @@ SakuraLangInterface::readFiles(const std::string &inputPath,
         treeFile = treeFile + "/root.sakura";
     }
 
+    std::map<std::string, TreeItem*> parsedTrees;
+
     m_lock.lock();
 
+    // the collected resources, templates and files are staged and not visible for other
+    // threads, until all trees are valid
+    SakuraGarden staging(*m_garden);
+
     // parse all files
-    if(m_parser->parseTreeFiles(*m_garden, inputPath, errorMessage) == false)
+    if(m_parser->parseTreeFiles(staging, inputPath, parsedTrees, errorMessage) == false)
     {
         errorMessage = "failed to add trees\n" + errorMessage;
         m_lock.unlock();
         return false;
     }
 
-    // check parsed trees
-    if(m_validator->checkAllItems(errorMessage) == false)
+    // check parsed trees against the staged resources
+    Validator stagingValidator(this, &staging);
+    if(stagingValidator.checkAllItems(parsedTrees, errorMessage) == false)
+    {
+        errorMessage = createError("validator", "validation failed" + errorMessage);
+        renderError(errorMessage);
+        deleteTrees(parsedTrees);
+        m_lock.unlock();
+        return false;
+    }
+
+    // publish trees and staged content at once
+    if(m_garden->publishStaged(staging, parsedTrees, false) == false)
+    {
+        errorMessage = "failed to add trees, because at least one of the trees already exist";
+        deleteTrees(parsedTrees);
+        m_lock.unlock();
+        return false;
+    }
+    m_parseCache->invalidate();
+
+    m_lock.unlock();
+
+    return true;
+}
+
+/**
+ * @brief reparse all trees, whose files were changed since they were read, and replace the old
+ *        versions. If parsing or validation of one of the changed files fails, all old versions
+ *        stay active.
+ *
+ * @param errorMessage reference for error-message
+ *
+ * @return true, if successfule, else false
+ */
+bool
+SakuraLangInterface::reloadFiles(std::string &errorMessage)
+{
+    std::map<std::string, std::string> changedTrees;
+    std::map<std::string, TreeItem*> parsedTrees;
+
+    m_lock.lock();
+
+    m_garden->getChangedTrees(changedTrees);
+    if(changedTrees.size() == 0)
+    {
+        m_lock.unlock();
+        return true;
+    }
+
+    // resources, templates and files of newly referenced directories are staged like the trees
+    SakuraGarden staging(*m_garden);
+
+    // parse only the changed files and files, which are newly referenced by them
+    if(m_parser->parseChangedTreeFiles(staging,
+                                       changedTrees,
+                                       parsedTrees,
+                                       errorMessage) == false)
+    {
+        errorMessage = "failed to reload trees\n" + errorMessage;
+        m_lock.unlock();
+        return false;
+    }
+
+    // check new trees before any of them is activated
+    Validator stagingValidator(this, &staging);
+    if(stagingValidator.checkAllItems(parsedTrees, errorMessage) == false)
     {
-        errorMessage = "validation failed\n" + errorMessage;
+        errorMessage = createError("validator", "validation failed" + errorMessage);
+        renderError(errorMessage);
+        deleteTrees(parsedTrees);
         m_lock.unlock();
         return false;
     }
 
+    // replace old versions
+    m_garden->publishStaged(staging, parsedTrees, true);
+    m_parseCache->invalidate();
+
     m_lock.unlock();
 
     return true;
@@ -452,7 +825,7 @@ SakuraLangInterface::readFilesInDir(const std::string &directoryPath,
  *
  * @return template as string or empty string, if no template found for the given path
  */
-const std::string
+const std::string&
 SakuraLangInterface::getTemplate(const std::string &id)
 {
     return m_garden->getTemplate(id);
@@ -494,6 +867,7 @@ SakuraLangInterface::getRelativePath(const bfs::path &blossomFilePath,
  * @param item subtree to spawn
  * @param initialValues initial set of values to override the same named values within the initial
  *                      called tree-item
+ * @param priority priority-class of the run
  * @param errorMessage reference for error-message
  *
  * @return true, if proocess was successful, else false
@@ -502,6 +876,7 @@ bool
 SakuraLangInterface::runProcess(DataMap &resultingItems,
                                 TreeItem* tree,
                                 const DataMap &initialValues,
+                                const RunPriority priority,
                                 std::string &errorMessage)
 {
     // check if input-values match with the first tree
@@ -521,14 +896,113 @@ SakuraLangInterface::runProcess(DataMap &resultingItems,
     childs.push_back(tree);
     std::vector<std::string> hierarchy;
 
-    const bool result = m_queue->spawnParallelSubtrees(resultingItems,
+    // the context is shared by all subtrees of this run and exist until all of them are finished
+    SubtreeQueue::RunContext runContext;
+    runContext.interface = this;
+    runContext.runId = m_queue->createRunId();
+    runContext.priority = priority;
+
+    DataMap changedItems;
+    const bool result = m_queue->spawnParallelSubtrees(&runContext,
+                                                       changedItems,
                                                        childs,
+                                                       ValueItemMap(),
                                                        "",
                                                        hierarchy,
                                                        initialValues,
                                                        errorMessage);
+    if(result == false) {
+        return false;
+    }
+
+    // the root-tree returns all of its input-values and not only the changed ones
+    overrideItems(resultingItems, initialValues, ALL);
+    moveExistingItems(resultingItems, changedItems);
+
+    return true;
+}
+
+/**
+ * @brief get a parsed, validated and optimized tree for a tree-content. The tree is taken from
+ *        the parse-cache, if the same content was already processed before.
+ *
+ * @param id id of the tree
+ * @param treeContent content of the tree, which should be parsed
+ * @param errorMessage reference for error-message
+ *
+ * @return new tree-item, if successful, else nullptr
+ */
+TreeItem*
+SakuraLangInterface::getValidatedTree(const std::string &id,
+                                      const std::string &treeContent,
+                                      std::string &errorMessage)
+{
+    const uint64_t generation = m_parseCache->getGeneration();
+    TreeItem* tree = m_parseCache->get(treeContent);
+    if(tree != nullptr)
+    {
+        tree->relativePath = id;
+        return tree;
+    }
+
+    // parse tree
+    tree = m_parser->parseTreeString(id, treeContent, errorMessage);
+    if(tree == nullptr)
+    {
+        errorMessage = "Failed to parse " + id;
+        return nullptr;
+    }
+
+    // validator parsed tree
+    if(m_validator->checkSakuraItem(tree, "", errorMessage) == false)
+    {
+        delete tree;
+        return nullptr;
+    }
+    FoldingStats stats;
+    optimizeTree(tree, m_garden, stats);
+    addFoldingStats(stats);
+
+    m_parseCache->add(treeContent, tree, generation);
+
+    return tree;
+}
+
+/**
+ * @brief render the internal error-records of an error-message, before the error-message
+ *        leaves the interface
+ *
+ * @param errorMessage reference to the error-message, which should be rendered
+ */
+void
+SakuraLangInterface::renderError(std::string &errorMessage)
+{
+    const ErrorContainer errors(errorMessage);
+
+    if(m_jsonErrorOutput) {
+        errorMessage = errors.toJsonString();
+    } else {
+        errorMessage = errors.toString();
+    }
+}
+
+/**
+ * @brief delete all trees of a map, which were not added to the garden
+ *
+ * @param trees map with the trees to delete
+ */
+void
+SakuraLangInterface::deleteTrees(std::map<std::string, TreeItem*> &trees)
+{
+    std::map<std::string, TreeItem*>::iterator it;
+    for(it = trees.begin();
+        it != trees.end();
+        it++)
+    {
+        delete it->second;
+    }
 
-    return result;
+    trees.clear();
 }
 
 /**
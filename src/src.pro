@@ -39,9 +39,18 @@ HEADERS += \
     items/value_item_map.h \
     items/value_items.h \
     items/item_methods.h \
+    items/error_container.h \
+    items/json_path_scanner.h \
     items/value_item_functions.h \
+    optimizer/constant_folding.h \
+    optimizer/dependency_analysis.h \
+    parsing/parse_cache.h \
     parsing/sakura_parser_interface.h \
     parsing/sakura_parsing.h \
+    processing/blossom_cache.h \
+    processing/blossom_trace.h \
+    processing/cpu_topology.h \
+    processing/loop_source.h \
     processing/sakura_thread.h \
     processing/subtree_queue.h \
     processing/thread_pool.h \
@@ -49,13 +58,22 @@ HEADERS += \
 
 SOURCES += \
     items/item_methods.cpp \
+    items/error_container.cpp \
+    items/json_path_scanner.cpp \
     sakura_garden.cpp \
     items/sakura_items.cpp \
     items/value_item_functions.cpp \
     items/value_item_map.cpp \
+    optimizer/constant_folding.cpp \
+    optimizer/dependency_analysis.cpp \
+    parsing/parse_cache.cpp \
     parsing/sakura_parser_interface.cpp \
     parsing/sakura_parsing.cpp \
     blossom.cpp \
+    processing/blossom_cache.cpp \
+    processing/blossom_trace.cpp \
+    processing/cpu_topology.cpp \
+    processing/loop_source.cpp \
     processing/sakura_thread.cpp \
     processing/subtree_queue.cpp \
     processing/thread_pool.cpp \
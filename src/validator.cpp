@@ -23,7 +23,12 @@
 #include "validator.h"
 
 #include <items/item_methods.h>
+#include <items/error_container.h>
 #include <sakura_garden.h>
+#include <optimizer/dependency_analysis.h>
+#include <optimizer/constant_folding.h>
+#include <processing/subtree_queue.h>
+#include <processing/sakura_thread.h>
 
 #include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
 #include <libKitsunemimiSakuraLang/blossom.h>
@@ -35,14 +40,39 @@ namespace Sakura
 
 /**
  * @brief constructor
+ *
+ * @param interface pointer to the interface, which contains the garden and the blossoms
+ * @param garden garden to resolve resources, if the trees should not be checked against the
+ *               garden of the interface, like for staged trees. nullptr to use the garden of
+ *               the interface.
  */
-Validator::Validator() {}
+Validator::Validator(SakuraLangInterface* interface,
+                     SakuraGarden* garden)
+{
+    m_interface = interface;
+    m_garden = garden;
+}
 
 /**
  * @brief destructor
  */
 Validator::~Validator() {}
 
+/**
+ * @brief get the garden to resolve resources
+ *
+ * @return garden of the validator, or the garden of the interface, if not set
+ */
+SakuraGarden*
+Validator::getGarden() const
+{
+    if(m_garden != nullptr) {
+        return m_garden;
+    }
+
+    return m_interface->m_garden;
+}
+
 /**
  * @brief check content of a blossom-item
  *
@@ -57,16 +87,13 @@ Validator::checkBlossomItem(BlossomItem &blossomItem,
                             const std::string &filePath,
                             std::string &errorMessage)
 {
-    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
-
     // check if the object is a resource and skip check
-    TreeItem* item = interface->m_garden->getRessource(blossomItem.blossomType);
-    if(item != nullptr) {
+    if(getGarden()->containsRessource(blossomItem.blossomType)) {
         return true;
     }
 
     // get blossom by type and group-type
-    Blossom* blossom = interface->getBlossom(blossomItem.blossomGroupType,
+    Blossom* blossom = m_interface->getBlossom(blossomItem.blossomGroupType,
                                                blossomItem.blossomType);
     if(blossom == nullptr)
     {
@@ -74,6 +101,9 @@ Validator::checkBlossomItem(BlossomItem &blossomItem,
         return false;
     }
 
+    // the dependency-analysis must not reorder calls of blossoms with side-effects
+    blossomItem.isPure = blossom->isPure;
+
     return blossom->validateInput(blossomItem, filePath, errorMessage);
 }
 
@@ -91,6 +121,24 @@ Validator::checkSakuraItem(SakuraItem* sakuraItem,
                            const std::string &filePath,
                            std::string &errorMessage)
 {
+    // reductions are only allowed in the header of loops, where they are already separated from
+    // the normal values by the parser
+    std::map<std::string, ValueItem>::const_iterator it;
+    for(it = sakuraItem->values.m_valueMap.begin();
+        it != sakuraItem->values.m_valueMap.end();
+        it++)
+    {
+        if(it->second.type == ValueItem::REDUCE_PAIR_TYPE)
+        {
+            errorMessage = createError(*sakuraItem,
+                                       filePath,
+                                       "validator",
+                                       "reduce-value \"" + it->first + "\" is only allowed "
+                                       "in the header of a loop");
+            return false;
+        }
+    }
+
     //----------------------------------------------------------------------------------------------
     if(sakuraItem->getType() == SakuraItem::SEQUENTIELL_ITEM)
     {
@@ -104,6 +152,13 @@ Validator::checkSakuraItem(SakuraItem* sakuraItem,
                 return false;
             }
         }
+
+        // analyse the dependencies between the childs after the check, because the check
+        // completes the values of the blossoms
+        createDependencyLevels(sequential->dependencyLevels,
+                               sequential->childs,
+                               getGarden());
+
         return true;
     }
     //----------------------------------------------------------------------------------------------
@@ -206,32 +261,116 @@ Validator::checkSakuraItem(SakuraItem* sakuraItem,
 }
 
 /**
- * @brief check all blossom-items of all parsed trees
+ * @brief check all blossom-items of new parsed trees and optimize the trees, before they are
+ *        added to the garden. The trees are added as tasks to the queue of the interface, so
+ *        they are distributed over the worker-threads of the thread-pool, and the errors of all
+ *        invalid trees are collected.
  *
+ * @param trees map with the trees to check
  * @param errorMessage reference for error-message
  *
  * @return true, if check successful, else false
  */
 bool
-Validator::checkAllItems(std::string &errorMessage)
+Validator::checkAllItems(std::map<std::string, TreeItem*> &trees,
+                         std::string &errorMessage)
 {
-    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    SubtreeQueue* queue = m_interface->m_queue;
+    std::vector<std::string> errors(trees.size(), "");
 
+    SubtreeQueue::RunContext runContext;
+    runContext.interface = m_interface;
+    runContext.runId = queue->createRunId();
+
+    SubtreeQueue::ActiveCounter activeCounter;
+    activeCounter.shouldCount = static_cast<uint32_t>(trees.size());
+
+    // create one task per tree
+    std::vector<SubtreeQueue::SubtreeObject*> taskObjects;
     std::map<std::string, TreeItem*>::const_iterator mapIt;
-    for(mapIt = interface->m_garden->m_trees.begin();
-        mapIt != interface->m_garden->m_trees.end();
+    for(mapIt = trees.begin();
+        mapIt != trees.end();
         mapIt++)
     {
-        if(checkSakuraItem(mapIt->second,
-                           mapIt->second->relativePath,
-                           errorMessage) == false)
+        TreeItem* tree = mapIt->second;
+        std::string* treeError = &errors[taskObjects.size()];
+
+        SubtreeQueue::SubtreeObject* object = new SubtreeQueue::SubtreeObject();
+        object->runContext = &runContext;
+        object->activeCounter = &activeCounter;
+        object->task = [this, tree, treeError]() { checkTree(tree, *treeError); };
+        queue->addSubtreeObject(object);
+        taskObjects.push_back(object);
+    }
+
+    // the calling thread also takes tasks of the validation, so the validation doesn't
+    // depend on free worker-threads, for example when called within a blossom
+    while(activeCounter.isEqual() == false)
+    {
+        SubtreeQueue::SubtreeObject* object = queue->getSubtreeObject(runContext.runId);
+        if(object != nullptr)
         {
-            return false;
+            SakuraThread::processTaskObject(object);
+            continue;
         }
+
+        activeCounter.waitUntilEqual(chronoMilliSec(1));
+    }
+
+    for(SubtreeQueue::SubtreeObject* object : taskObjects) {
+        delete object;
+    }
+
+    // collect all errors. The errors are chains of error-records, which already begin with the
+    // record-separator, so they can be simply appended without any additional separator.
+    std::string collectedErrors = "";
+    for(const std::string &error : errors)
+    {
+        if(error.size() == 0) {
+            continue;
+        }
+
+        if(error.at(0) == ERROR_RECORD_SEPARATOR) {
+            collectedErrors += error;
+        } else {
+            collectedErrors += createError("validator", error);
+        }
+    }
+
+    if(collectedErrors.size() > 0)
+    {
+        errorMessage = collectedErrors;
+        return false;
     }
 
     return true;
 }
 
+/**
+ * @brief check and optimize a single tree. This function is executed by multiple threads at
+ *        the same time for different trees.
+ *
+ * @param tree tree to check
+ * @param errorMessage reference for error-message
+ */
+void
+Validator::checkTree(TreeItem* tree,
+                     std::string &errorMessage)
+{
+    if(checkSakuraItem(tree, tree->relativePath, errorMessage))
+    {
+        FoldingStats stats;
+        optimizeTree(tree, getGarden(), stats);
+        m_interface->addFoldingStats(stats);
+    }
+    else if(errorMessage.size() == 0)
+    {
+        errorMessage = createError(*tree,
+                                   tree->relativePath,
+                                   "validator",
+                                   "validation of " + tree->relativePath + " failed");
+    }
+}
+
 } // namespace Sakura
 } // namespace Kitsunemimi
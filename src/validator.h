@@ -25,6 +25,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 namespace Kitsunemimi
 {
@@ -33,11 +34,14 @@ namespace Sakura
 class SakuraLangInterface;
 class BlossomItem;
 class SakuraItem;
+class TreeItem;
+class SakuraGarden;
 
 class Validator
 {
 public:
-    Validator();
+    Validator(SakuraLangInterface* interface,
+              SakuraGarden* garden = nullptr);
     ~Validator();
 
     bool checkBlossomItem(BlossomItem &blossomItem,
@@ -47,7 +51,17 @@ public:
     bool checkSakuraItem(SakuraItem* sakuraItem,
                          const std::string &filePath,
                          std::string &errorMessage);
-    bool checkAllItems(std::string &errorMessage);
+    bool checkAllItems(std::map<std::string, TreeItem*> &trees,
+                       std::string &errorMessage);
+
+private:
+    SakuraLangInterface* m_interface = nullptr;
+    SakuraGarden* m_garden = nullptr;
+
+    SakuraGarden* getGarden() const;
+
+    void checkTree(TreeItem* tree,
+                   std::string &errorMessage);
 };
 
 } // namespace Sakura
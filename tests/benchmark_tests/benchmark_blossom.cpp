@@ -0,0 +1,25 @@
+#include "benchmark_blossom.h"
+
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+BenchmarkBlossom::BenchmarkBlossom()
+    : Blossom()
+{
+    validationMap.emplace("output", BlossomValidDef(IO_ValueType::OUTPUT_TYPE, true));
+    allowUnmatched = true;
+}
+
+bool
+BenchmarkBlossom::runTask(BlossomLeaf &blossomLeaf, std::string &)
+{
+    blossomLeaf.output.insert("output", new Kitsunemimi::DataValue(42));
+    return true;
+}
+
+}
+}
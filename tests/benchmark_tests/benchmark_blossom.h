@@ -0,0 +1,24 @@
+#ifndef BENCHMARK_BLOSSOM_H
+#define BENCHMARK_BLOSSOM_H
+
+#include <libKitsunemimiSakuraLang/blossom.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+class BenchmarkBlossom
+        : public Blossom
+{
+public:
+    BenchmarkBlossom();
+
+protected:
+    bool runTask(BlossomLeaf &blossomLeaf, std::string &);
+};
+
+}
+}
+
+#endif // BENCHMARK_BLOSSOM_H
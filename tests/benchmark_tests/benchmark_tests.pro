@@ -0,0 +1,44 @@
+include(../../defaults.pri)
+
+QT -= qt core gui
+
+CONFIG   -= app_bundle
+CONFIG += c++14 console
+
+LIBS += -L../../src -lKitsunemimiSakuraLang
+INCLUDEPATH += $$PWD
+
+LIBS += -L../../../libKitsunemimiCommon/src -lKitsunemimiCommon
+LIBS += -L../../../libKitsunemimiCommon/src/debug -lKitsunemimiCommon
+LIBS += -L../../../libKitsunemimiCommon/src/release -lKitsunemimiCommon
+INCLUDEPATH += ../../../libKitsunemimiCommon/include
+
+LIBS += -L../../../libKitsunemimiPersistence/src -lKitsunemimiPersistence
+LIBS += -L../../../libKitsunemimiPersistence/src/debug -lKitsunemimiPersistence
+LIBS += -L../../../libKitsunemimiPersistence/src/release -lKitsunemimiPersistence
+INCLUDEPATH += ../../../libKitsunemimiPersistence/include
+
+LIBS += -L../../../libKitsunemimiJinja2/src -lKitsunemimiJinja2
+LIBS += -L../../../libKitsunemimiJinja2/src/debug -lKitsunemimiJinja2
+LIBS += -L../../../libKitsunemimiJinja2/src/release -lKitsunemimiJinja2
+INCLUDEPATH += ../../../libKitsunemimiJinja2/include
+
+LIBS += -L../../../libKitsunemimiJson/src -lKitsunemimiJson
+LIBS += -L../../../libKitsunemimiJson/src/debug -lKitsunemimiJson
+LIBS += -L../../../libKitsunemimiJson/src/release -lKitsunemimiJson
+INCLUDEPATH += ../../../libKitsunemimiJson/include
+
+
+LIBS +=  -lboost_filesystem -lboost_system
+
+
+SOURCES += \
+    main.cpp \
+    benchmark_blossom.cpp \
+    parsing_benchmark.cpp \
+    processing_benchmark.cpp
+
+HEADERS += \
+    benchmark_blossom.h \
+    parsing_benchmark.h \
+    processing_benchmark.h
@@ -0,0 +1,117 @@
+/**
+ * @file    parsing_benchmark.cpp
+ *
+ * @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "parsing_benchmark.h"
+
+#include <iostream>
+#include <chrono>
+
+#include <benchmark_blossom.h>
+
+#include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief Parsing_Benchmark::Parsing_Benchmark
+ */
+Parsing_Benchmark::Parsing_Benchmark()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    if(interface->doesBlossomExist("benchmark", "write_back") == false) {
+        interface->addBlossom("benchmark", "write_back", new BenchmarkBlossom());
+    }
+
+    largeFile_benchmark();
+}
+
+/**
+ * @brief measure the throughput of parsing and validating large generated trees
+ */
+void
+Parsing_Benchmark::largeFile_benchmark()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    // disable cache, because otherwise only the first run would be measured
+    interface->setParseCacheSize(0);
+
+    for(const uint64_t sizeInMb : {1u, 4u, 16u})
+    {
+        const std::string tree = getLargeTree(sizeInMb * 1024 * 1024);
+        std::string errorMessage = "";
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const bool ret = interface->addTree("large-" + std::to_string(sizeInMb),
+                                            tree,
+                                            errorMessage);
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        if(ret == false)
+        {
+            std::cout<<"large file benchmark failed: "<<errorMessage<<std::endl;
+            return;
+        }
+
+        const double duration = std::chrono::duration<double>(end - start).count();
+        const double sizeOfTree = static_cast<double>(tree.size()) / (1024.0 * 1024.0);
+        std::cout<<"parse tree with "<<sizeOfTree<<" MiB: "
+                 <<(sizeOfTree / duration)<<" MiB/s"<<std::endl;
+    }
+}
+
+/**
+ * @brief create a tree with many blossom-calls
+ *
+ * @param minSize minimum size of the tree in bytes
+ *
+ * @return tree as string
+ */
+const std::string
+Parsing_Benchmark::getLargeTree(const uint64_t minSize)
+{
+    std::string tree = "[\"large\"]\n";
+    tree += "- test_output = 0\n";
+    tree += "- input = \"" + std::string(64, 'x') + "\"\n";
+    tree += "\n";
+
+    uint64_t counter = 0;
+    while(tree.size() < minSize)
+    {
+        const std::string number = std::to_string(counter);
+        tree += "benchmark(\"call_" + number + "\")\n";
+        tree += "->write_back:\n";
+        tree += "   - input = input\n";
+        tree += "   - value_" + number + " = \"this is value " + number + "\"\n";
+        tree += "   - output >> test_output\n";
+        tree += "\n";
+        counter++;
+    }
+
+    return tree;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,48 @@
+/**
+ * @file    parsing_benchmark.h
+ *
+ * @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef PARSING_BENCHMARK_H
+#define PARSING_BENCHMARK_H
+
+#include <string>
+#include <stdint.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+class Parsing_Benchmark
+{
+public:
+    Parsing_Benchmark();
+
+    void largeFile_benchmark();
+
+private:
+    const std::string getLargeTree(const uint64_t minSize);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // PARSING_BENCHMARK_H
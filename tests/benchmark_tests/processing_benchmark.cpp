@@ -0,0 +1,189 @@
+/**
+ * @file    processing_benchmark.cpp
+ *
+ * @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "processing_benchmark.h"
+
+#include <iostream>
+#include <chrono>
+
+#include <benchmark_blossom.h>
+
+#include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief Processing_Benchmark::Processing_Benchmark
+ */
+Processing_Benchmark::Processing_Benchmark()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    interface->addBlossom("benchmark", "write_back", new BenchmarkBlossom());
+
+    wideValueMap_benchmark();
+    scopeRestore_benchmark();
+}
+
+/**
+ * @brief measure the overhead of blossom-calls with many values, which have to be filled into the
+ *        blossom and written back into the parent-values
+ */
+void
+Processing_Benchmark::wideValueMap_benchmark()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    const uint32_t numberOfCalls = 1000;
+
+    for(const uint32_t numberOfValues : {1u, 10u, 100u})
+    {
+        const std::string tree = getWideValueMapTree(numberOfValues, numberOfCalls);
+        std::string errorMessage = "";
+        DataMap result;
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const bool ret = interface->runTree(result,
+                                            "wide-" + std::to_string(numberOfValues),
+                                            tree,
+                                            DataMap(),
+                                            errorMessage);
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        if(ret == false)
+        {
+            std::cout<<"wide value-map benchmark failed: "<<errorMessage<<std::endl;
+            return;
+        }
+
+        const double duration = std::chrono::duration<double, std::micro>(end - start).count();
+        std::cout<<"blossom-call with "<<numberOfValues<<" values: "
+                 <<(duration / numberOfCalls)<<" us"<<std::endl;
+    }
+}
+
+/**
+ * @brief measure the overhead of entering and leaving the scope of a loop, while the parent has
+ *        many values, which have to be restored after the loop
+ */
+void
+Processing_Benchmark::scopeRestore_benchmark()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    const uint32_t numberOfLoops = 1000;
+
+    for(const uint32_t numberOfValues : {1u, 10u, 100u})
+    {
+        const std::string tree = getScopeRestoreTree(numberOfValues, numberOfLoops);
+        std::string errorMessage = "";
+        DataMap result;
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const bool ret = interface->runTree(result,
+                                            "scope-" + std::to_string(numberOfValues),
+                                            tree,
+                                            DataMap(),
+                                            errorMessage);
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        if(ret == false)
+        {
+            std::cout<<"scope-restore benchmark failed: "<<errorMessage<<std::endl;
+            return;
+        }
+
+        const double duration = std::chrono::duration<double, std::micro>(end - start).count();
+        std::cout<<"loop-scope with "<<numberOfValues<<" values: "
+                 <<(duration / numberOfLoops)<<" us"<<std::endl;
+    }
+}
+
+/**
+ * @brief create a tree, which calls a blossom within a loop and gives it a wide value-map
+ *
+ * @param numberOfValues number of values of the tree, which are all given to the blossom
+ * @param numberOfCalls number of iterations of the loop
+ *
+ * @return tree as string
+ */
+const std::string
+Processing_Benchmark::getWideValueMapTree(const uint32_t numberOfValues,
+                                          const uint32_t numberOfCalls)
+{
+    std::string tree = "[\"wide\"]\n";
+    tree += "- test_output = 0\n";
+    for(uint32_t i = 0; i < numberOfValues; i++) {
+        tree += "- value_" + std::to_string(i) + " = \"" + std::string(256, 'x') + "\"\n";
+    }
+
+    tree += "\n";
+    tree += "for(i = 0; i < " + std::to_string(numberOfCalls) + "; i++)\n";
+    tree += "{\n";
+    tree += "    benchmark(\"call\")\n";
+    tree += "    ->write_back:\n";
+    for(uint32_t i = 0; i < numberOfValues; i++) {
+        tree += "       - value_" + std::to_string(i) + " = value_" + std::to_string(i) + "\n";
+    }
+    tree += "       - output >> test_output\n";
+    tree += "}\n";
+
+    return tree;
+}
+
+/**
+ * @brief create a tree, which runs an inner loop within an outer loop, so the scope of the
+ *        inner loop is entered and left once per iteration of the outer loop. The inner loop has
+ *        too many iterations to be unrolled by the constant-folding.
+ *
+ * @param numberOfValues number of values of the tree, which are visible within the loops
+ * @param numberOfLoops number of iterations of the outer loop
+ *
+ * @return tree as string
+ */
+const std::string
+Processing_Benchmark::getScopeRestoreTree(const uint32_t numberOfValues,
+                                          const uint32_t numberOfLoops)
+{
+    std::string tree = "[\"scope\"]\n";
+    tree += "- test_output = 0\n";
+    for(uint32_t i = 0; i < numberOfValues; i++) {
+        tree += "- value_" + std::to_string(i) + " = \"" + std::string(256, 'x') + "\"\n";
+    }
+
+    tree += "\n";
+    tree += "for(i = 0; i < " + std::to_string(numberOfLoops) + "; i++)\n";
+    tree += "{\n";
+    tree += "    for(j = 0; j < 5; j++)\n";
+    tree += "    {\n";
+    tree += "        benchmark(\"call\")\n";
+    tree += "        ->write_back:\n";
+    tree += "           - output >> test_output\n";
+    tree += "    }\n";
+    tree += "}\n";
+
+    return tree;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
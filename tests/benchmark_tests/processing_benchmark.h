@@ -0,0 +1,52 @@
+/**
+ * @file    processing_benchmark.h
+ *
+ * @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef PROCESSING_BENCHMARK_H
+#define PROCESSING_BENCHMARK_H
+
+#include <string>
+#include <stdint.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+class Processing_Benchmark
+{
+public:
+    Processing_Benchmark();
+
+    void wideValueMap_benchmark();
+    void scopeRestore_benchmark();
+
+private:
+    const std::string getWideValueMapTree(const uint32_t numberOfValues,
+                                          const uint32_t numberOfCalls);
+    const std::string getScopeRestoreTree(const uint32_t numberOfValues,
+                                          const uint32_t numberOfLoops);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // PROCESSING_BENCHMARK_H
@@ -22,6 +22,9 @@
 
 #include "interface_test.h"
 
+#include <thread>
+#include <atomic>
+
 #include <test_blossom.h>
 
 #include <libKitsunemimiSakuraLang/sakura_lang_interface.h>
@@ -44,6 +47,29 @@ Interface_Test::Interface_Test() :
     blossomMethods_test();
     addAndGet_test();
     runAndTrigger_test();
+    reduce_test();
+    threadPool_test();
+    multipleInterfaces_test();
+    priority_test();
+    constantFolding_test();
+    compare_test();
+    setFunctions_test();
+    splitLoop_test();
+    jsonPath_test();
+    reload_test();
+    parseCache_test();
+    subtree_test();
+    sourceSpan_test();
+    jsonError_test();
+    trace_test();
+    blossomCache_test();
+    batch_test();
+    parallelChanges_test();
+    nestedAutoParallel_test();
+    scopeLeak_test();
+    consumedInput_test();
+    concurrentRuns_test();
+    collectedErrors_test();
 }
 
 /**
@@ -142,20 +168,1454 @@ Interface_Test::runAndTrigger_test()
 }
 
 /**
- * @brief Session_Test::getTestTree
- * @return
+ * @brief Interface_Test::reduce_test
  */
-const std::string
-Interface_Test::getTestTree()
+void
+Interface_Test::reduce_test()
 {
-    const std::string tree = "[\"test\"]\n"
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    inputValues.insert("sum_output", new DataValue(0));
+    inputValues.insert("count_output", new DataValue(0));
+    inputValues.insert("parallel_output", new DataValue(0));
+    inputValues.insert("list_output", new DataValue(""));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "reduce-test",
+                                  getReduceTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("sum_output")->toValue()->getInt(), 420);
+    TEST_EQUAL(result.get("count_output")->toValue()->getInt(), 10);
+    TEST_EQUAL(result.get("parallel_output")->toValue()->getInt(), 84);
+
+    // the partial results of the parallel iterations are appended in the order of the
+    // iterations and not in the order, in which the worker-threads have finished them
+    DataItem* listOutput = result.get("list_output");
+    TEST_EQUAL(listOutput->isArray(), true);
+    if(listOutput->isArray() == false) {
+        return;
+    }
+
+    TEST_EQUAL(listOutput->size(), 10);
+    for(uint64_t i = 0; i < listOutput->size(); i++) {
+        TEST_EQUAL(listOutput->get(i)->toValue()->getLong(), static_cast<long>(i));
+    }
+}
+
+/**
+ * @brief Interface_Test::threadPool_test
+ */
+void
+Interface_Test::threadPool_test()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    // test setNumberOfThreads
+    TEST_EQUAL(interface->setNumberOfThreads(0), false);
+    TEST_EQUAL(interface->setNumberOfThreads(4, 2), false);
+    TEST_EQUAL(interface->setNumberOfThreads(2), true);
+    TEST_EQUAL(interface->getNumberOfThreads(), 2);
+    TEST_EQUAL(interface->setNumberOfThreads(3, 8), true);
+    TEST_EQUAL(interface->getNumberOfThreads(), 3);
+
+    // run tree with pinned threads
+    interface->setCpuPinning(true);
+    reduce_test();
+    interface->setCpuPinning(false);
+
+    // run tree with parallel processing of independent blossom-groups
+    interface->setAutoParallelization(true);
+    reduce_test();
+    runAndTrigger_test();
+    interface->setAutoParallelization(false);
+
+    TEST_EQUAL(interface->setNumberOfThreads(6), true);
+    TEST_EQUAL(interface->getNumberOfThreads(), 6);
+}
+
+/**
+ * @brief Interface_Test::multipleInterfaces_test
+ */
+void
+Interface_Test::multipleInterfaces_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+
+    // independent interface doesn't know the blossoms of the default-instance
+    SakuraLangInterface* independent = new SakuraLangInterface(2);
+    DataMap result;
+    TEST_EQUAL(independent->runTree(result, "run-test", getTestTree(), inputValues, errorMessage),
+               false);
+
+    // interface with shared thread-pool and its own blossoms
+    SakuraLangInterface* shared = new SakuraLangInterface(independent);
+    TEST_EQUAL(shared->addBlossom("test1", "test2", new TestBlossom(this)), true);
+    TEST_EQUAL(shared->getNumberOfThreads(), 2);
+    TEST_EQUAL(shared->runTree(result, "run-test", getTestTree(), inputValues, errorMessage),
+               true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    // trees are only stored in the garden of the interface, where they were added
+    TEST_EQUAL(shared->addTree("shared-tree", getTestTree(), errorMessage), true);
+    TEST_EQUAL(independent->triggerTree(result, "shared-tree", inputValues, errorMessage), false);
+    TEST_EQUAL(shared->triggerTree(result, "shared-tree", inputValues, errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    delete shared;
+    delete independent;
+}
+
+/**
+ * @brief Interface_Test::priority_test
+ */
+void
+Interface_Test::priority_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    SakuraLangInterface* interface = new SakuraLangInterface(2);
+    interface->addBlossom("test1", "test2", new TestBlossom(this));
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "run-test",
+                                  getTestTree(),
+                                  inputValues,
+                                  errorMessage,
+                                  SakuraLangInterface::INTERACTIVE_PRIORITY), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    // the run is scheduled with its own priority-class
+    DataMap metrics;
+    interface->getSchedulingMetrics(metrics);
+    TEST_EQUAL(metrics.get("interactive")->get("processed_subtrees")->getLong(), 1);
+
+    delete interface;
+}
+
+/**
+ * @brief Interface_Test::constantFolding_test
+ */
+void
+Interface_Test::constantFolding_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    inputValues.insert("counter_output", new DataValue(0));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    DataMap oldMetrics;
+    interface->getFoldingMetrics(oldMetrics);
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "folding-test",
+                                  getFoldingTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    // the counter-variable is still available within the unrolled loop
+    TEST_EQUAL(result.get("counter_output")->toValue()->getInt(), 42);
+
+    DataMap newMetrics;
+    interface->getFoldingMetrics(newMetrics);
+    TEST_EQUAL(newMetrics.get("folded_values")->toValue()->getLong()
+               - oldMetrics.get("folded_values")->toValue()->getLong(), 1);
+    TEST_EQUAL(newMetrics.get("pruned_branches")->toValue()->getLong()
+               - oldMetrics.get("pruned_branches")->toValue()->getLong(), 1);
+    TEST_EQUAL(newMetrics.get("unrolled_loops")->toValue()->getLong()
+               - oldMetrics.get("unrolled_loops")->toValue()->getLong(), 2);
+    TEST_EQUAL(newMetrics.get("removed_loops")->toValue()->getLong()
+               - oldMetrics.get("removed_loops")->toValue()->getLong(), 1);
+}
+
+/**
+ * @brief Interface_Test::compare_test
+ */
+void
+Interface_Test::compare_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    inputValues.insert("jinja_output", new DataValue(0));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "compare-test",
+                                  getCompareTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    // rendered jinja2-strings, which contain only a number, are compared as number
+    TEST_EQUAL(result.get("jinja_output")->toValue()->getInt(), 42);
+}
+
+/**
+ * @brief Interface_Test::setFunctions_test
+ */
+void
+Interface_Test::setFunctions_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "set-test",
+                                  getSetFunctionsTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+}
+
+/**
+ * @brief Interface_Test::splitLoop_test
+ */
+void
+Interface_Test::splitLoop_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    inputValues.insert("count_output", new DataValue(0));
+    inputValues.insert("sum_output", new DataValue(0));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "split-test",
+                                  getSplitLoopTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("count_output")->toValue()->getInt(), 3);
+    TEST_EQUAL(result.get("sum_output")->toValue()->getInt(), 126);
+
+    // a loop can not iterate over the parts of a number
+    const std::string numberTree = "[\"split-number\"]\n"
+                                   "- input = \"{{}}\"\n"
+                                   "- test_output = \"\"\n"
+                                   "\n"
+                                   "for(part : input.split(\",\"))\n"
+                                   "{\n"
+                                   "    test1(\"split\")\n"
+                                   "    ->test2:\n"
+                                   "       - input = input\n"
+                                   "       - output >> test_output\n"
+                                   "}\n";
+    TEST_EQUAL(interface->runTree(result,
+                                  "split-number-test",
+                                  numberTree,
+                                  inputValues,
+                                  errorMessage), false);
+}
+
+/**
+ * @brief Interface_Test::jsonPath_test
+ */
+void
+Interface_Test::jsonPath_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    inputValues.insert("json", new DataValue("{\"a\": {\"b\": [1, \"x]\", 42]},"
+                                             " \"c\": {\"d\": \"}\"}}"));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "json-test",
+                                  getJsonPathTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    // a map can not be used as key and must fail like the get-function without parse_json
+    DataMap keyValues;
+    keyValues.insert("input", new DataValue(42));
+    keyValues.insert("test_output", new DataValue(""));
+    keyValues.insert("json", new DataValue("{\"a\": 42}"));
+    keyValues.insert("key", new DataMap());
+    DataMap failedResult;
+    errorMessage = "";
+    TEST_EQUAL(interface->runTree(failedResult,
+                                  "json-key-test",
+                                  getJsonPathKeyTestTree(),
+                                  keyValues,
+                                  errorMessage), false);
+    const bool containsError = errorMessage.find("inputs for get-function are invalid")
+                               != std::string::npos;
+    TEST_EQUAL(containsError, true);
+}
+
+/**
+ * @brief Interface_Test::reload_test
+ */
+void
+Interface_Test::reload_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(0));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    const bfs::path dirPath = bfs::temp_directory_path() / "sakura_reload_test";
+    const bfs::path filePath = dirPath / "reload.sakura";
+    bfs::create_directories(dirPath);
+
+    // initial version
+    Persistence::writeFile(filePath.string(), getReloadTestTree("a"), errorMessage);
+    TEST_EQUAL(interface->readFiles(filePath.string(), errorMessage), true);
+    DataMap result;
+    TEST_EQUAL(interface->triggerTree(result, "reload.sakura", inputValues, errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 0);
+
+    // nothing changed
+    TEST_EQUAL(interface->reloadFiles(errorMessage), true);
+
+    // changed version with the old timestamp, because the content is compared
+    const std::time_t lastWriteTime = bfs::last_write_time(filePath);
+    Persistence::writeFile(filePath.string(), getReloadTestTree("b"), errorMessage);
+    bfs::last_write_time(filePath, lastWriteTime);
+    TEST_EQUAL(interface->reloadFiles(errorMessage), true);
+    DataMap newResult;
+    TEST_EQUAL(interface->triggerTree(newResult, "reload.sakura", inputValues, errorMessage), true);
+    TEST_EQUAL(newResult.get("test_output")->toValue()->getInt(), 42);
+
+    // broken version must not replace the last valid one
+    Persistence::writeFile(filePath.string(), "broken", errorMessage);
+    TEST_EQUAL(interface->reloadFiles(errorMessage), false);
+    DataMap brokenResult;
+    TEST_EQUAL(interface->triggerTree(brokenResult, "reload.sakura", inputValues, errorMessage), true);
+    TEST_EQUAL(brokenResult.get("test_output")->toValue()->getInt(), 42);
+
+    bfs::remove_all(dirPath);
+
+    // files of an invalid tree must not be added, but they must be added, when the tree is valid
+    const bfs::path stagingDirPath = bfs::temp_directory_path() / "sakura_staging_test";
+    const bfs::path stagingFilePath = stagingDirPath / "staging.sakura";
+    bfs::create_directories(stagingDirPath / "files");
+    Persistence::writeFile((stagingDirPath / "files" / "data.txt").string(), "data", errorMessage);
+
+    const std::string invalidTree = "[\"staging\"]\n"
+                                    "- test_output = 0\n"
+                                    "\n"
+                                    "test1(\"staging\")\n"
+                                    "->does_not_exist:\n"
+                                    "   - output >> test_output\n";
+    Persistence::writeFile(stagingFilePath.string(), invalidTree, errorMessage);
+    TEST_EQUAL(interface->readFiles(stagingFilePath.string(), errorMessage), false);
+    const bool fileIsStaged = interface->getFile("files/data.txt") == nullptr;
+    TEST_EQUAL(fileIsStaged, true);
+
+    Persistence::writeFile(stagingFilePath.string(), getReloadTestTree("a"), errorMessage);
+    TEST_EQUAL(interface->readFiles(stagingFilePath.string(), errorMessage), true);
+    const bool fileIsPublished = interface->getFile("files/data.txt") != nullptr;
+    TEST_EQUAL(fileIsPublished, true);
+
+    bfs::remove_all(stagingDirPath);
+}
+
+/**
+ * @brief Interface_Test::parseCache_test
+ */
+void
+Interface_Test::parseCache_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    // the first run caches the tree and the second one uses it
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result, "cache-test", getTestTree(), inputValues, errorMessage),
+               true);
+    DataMap oldMetrics;
+    interface->getParseCacheMetrics(oldMetrics);
+    const long oldHits = oldMetrics.get("hits")->toValue()->getLong();
+    const long oldMisses = oldMetrics.get("misses")->toValue()->getLong();
+
+    TEST_EQUAL(interface->runTree(result, "cache-test", getTestTree(), inputValues, errorMessage),
+               true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+
+    DataMap newMetrics;
+    interface->getParseCacheMetrics(newMetrics);
+    TEST_EQUAL(newMetrics.get("hits")->toValue()->getLong(), oldHits + 1);
+
+    // a new resource can change the validation of the same content, so it must be validated again
+    const bfs::path dirPath = bfs::temp_directory_path() / "sakura_cache_test";
+    bfs::create_directories(dirPath / "resources");
+    Persistence::writeFile((dirPath / "cache.sakura").string(),
+                           getReloadTestTree("a"),
+                           errorMessage);
+    Persistence::writeFile((dirPath / "resources" / "resource.sakura").string(),
+                           "[\"cache_resource\"]\n"
+                           "- test_output = 0\n"
+                           "\n"
+                           "test1(\"resource\")\n"
+                           "->test2:\n"
+                           "   - input = 42\n"
+                           "   - output >> test_output\n",
+                           errorMessage);
+    TEST_EQUAL(interface->readFiles((dirPath / "cache.sakura").string(), errorMessage), true);
+    bfs::remove_all(dirPath);
+
+    TEST_EQUAL(interface->runTree(result, "cache-test", getTestTree(), inputValues, errorMessage),
+               true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+    interface->getParseCacheMetrics(newMetrics);
+    TEST_EQUAL(newMetrics.get("hits")->toValue()->getLong(), oldHits + 1);
+    TEST_EQUAL(newMetrics.get("misses")->toValue()->getLong(), oldMisses + 1);
+}
+
+/**
+ * @brief Interface_Test::subtree_test
+ */
+void
+Interface_Test::subtree_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    // calls the tree, which was added in addAndGet_test, multiple times
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "subtree-test",
+                                  getSubtreeTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+}
+
+/**
+ * @brief Interface_Test::sourceSpan_test
+ */
+void
+Interface_Test::sourceSpan_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    const std::string tree = "[\"span\"]\n"
                              "- input = \"{{}}\"\n"
-                             "- test_output = \"\"\n"
                              "\n"
-                             "test1(\"this is a test\")\n"
-                             "->test2:\n"
-                             "   - input = input\n"
-                             "   - output >> test_output\n";
+                             "subtree(\"does-not-exist\")\n"
+                             "- input = input\n";
+
+    // runtime-errors contain the position of the item, which has failed. The json-output is
+    // used, because it contains the fields without table-formatting.
+    interface->setJsonErrorOutput(true);
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result, "span-test", tree, inputValues, errorMessage), false);
+    interface->setJsonErrorOutput(false);
+    const bool containsLine = errorMessage.find("\"line-number\":\"4\"") != std::string::npos;
+    TEST_EQUAL(containsLine, true);
+    const bool containsColumn = errorMessage.find("\"position in line\":\"1\"")
+                                != std::string::npos;
+    TEST_EQUAL(containsColumn, true);
+}
+
+/**
+ * @brief Interface_Test::jsonError_test
+ */
+void
+Interface_Test::jsonError_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    SakuraLangInterface* interface = new SakuraLangInterface(1);
+
+    const std::string tree = "[\"json-error\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "\n"
+                             "subtree(\"does-not-exist\")\n"
+                             "- input = input\n";
+
+    // errors are returned as json-array with one object per error
+    interface->setJsonErrorOutput(true);
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result, "json-error", tree, inputValues, errorMessage), false);
+    TEST_EQUAL(errorMessage.front(), '[');
+    TEST_EQUAL(errorMessage.back(), ']');
+    const bool containsLine = errorMessage.find("\"line-number\"") != std::string::npos;
+    TEST_EQUAL(containsLine, true);
+
+    // internal separators don't leave the interface
+    const bool containsSeparator = errorMessage.find('\x1e') != std::string::npos;
+    TEST_EQUAL(containsSeparator, false);
+
+    delete interface;
+}
+
+/**
+ * @brief Interface_Test::trace_test
+ */
+void
+Interface_Test::trace_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    const bfs::path tracePath = bfs::temp_directory_path() / "sakura_trace_test.trace";
+
+    // record a run
+    TEST_EQUAL(interface->startTraceRecording(tracePath.string(), errorMessage), true);
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result, "trace-test", getTestTree(), inputValues, errorMessage),
+               true);
+    TEST_EQUAL(interface->stopTraceRecording(errorMessage), true);
+    TEST_EQUAL(interface->stopTraceRecording(errorMessage), false);
+
+    // replay the recorded run
+    TEST_EQUAL(interface->startTraceReplay(tracePath.string(), errorMessage), true);
+    DataMap replayResult;
+    TEST_EQUAL(interface->runTree(replayResult,
+                                  "trace-test",
+                                  getTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(replayResult.get("test_output")->toValue()->getInt(), 42);
+    interface->stopTraceReplay();
+
+    bfs::remove(tracePath);
+}
+
+/**
+ * @brief Interface_Test::blossomCache_test
+ */
+void
+Interface_Test::blossomCache_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(0));
+    SakuraLangInterface* interface = new SakuraLangInterface(1);
+    PureTestBlossom* pureBlossom = new PureTestBlossom();
+    TEST_EQUAL(interface->addBlossom("test1", "pure", pureBlossom), true);
+
+    // only the first iteration processes the blossom
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "blossom-cache-test",
+                                  getBlossomCacheTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 43);
+    TEST_EQUAL(pureBlossom->numberOfCalls, 1);
+
+    // the parent-values are not part of the cache-key, so pure blossoms don't get them
+    TEST_EQUAL(pureBlossom->numberOfParentAccesses, 0);
+
+    // disabled cache
+    interface->setBlossomCacheSize(0);
+    DataMap uncachedResult;
+    TEST_EQUAL(interface->runTree(uncachedResult,
+                                  "blossom-cache-test",
+                                  getBlossomCacheTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(pureBlossom->numberOfCalls, 4);
+
+    delete interface;
+}
+
+/**
+ * @brief Interface_Test::batch_test
+ */
+void
+Interface_Test::batch_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("test_output", new DataValue(0));
+    inputValues.insert("sum_output", new DataValue(0));
+    SakuraLangInterface* interface = new SakuraLangInterface(1);
+    BatchTestBlossom* batchBlossom = new BatchTestBlossom();
+    TEST_EQUAL(interface->addBlossom("test1", "batch", batchBlossom), true);
+
+    // 10 iterations are given to the blossom in batches of 4, 4 and 2 calls
+    interface->setBatchSize(4);
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "batch-test",
+                                  getBatchTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("sum_output")->toValue()->getInt(), 90);
+    TEST_EQUAL(batchBlossom->numberOfCalls, 10);
+    TEST_EQUAL(batchBlossom->numberOfBatches, 3);
+
+    // the parent-values are already changed by the following iterations of a batch
+    TEST_EQUAL(batchBlossom->numberOfParentAccesses, 0);
+
+    // disabled batches
+    interface->setBatchSize(1);
+    DataMap singleResult;
+    TEST_EQUAL(interface->runTree(singleResult,
+                                  "batch-test",
+                                  getBatchTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(singleResult.get("sum_output")->toValue()->getInt(), 90);
+    TEST_EQUAL(batchBlossom->numberOfCalls, 20);
+    TEST_EQUAL(batchBlossom->numberOfBatches, 3);
+
+    delete interface;
+}
+
+/**
+ * @brief Interface_Test::parallelChanges_test
+ */
+void
+Interface_Test::parallelChanges_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(""));
+    inputValues.insert("pure_output", new DataValue(1));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "parallel-changes-test",
+                                  getParallelChangesTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+
+    // the second child writes the original value again, but as last writer it still wins
+    // against the change of the first child
+    TEST_EQUAL(result.get("pure_output")->toValue()->getLong(), 1);
+
+    // values, which didn't exist before the parallel-block, are returned from all childs
+    TEST_EQUAL(result.contains("first_sum"), true);
+    TEST_EQUAL(result.contains("second_count"), true);
+    if(result.contains("first_sum") == false
+            || result.contains("second_count") == false)
+    {
+        return;
+    }
+
+    TEST_EQUAL(result.get("first_sum")->toValue()->getLong(), 42);
+    TEST_EQUAL(result.get("second_count")->toValue()->getLong(), 1);
+}
+
+/**
+ * @brief Interface_Test::nestedAutoParallel_test
+ */
+void
+Interface_Test::nestedAutoParallel_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("first_output", new DataValue(0));
+    inputValues.insert("second_output", new DataValue(0));
+    inputValues.insert("third_output", new DataValue(0));
+    inputValues.insert("fourth_output", new DataValue(0));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    // serial run as reference
+    DataMap serialResult;
+    TEST_EQUAL(interface->runTree(serialResult,
+                                  "nested-auto-parallel-test",
+                                  getNestedAutoParallelTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+
+    // with only a single worker-thread, the waiting thread has to process the spawned subtrees
+    // of the nested levels by itself
+    TEST_EQUAL(interface->setNumberOfThreads(1), true);
+    interface->setAutoParallelization(true);
+
+    DataMap parallelResult;
+    TEST_EQUAL(interface->runTree(parallelResult,
+                                  "nested-auto-parallel-test",
+                                  getNestedAutoParallelTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+
+    interface->setAutoParallelization(false);
+    TEST_EQUAL(interface->setNumberOfThreads(6), true);
+
+    TEST_EQUAL(parallelResult.toString(), serialResult.toString());
+    TEST_EQUAL(parallelResult.get("first_output")->toValue()->getLong(), 43);
+    TEST_EQUAL(parallelResult.get("fourth_output")->toValue()->getLong(), 43);
+}
+
+/**
+ * @brief Interface_Test::scopeLeak_test
+ */
+void
+Interface_Test::scopeLeak_test()
+{
+    std::string errorMessage = "";
+    DataMap inputValues;
+    inputValues.insert("test_output", new DataValue(0));
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    // with only a single worker-thread, both runs are processed by the same thread
+    TEST_EQUAL(interface->setNumberOfThreads(1), true);
+
+    DataMap writerResult;
+    TEST_EQUAL(interface->runTree(writerResult,
+                                  "scope-writer-test",
+                                  getScopeWriterTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(writerResult.get("test_output")->toValue()->getInt(), 42);
+
+    // the value of the first run must not be visible for the second one
+    DataMap checkResult;
+    errorMessage = "";
+    TEST_EQUAL(interface->runTree(checkResult,
+                                  "scope-check-test",
+                                  getScopeCheckTestTree(),
+                                  inputValues,
+                                  errorMessage), false);
+    const bool containsError = errorMessage.find("error processing if-condition")
+                               != std::string::npos;
+    TEST_EQUAL(containsError, true);
+
+    TEST_EQUAL(interface->setNumberOfThreads(6), true);
+}
+
+/**
+ * @brief Interface_Test::consumedInput_test
+ */
+void
+Interface_Test::consumedInput_test()
+{
+    std::string errorMessage = "";
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    TEST_EQUAL(interface->addBlossom("test1", "consume", new ConsumingTestBlossom()), true);
+
+    // the blossom removes its inputs, which must affect neither the parent-values nor the
+    // names of its outputs
+    DataMap inputValues;
+    inputValues.insert("input", new DataValue(42));
+    inputValues.insert("test_output", new DataValue(0));
+    inputValues.insert("check_output", new DataValue(0));
+
+    DataMap result;
+    TEST_EQUAL(interface->runTree(result,
+                                  "consumed-input-test",
+                                  getConsumedInputTestTree(),
+                                  inputValues,
+                                  errorMessage), true);
+    TEST_EQUAL(result.get("test_output")->toValue()->getInt(), 42);
+    TEST_EQUAL(result.get("check_output")->toValue()->getInt(), 42);
+
+    // an output, which was not set by the blossom, must fail the run with an error
+    inputValues.insert("input", new DataValue(41), true);
+    DataMap failedResult;
+    errorMessage = "";
+    TEST_EQUAL(interface->runTree(failedResult,
+                                  "consumed-input-test",
+                                  getConsumedInputTestTree(),
+                                  inputValues,
+                                  errorMessage), false);
+    const std::string expectedError = "output output for the value test_output was not set";
+    const bool containsError = errorMessage.find(expectedError) != std::string::npos;
+    TEST_EQUAL(containsError, true);
+}
+
+/**
+ * @brief Interface_Test::concurrentRuns_test
+ */
+void
+Interface_Test::concurrentRuns_test()
+{
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+    const uint32_t numberOfThreads = 4;
+    const uint32_t numberOfRuns = 20;
+
+    // runs from multiple threads at the same time. The results are only counted within the
+    // threads and checked afterwards.
+    std::atomic<uint32_t> successfulRuns(0);
+    std::vector<std::thread> threads;
+    for(uint32_t i = 0; i < numberOfThreads; i++)
+    {
+        threads.push_back(std::thread([interface, &successfulRuns, this]()
+        {
+            for(uint32_t run = 0; run < numberOfRuns; run++)
+            {
+                std::string errorMessage = "";
+                DataMap inputValues;
+                inputValues.insert("input", new DataValue(42));
+                inputValues.insert("test_output", new DataValue(0));
+
+                DataMap result;
+                if(interface->runTree(result,
+                                      "concurrent-test",
+                                      getTestTree(),
+                                      inputValues,
+                                      errorMessage)
+                        && result.get("test_output")->toValue()->getInt() == 42)
+                {
+                    successfulRuns++;
+                }
+            }
+        }));
+    }
+    for(std::thread &thread : threads) {
+        thread.join();
+    }
+    TEST_EQUAL(successfulRuns.load(), numberOfThreads * numberOfRuns);
+
+    // runs of a tree, which is reloaded at the same time, must see either the old or the new
+    // version, but never a broken one
+    std::string errorMessage = "";
+    const bfs::path dirPath = bfs::temp_directory_path() / "sakura_concurrent_test";
+    const bfs::path filePath = dirPath / "concurrent.sakura";
+    bfs::create_directories(dirPath);
+    Persistence::writeFile(filePath.string(), getReloadTestTree("a"), errorMessage);
+    TEST_EQUAL(interface->readFiles(filePath.string(), errorMessage), true);
+
+    std::atomic<bool> reloadFinished(false);
+    std::atomic<uint32_t> failedRuns(0);
+    std::thread runThread([interface, &reloadFinished, &failedRuns]()
+    {
+        while(reloadFinished == false)
+        {
+            std::string runError = "";
+            DataMap inputValues;
+            inputValues.insert("input", new DataValue(42));
+            inputValues.insert("test_output", new DataValue(0));
+
+            DataMap result;
+            if(interface->triggerTree(result, "concurrent.sakura", inputValues, runError) == false)
+            {
+                failedRuns++;
+                continue;
+            }
+
+            const int output = result.get("test_output")->toValue()->getInt();
+            if(output != 0
+                    && output != 42)
+            {
+                failedRuns++;
+            }
+        }
+    });
+
+    uint32_t failedReloads = 0;
+    for(uint32_t i = 0; i < numberOfRuns; i++)
+    {
+        const std::string marker = (i % 2 == 0) ? "b" : "a";
+        Persistence::writeFile(filePath.string(), getReloadTestTree(marker), errorMessage);
+        if(interface->reloadFiles(errorMessage) == false) {
+            failedReloads++;
+        }
+    }
+    reloadFinished = true;
+    runThread.join();
+
+    TEST_EQUAL(failedReloads, 0);
+    TEST_EQUAL(failedRuns.load(), 0);
+
+    bfs::remove_all(dirPath);
+}
+
+/**
+ * @brief Interface_Test::collectedErrors_test
+ */
+void
+Interface_Test::collectedErrors_test()
+{
+    std::string errorMessage = "";
+    SakuraLangInterface* interface = SakuraLangInterface::getInstance();
+
+    // the validation must not stop at the first invalid tree
+    const bfs::path dirPath = bfs::temp_directory_path() / "sakura_errors_test";
+    bfs::create_directories(dirPath);
+
+    const std::string rootTree = "[\"errors\"]\n"
+                                 "- test_output = 0\n"
+                                 "\n"
+                                 "subtree(\"invalid_a.sakura\")\n"
+                                 "- test_output = test_output\n"
+                                 "\n"
+                                 "subtree(\"invalid_b.sakura\")\n"
+                                 "- test_output = test_output\n";
+    Persistence::writeFile((dirPath / "root.sakura").string(), rootTree, errorMessage);
+
+    const std::vector<std::string> names = {"invalid_a", "invalid_b"};
+    for(const std::string &name : names)
+    {
+        const std::string invalidTree = "[\"" + name + "\"]\n"
+                                        "- test_output = 0\n"
+                                        "\n"
+                                        "test1(\"" + name + "\")\n"
+                                        "->does_not_exist:\n"
+                                        "   - output >> test_output\n";
+        Persistence::writeFile((dirPath / (name + ".sakura")).string(), invalidTree, errorMessage);
+    }
+
+    errorMessage = "";
+    TEST_EQUAL(interface->readFiles((dirPath / "root.sakura").string(), errorMessage), false);
+    const bool containsFirstError = errorMessage.find("invalid_a") != std::string::npos;
+    TEST_EQUAL(containsFirstError, true);
+    const bool containsSecondError = errorMessage.find("invalid_b") != std::string::npos;
+    TEST_EQUAL(containsSecondError, true);
+
+    // the errors of the trees are joined as separate records and not by line-breaks, which
+    // would become part of the last field of each record
+    interface->setJsonErrorOutput(true);
+    errorMessage = "";
+    TEST_EQUAL(interface->readFiles((dirPath / "root.sakura").string(), errorMessage), false);
+    const bool containsLineBreak = errorMessage.find("\\n") != std::string::npos;
+    TEST_EQUAL(containsLineBreak, false);
+    interface->setJsonErrorOutput(false);
+
+    bfs::remove_all(dirPath);
+}
+
+/**
+ * @brief Session_Test::getTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getTestTree()
+{
+    const std::string tree = "[\"test\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "\n"
+                             "test1(\"this is a test\")\n"
+                             "->test2:\n"
+                             "   - input = input\n"
+                             "   - output >> test_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getConsumedInputTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getConsumedInputTestTree()
+{
+    const std::string tree = "[\"consumed-input\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = 0\n"
+                             "- check_output = 0\n"
+                             "\n"
+                             "test1(\"consume\")\n"
+                             "->consume:\n"
+                             "   - input = input\n"
+                             "   - output >> test_output\n"
+                             "\n"
+                             "test1(\"check\")\n"
+                             "->test2:\n"
+                             "   - input = input\n"
+                             "   - output >> check_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getScopeWriterTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getScopeWriterTestTree()
+{
+    const std::string tree = "[\"scope-writer\"]\n"
+                             "- test_output = 0\n"
+                             "- leaked_value = 42\n"
+                             "\n"
+                             "test1(\"writer\")\n"
+                             "->test2:\n"
+                             "   - input = leaked_value\n"
+                             "   - output >> test_output\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getScopeCheckTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getScopeCheckTestTree()
+{
+    const std::string tree = "[\"scope-check\"]\n"
+                             "- test_output = 0\n"
+                             "\n"
+                             "if(leaked_value == 42)\n"
+                             "{\n"
+                             "    test1(\"check\")\n"
+                             "    ->test2:\n"
+                             "       - input = leaked_value\n"
+                             "       - output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getNestedAutoParallelTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getNestedAutoParallelTestTree()
+{
+    const std::string tree = "[\"nested-auto-parallel\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- first_output = 0\n"
+                             "- second_output = 0\n"
+                             "- third_output = 0\n"
+                             "- fourth_output = 0\n"
+                             "\n"
+                             "if(input == 42)\n"
+                             "{\n"
+                             "    test1(\"first\")\n"
+                             "    ->pure:\n"
+                             "       - input = input\n"
+                             "       - output >> first_output\n"
+                             "\n"
+                             "    test1(\"second\")\n"
+                             "    ->pure:\n"
+                             "       - input = input\n"
+                             "       - output >> second_output\n"
+                             "}\n"
+                             "\n"
+                             "if(input == 42)\n"
+                             "{\n"
+                             "    test1(\"third\")\n"
+                             "    ->pure:\n"
+                             "       - input = input\n"
+                             "       - output >> third_output\n"
+                             "\n"
+                             "    test1(\"fourth\")\n"
+                             "    ->pure:\n"
+                             "       - input = input\n"
+                             "       - output >> fourth_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getParallelChangesTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getParallelChangesTestTree()
+{
+    const std::string tree = "[\"parallel-changes\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- pure_output = 1\n"
+                             "\n"
+                             "parallel()\n"
+                             "{\n"
+                             "    test1(\"first\")\n"
+                             "    ->pure:\n"
+                             "       - input = 4\n"
+                             "       - output >> pure_output\n"
+                             "\n"
+                             "    test1(\"second\")\n"
+                             "    ->pure:\n"
+                             "       - input = 0\n"
+                             "       - output >> pure_output\n"
+                             "\n"
+                             "    parallel()\n"
+                             "    - first_sum << sum(test_output)\n"
+                             "    {\n"
+                             "        test1(\"third\")\n"
+                             "        ->test2:\n"
+                             "           - input = input\n"
+                             "           - output >> test_output\n"
+                             "    }\n"
+                             "\n"
+                             "    parallel()\n"
+                             "    - second_count << count(test_output)\n"
+                             "    {\n"
+                             "        test1(\"fourth\")\n"
+                             "        ->test2:\n"
+                             "           - input = input\n"
+                             "           - output >> test_output\n"
+                             "    }\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getBlossomCacheTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getBlossomCacheTestTree()
+{
+    const std::string tree = "[\"blossom-cache\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "\n"
+                             "for(i = 0; i < 3; i++)\n"
+                             "{\n"
+                             "    test1(\"pure\")\n"
+                             "    ->pure:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getBatchTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getBatchTestTree()
+{
+    const std::string tree = "[\"batch\"]\n"
+                             "- test_output = \"{{}}\"\n"
+                             "- sum_output = \"{{}}\"\n"
+                             "\n"
+                             "for(i = 0; i < 10; i++)\n"
+                             "- sum_output << sum(test_output)\n"
+                             "{\n"
+                             "    test1(\"batch\")\n"
+                             "    ->batch:\n"
+                             "       - input = i\n"
+                             "       - output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getFoldingTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getFoldingTestTree()
+{
+    const std::string tree = "[\"folding\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- counter_output = 0\n"
+                             "\n"
+                             "if(\"a,b\".split(\",\").size() == 2)\n"
+                             "{\n"
+                             "    test1(\"if\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "else\n"
+                             "{\n"
+                             "    test1(\"else\")\n"
+                             "    ->test2:\n"
+                             "       - input = 0\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "for(i = 0; i < 3; i++)\n"
+                             "{\n"
+                             "    test1(\"unrolled\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "for(i = 0; i < 0; i++)\n"
+                             "{\n"
+                             "    test1(\"removed\")\n"
+                             "    ->test2:\n"
+                             "       - input = 0\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "for(j = 0; j < 3; j++)\n"
+                             "{\n"
+                             "    if(j == 2)\n"
+                             "    {\n"
+                             "        test1(\"counter\")\n"
+                             "        ->test2:\n"
+                             "           - input = input\n"
+                             "           - output >> counter_output\n"
+                             "    }\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getCompareTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getCompareTestTree()
+{
+    const std::string tree = "[\"compare\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- jinja_output = 0\n"
+                             "\n"
+                             "if(input >= 42)\n"
+                             "{\n"
+                             "    if(input < 100.5)\n"
+                             "    {\n"
+                             "        test1(\"compare\")\n"
+                             "        ->test2:\n"
+                             "           - input = input\n"
+                             "           - output >> test_output\n"
+                             "    }\n"
+                             "}\n"
+                             "\n"
+                             "if(input > 42)\n"
+                             "{\n"
+                             "    test1(\"wrong\")\n"
+                             "    ->test2:\n"
+                             "       - input = 0\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "if(\"{{input}}\" > 3)\n"
+                             "{\n"
+                             "    test1(\"jinja\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> jinja_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getSetFunctionsTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getSetFunctionsTestTree()
+{
+    const std::string tree = "[\"set\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- first = [\"a\", \"b\", \"b\", \"c\"]\n"
+                             "- second = [\"b\", \"c\", \"d\"]\n"
+                             "\n"
+                             "if(first.unique().size() == 3)\n"
+                             "{\n"
+                             "    if(first.intersect(second).size() == 3)\n"
+                             "    {\n"
+                             "        if(first.difference(second).get(0) == \"a\")\n"
+                             "        {\n"
+                             "            test1(\"set\")\n"
+                             "            ->test2:\n"
+                             "               - input = input\n"
+                             "               - output >> test_output\n"
+                             "        }\n"
+                             "    }\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getSplitLoopTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getSplitLoopTestTree()
+{
+    const std::string tree = "[\"split\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- count_output = 0\n"
+                             "- sum_output = 0\n"
+                             "- text = \"a::b::::c::\"\n"
+                             "- list = \"x, y, z\"\n"
+                             "\n"
+                             "for(part : text.split(\"::\"))\n"
+                             "- count_output << count(part)\n"
+                             "{\n"
+                             "    test1(\"split\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "parallel_for(part : list.split(\", \"))\n"
+                             "- sum_output << sum(test_output)\n"
+                             "{\n"
+                             "    test1(\"split\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getJsonPathKeyTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getJsonPathKeyTestTree()
+{
+    const std::string tree = "[\"json-key\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- json = \"{{}}\"\n"
+                             "- key = \"{{}}\"\n"
+                             "\n"
+                             "if(json.parse_json().get(key) == 42)\n"
+                             "{\n"
+                             "    test1(\"json\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getJsonPathTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getJsonPathTestTree()
+{
+    const std::string tree = "[\"json\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- json = \"{{}}\"\n"
+                             "\n"
+                             "if(json.parse_json().get(\"a\").get(\"b\").get(2) == 42)\n"
+                             "{\n"
+                             "    if(json.parse_json().get(\"c\").get(\"d\") == \"}\")\n"
+                             "    {\n"
+                             "        test1(\"json\")\n"
+                             "        ->test2:\n"
+                             "           - input = input\n"
+                             "           - output >> test_output\n"
+                             "    }\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getReloadTestTree
+ * @param marker value to switch between the different versions of the tree
+ * @return
+ */
+const std::string
+Interface_Test::getReloadTestTree(const std::string &marker)
+{
+    const std::string tree = "[\"reload\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = 0\n"
+                             "- marker = \"" + marker + "\"\n"
+                             "\n"
+                             "if(marker == \"b\")\n"
+                             "{\n"
+                             "    test1(\"reload\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getSubtreeTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getSubtreeTestTree()
+{
+    const std::string tree = "[\"subtree\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "\n"
+                             "for(i = 0; i < 3; i++)\n"
+                             "{\n"
+                             "    subtree(\"test-tree\")\n"
+                             "    - input = input\n"
+                             "    - test_output >> test_output\n"
+                             "}\n";
+    return tree;
+}
+
+/**
+ * @brief Interface_Test::getReduceTestTree
+ * @return
+ */
+const std::string
+Interface_Test::getReduceTestTree()
+{
+    const std::string tree = "[\"reduce\"]\n"
+                             "- input = \"{{}}\"\n"
+                             "- test_output = \"\"\n"
+                             "- sum_output = 0\n"
+                             "- count_output = 0\n"
+                             "- parallel_output = 0\n"
+                             "- list_output = \"\"\n"
+                             "\n"
+                             "for(i = 0; i < 10; i++)\n"
+                             "- sum_output << sum(test_output)\n"
+                             "{\n"
+                             "    test1(\"this is a test\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "parallel_for(j = 0; j < 10; j++)\n"
+                             "- count_output << count(test_output)\n"
+                             "- list_output << append(j)\n"
+                             "{\n"
+                             "    test1(\"this is a test\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n"
+                             "\n"
+                             "parallel()\n"
+                             "- parallel_output << sum(test_output)\n"
+                             "{\n"
+                             "    test1(\"first\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "\n"
+                             "    test1(\"second\")\n"
+                             "    ->test2:\n"
+                             "       - input = input\n"
+                             "       - output >> test_output\n"
+                             "}\n";
     return tree;
 }
 
@@ -43,6 +43,29 @@ public:
     void blossomMethods_test();
     void addAndGet_test();
     void runAndTrigger_test();
+    void reduce_test();
+    void threadPool_test();
+    void multipleInterfaces_test();
+    void priority_test();
+    void constantFolding_test();
+    void compare_test();
+    void setFunctions_test();
+    void splitLoop_test();
+    void jsonPath_test();
+    void reload_test();
+    void parseCache_test();
+    void subtree_test();
+    void sourceSpan_test();
+    void jsonError_test();
+    void trace_test();
+    void blossomCache_test();
+    void batch_test();
+    void parallelChanges_test();
+    void nestedAutoParallel_test();
+    void scopeLeak_test();
+    void consumedInput_test();
+    void concurrentRuns_test();
+    void collectedErrors_test();
 
     template<typename  T>
     void compare(T isValue, T shouldValue)
@@ -52,6 +75,22 @@ public:
 
 private:
     const std::string getTestTree();
+    const std::string getReduceTestTree();
+    const std::string getFoldingTestTree();
+    const std::string getCompareTestTree();
+    const std::string getSetFunctionsTestTree();
+    const std::string getSplitLoopTestTree();
+    const std::string getJsonPathTestTree();
+    const std::string getJsonPathKeyTestTree();
+    const std::string getReloadTestTree(const std::string &marker);
+    const std::string getSubtreeTestTree();
+    const std::string getBlossomCacheTestTree();
+    const std::string getBatchTestTree();
+    const std::string getParallelChangesTestTree();
+    const std::string getNestedAutoParallelTestTree();
+    const std::string getScopeWriterTestTree();
+    const std::string getScopeCheckTestTree();
+    const std::string getConsumedInputTestTree();
     const std::string getTestTemplate();
     DataBuffer* getTestFile();
 };
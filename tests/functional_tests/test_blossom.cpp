@@ -26,5 +26,75 @@ TestBlossom::runTask(BlossomLeaf &blossomLeaf, std::string &)
     return true;
 }
 
+PureTestBlossom::PureTestBlossom()
+    : Blossom()
+{
+    isPure = true;
+    validationMap.emplace("input", BlossomValidDef(IO_ValueType::INPUT_TYPE, true));
+    validationMap.emplace("output", BlossomValidDef(IO_ValueType::OUTPUT_TYPE, true));
+}
+
+bool
+PureTestBlossom::runTask(BlossomLeaf &blossomLeaf, std::string &)
+{
+    numberOfCalls++;
+    if(blossomLeaf.parentValues != nullptr) {
+        numberOfParentAccesses++;
+    }
+    const long input = blossomLeaf.input.get("input")->toValue()->getLong();
+    blossomLeaf.output.insert("output", new Kitsunemimi::DataValue(input + 1));
+    return true;
+}
+
+BatchTestBlossom::BatchTestBlossom()
+    : Blossom()
+{
+    supportsBatch = true;
+    validationMap.emplace("input", BlossomValidDef(IO_ValueType::INPUT_TYPE, true));
+    validationMap.emplace("output", BlossomValidDef(IO_ValueType::OUTPUT_TYPE, true));
+}
+
+bool
+BatchTestBlossom::runTask(BlossomLeaf &blossomLeaf, std::string &)
+{
+    numberOfCalls++;
+    const long input = blossomLeaf.input.get("input")->toValue()->getLong();
+    blossomLeaf.output.insert("output", new Kitsunemimi::DataValue(input * 2));
+    return true;
+}
+
+bool
+BatchTestBlossom::runBatch(std::vector<BlossomLeaf> &blossomLeafs, std::string &errorMessage)
+{
+    numberOfBatches++;
+    for(const BlossomLeaf &blossomLeaf : blossomLeafs)
+    {
+        if(blossomLeaf.parentValues != nullptr) {
+            numberOfParentAccesses++;
+        }
+    }
+
+    return Blossom::runBatch(blossomLeafs, errorMessage);
+}
+
+ConsumingTestBlossom::ConsumingTestBlossom()
+    : Blossom()
+{
+    validationMap.emplace("input", BlossomValidDef(IO_ValueType::INPUT_TYPE, true));
+    validationMap.emplace("output", BlossomValidDef(IO_ValueType::OUTPUT_TYPE, false));
+}
+
+bool
+ConsumingTestBlossom::runTask(BlossomLeaf &blossomLeaf, std::string &)
+{
+    // the input is owned by the leaf and can be removed. The output is only set for 42.
+    const long input = blossomLeaf.input.get("input")->toValue()->getLong();
+    blossomLeaf.input.clear();
+    if(input == 42) {
+        blossomLeaf.output.insert("output", new Kitsunemimi::DataValue(input));
+    }
+    return true;
+}
+
 }
 }
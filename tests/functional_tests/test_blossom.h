@@ -22,6 +22,44 @@ private:
     Interface_Test* m_sessionTest = nullptr;
 };
 
+class PureTestBlossom
+        : public Blossom
+{
+public:
+    PureTestBlossom();
+
+    uint32_t numberOfCalls = 0;
+    uint32_t numberOfParentAccesses = 0;
+
+protected:
+    bool runTask(BlossomLeaf &blossomLeaf, std::string &);
+};
+
+class BatchTestBlossom
+        : public Blossom
+{
+public:
+    BatchTestBlossom();
+
+    uint32_t numberOfCalls = 0;
+    uint32_t numberOfBatches = 0;
+    uint32_t numberOfParentAccesses = 0;
+
+protected:
+    bool runTask(BlossomLeaf &blossomLeaf, std::string &);
+    bool runBatch(std::vector<BlossomLeaf> &blossomLeafs, std::string &errorMessage);
+};
+
+class ConsumingTestBlossom
+        : public Blossom
+{
+public:
+    ConsumingTestBlossom();
+
+protected:
+    bool runTask(BlossomLeaf &blossomLeaf, std::string &);
+};
+
 }
 }
 
@@ -4,6 +4,8 @@ QT -= qt core gui
 CONFIG += c++14
 
 SUBDIRS = \
-    functional_tests
+    unit_tests \
+    functional_tests \
+    benchmark_tests
 
 tests.depends = src
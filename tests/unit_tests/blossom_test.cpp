@@ -0,0 +1,105 @@
+/**
+ * @file       blossom_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "blossom_test.h"
+
+#include <libKitsunemimiSakuraLang/blossom.h>
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief blossom, which doubles its input and fails for negative inputs
+ */
+class DoubleBlossom
+        : public Blossom
+{
+public:
+    uint32_t numberOfCalls = 0;
+
+    bool runTestBatch(std::vector<BlossomLeaf> &blossomLeafs, std::string &errorMessage)
+    {
+        return runBatch(blossomLeafs, errorMessage);
+    }
+
+protected:
+    bool runTask(BlossomLeaf &blossomLeaf, std::string &errorMessage)
+    {
+        numberOfCalls++;
+        const long input = blossomLeaf.input.get("input")->toValue()->getLong();
+        if(input < 0)
+        {
+            errorMessage = "negative input";
+            return false;
+        }
+
+        blossomLeaf.output.insert("output", new DataValue(input * 2));
+        return true;
+    }
+};
+
+/**
+ * @brief Blossom_Test::Blossom_Test
+ */
+Blossom_Test::Blossom_Test() :
+    Kitsunemimi::CompareTestHelper("Blossom_Test")
+{
+    runBatch_test();
+}
+
+/**
+ * @brief Blossom_Test::runBatch_test
+ */
+void
+Blossom_Test::runBatch_test()
+{
+    std::string errorMessage = "";
+    DoubleBlossom blossom;
+
+    // without an own implementation every call of the batch is given to runTask in order
+    std::vector<BlossomLeaf> blossomLeafs(3);
+    for(uint64_t i = 0; i < blossomLeafs.size(); i++) {
+        blossomLeafs[i].input.insert("input", new DataValue(static_cast<long>(i)));
+    }
+
+    TEST_EQUAL(blossom.runTestBatch(blossomLeafs, errorMessage), true);
+    TEST_EQUAL(blossom.numberOfCalls, 3);
+    TEST_EQUAL(blossomLeafs[0].output.get("output")->toValue()->getLong(), 0);
+    TEST_EQUAL(blossomLeafs[2].output.get("output")->toValue()->getLong(), 4);
+
+    // the batch stops at the first failed call
+    std::vector<BlossomLeaf> failingLeafs(3);
+    failingLeafs[0].input.insert("input", new DataValue(static_cast<long>(1)));
+    failingLeafs[1].input.insert("input", new DataValue(static_cast<long>(-1)));
+    failingLeafs[2].input.insert("input", new DataValue(static_cast<long>(2)));
+
+    TEST_EQUAL(blossom.runTestBatch(failingLeafs, errorMessage), false);
+    TEST_EQUAL(errorMessage, std::string("negative input"));
+    TEST_EQUAL(blossom.numberOfCalls, 5);
+    TEST_EQUAL(failingLeafs[2].output.contains("output"), false);
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,114 @@
+/**
+ * @file       error_container_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "error_container_test.h"
+
+#include <items/error_container.h>
+#include <items/item_methods.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief ErrorContainer_Test::ErrorContainer_Test
+ */
+ErrorContainer_Test::ErrorContainer_Test() :
+    Kitsunemimi::CompareTestHelper("ErrorContainer_Test")
+{
+    record_test();
+    escape_test();
+    chain_test();
+}
+
+/**
+ * @brief ErrorContainer_Test::record_test
+ */
+void
+ErrorContainer_Test::record_test()
+{
+    std::string record(1, ERROR_RECORD_SEPARATOR);
+    ErrorContainer::addField(record, "location", "test");
+    ErrorContainer::addField(record, "error-message", "something failed");
+
+    const ErrorContainer errors(record);
+    TEST_EQUAL(errors.toJsonString(),
+               std::string("[{\"location\":\"test\",\"error-message\":\"something failed\"}]"));
+
+    // the rendered tables contain the fields, but no separators
+    const std::string table = errors.toString();
+    const bool containsValue = table.find("something failed") != std::string::npos;
+    TEST_EQUAL(containsValue, true);
+    const bool containsSeparator = table.find(ERROR_FIELD_SEPARATOR) != std::string::npos;
+    TEST_EQUAL(containsSeparator, false);
+
+    // empty error-message
+    const ErrorContainer emptyErrors("");
+    TEST_EQUAL(emptyErrors.toJsonString(), std::string("[]"));
+}
+
+/**
+ * @brief ErrorContainer_Test::escape_test
+ */
+void
+ErrorContainer_Test::escape_test()
+{
+    // separators and the escape-character within the fields don't break the record
+    const std::string value = std::string("sep") + ERROR_RECORD_SEPARATOR
+                              + "name" + ERROR_FIELD_SEPARATOR
+                              + "value" + ERROR_ESCAPE_CHARACTER
+                              + "end";
+    std::string record(1, ERROR_RECORD_SEPARATOR);
+    ErrorContainer::addField(record, "blossom-name", value);
+    ErrorContainer::addField(record, "error-message", "quote\" and\nline-break");
+
+    const ErrorContainer errors(record);
+    TEST_EQUAL(errors.toJsonString(),
+               std::string("[{\"blossom-name\":\"sep\\u001ename\\u001fvalue\\u001dend\","
+                           "\"error-message\":\"quote\\\" and\\nline-break\"}]"));
+}
+
+/**
+ * @brief ErrorContainer_Test::chain_test
+ */
+void
+ErrorContainer_Test::chain_test()
+{
+    // inner errors follow the outer error as separate records
+    const std::string innerError = createError("inner", "inner failed");
+    const std::string outerError = createError("outer", "outer failed" + innerError);
+
+    const ErrorContainer errors(outerError);
+    TEST_EQUAL(errors.toJsonString(),
+               std::string("[{\"location\":\"outer\",\"error-message\":\"outer failed\"},"
+                           "{\"location\":\"inner\",\"error-message\":\"inner failed\"}]"));
+
+    // plain text before the first record
+    const ErrorContainer prefixedErrors("plain error" + innerError);
+    TEST_EQUAL(prefixedErrors.toJsonString(),
+               std::string("[{\"error-message\":\"plain error\"},"
+                           "{\"location\":\"inner\",\"error-message\":\"inner failed\"}]"));
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,224 @@
+/**
+ * @file       item_methods_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "item_methods_test.h"
+
+#include <items/item_methods.h>
+#include <items/value_item_map.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief ItemMethods_Test::ItemMethods_Test
+ */
+ItemMethods_Test::ItemMethods_Test() :
+    Kitsunemimi::CompareTestHelper("ItemMethods_Test")
+{
+    moveOutputItems_test();
+    collectChangedItems_test();
+    combineReduceValues_test();
+    compareValues_test();
+}
+
+/**
+ * @brief ItemMethods_Test::moveOutputItems_test
+ */
+void
+ItemMethods_Test::moveOutputItems_test()
+{
+    DataMap parentValues;
+    parentValues.insert("name", new DataValue("parent"));
+    parentValues.insert("result", new DataValue(0));
+
+    ValueItemMap blossomValues;
+    ValueItem inputItem;
+    inputItem.item = new DataValue("input");
+    blossomValues.insert("name", inputItem);
+    ValueItem outputItem;
+    outputItem.type = ValueItem::OUTPUT_PAIR_TYPE;
+    outputItem.item = new DataValue(42);
+    blossomValues.insert("result", outputItem);
+    ValueItem unknownItem;
+    unknownItem.type = ValueItem::OUTPUT_PAIR_TYPE;
+    unknownItem.item = new DataValue(1);
+    blossomValues.insert("unknown", unknownItem);
+
+    // only outputs for existing parent-values are written back and inputs with the same name
+    // don't override the parent
+    moveOutputItems(parentValues, blossomValues);
+    TEST_EQUAL(parentValues.size(), 2);
+    TEST_EQUAL(parentValues.get("name")->toValue()->getString(), std::string("parent"));
+    TEST_EQUAL(parentValues.get("result")->toValue()->getInt(), 42);
+
+    // the output is moved and not copied
+    const bool isMoved = blossomValues.m_valueMap["result"].item == nullptr;
+    TEST_EQUAL(isMoved, true);
+}
+
+/**
+ * @brief ItemMethods_Test::collectChangedItems_test
+ */
+void
+ItemMethods_Test::collectChangedItems_test()
+{
+    DataMap current;
+    current.insert("unchanged", new DataValue(1));
+    current.insert("rewritten", new DataValue(2));
+    current.insert("created", new DataValue("new"));
+
+    std::set<std::string> writtenItems;
+    writtenItems.insert("rewritten");
+    writtenItems.insert("created");
+    writtenItems.insert("removed");
+
+    // only written items are taken, even if their value is the same as before, and names
+    // without a value in the scope are ignored
+    DataMap changedItems;
+    collectChangedItems(changedItems, current, writtenItems);
+    TEST_EQUAL(changedItems.size(), 2);
+    TEST_EQUAL(changedItems.contains("unchanged"), false);
+    TEST_EQUAL(changedItems.contains("removed"), false);
+    TEST_EQUAL(changedItems.get("rewritten")->toValue()->getInt(), 2);
+    TEST_EQUAL(changedItems.get("created")->toValue()->getString(), std::string("new"));
+
+    // the written items are moved out of the scope
+    TEST_EQUAL(current.size(), 1);
+    TEST_EQUAL(current.contains("unchanged"), true);
+}
+
+/**
+ * @brief ItemMethods_Test::combineReduceValues_test
+ */
+void
+ItemMethods_Test::combineReduceValues_test()
+{
+    std::string errorMessage = "";
+
+    ValueItemMap reductions;
+    ValueItem appendItem;
+    appendItem.reduceType = ValueItem::APPEND_REDUCE;
+    reductions.insert("list", appendItem);
+    ValueItem countItem;
+    countItem.reduceType = ValueItem::COUNT_REDUCE;
+    reductions.insert("count", countItem);
+
+    // partial results of two neighbouring ranges of iterations
+    DataMap first;
+    initReduceValues(first, reductions);
+    first.get("list")->toArray()->append(new DataValue(0));
+    first.get("list")->toArray()->append(new DataValue(1));
+    first.insert("count", new DataValue(2), true);
+
+    DataMap following;
+    initReduceValues(following, reductions);
+    following.get("list")->toArray()->append(new DataValue(2));
+    following.insert("count", new DataValue(1), true);
+
+    // the following range is appended behind the first one and the counts are summed up
+    TEST_EQUAL(combineReduceValues(first, reductions, following, errorMessage), true);
+    TEST_EQUAL(first.get("list")->size(), 3);
+    TEST_EQUAL(first.get("list")->get(0)->toValue()->getInt(), 0);
+    TEST_EQUAL(first.get("list")->get(2)->toValue()->getInt(), 2);
+    TEST_EQUAL(first.get("count")->toValue()->getInt(), 3);
+
+    // the combined items are moved out of the other map
+    TEST_EQUAL(following.size(), 0);
+
+    // a missing result takes over the partial result
+    DataMap empty;
+    DataMap other;
+    other.insert("count", new DataValue(5));
+    TEST_EQUAL(combineReduceValues(empty, reductions, other, errorMessage), true);
+    TEST_EQUAL(empty.get("count")->toValue()->getInt(), 5);
+}
+
+/**
+ * @brief ItemMethods_Test::compareValues_test
+ */
+void
+ItemMethods_Test::compareValues_test()
+{
+    std::string errorMessage = "";
+    bool result = false;
+
+    // numbers of different types
+    DataValue intValue(42);
+    DataValue floatValue(42.5);
+    TEST_EQUAL(compareValues(result, &intValue, &floatValue, IfBranching::SMALLER, errorMessage),
+               true);
+    TEST_EQUAL(result, true);
+
+    // strings are ordered lexicographical
+    DataValue first("abc");
+    DataValue second("abd");
+    TEST_EQUAL(compareValues(result, &first, &second, IfBranching::GREATER, errorMessage), true);
+    TEST_EQUAL(result, false);
+
+    // arrays are equal, if their values are equal in the same order, even if their string-content
+    // is different
+    DataArray leftArray;
+    leftArray.append(new DataValue(1));
+    leftArray.append(new DataValue("a"));
+    DataArray rightArray;
+    rightArray.append(new DataValue(1.0));
+    rightArray.append(new DataValue("a"));
+    TEST_EQUAL(compareValues(result, &leftArray, &rightArray, IfBranching::EQUAL, errorMessage),
+               true);
+    TEST_EQUAL(result, true);
+
+    DataArray reversedArray;
+    reversedArray.append(new DataValue("a"));
+    reversedArray.append(new DataValue(1));
+    TEST_EQUAL(compareValues(result, &leftArray, &reversedArray, IfBranching::EQUAL, errorMessage),
+               true);
+    TEST_EQUAL(result, false);
+
+    // maps are compared recursively by their keys and values
+    DataMap leftMap;
+    leftMap.insert("x", new DataValue(2));
+    leftMap.insert("list", leftArray.copy());
+    DataMap rightMap;
+    rightMap.insert("list", rightArray.copy());
+    rightMap.insert("x", new DataValue(2.0));
+    TEST_EQUAL(compareValues(result, &leftMap, &rightMap, IfBranching::EQUAL, errorMessage), true);
+    TEST_EQUAL(result, true);
+
+    rightMap.insert("y", new DataValue(3));
+    TEST_EQUAL(compareValues(result, &leftMap, &rightMap, IfBranching::UNEQUAL, errorMessage),
+               true);
+    TEST_EQUAL(result, true);
+
+    // maps and arrays are never equal to other types and can not be ordered
+    TEST_EQUAL(compareValues(result, &leftMap, &leftArray, IfBranching::EQUAL, errorMessage), true);
+    TEST_EQUAL(result, false);
+    TEST_EQUAL(compareValues(result, &leftArray, &intValue, IfBranching::EQUAL, errorMessage),
+               true);
+    TEST_EQUAL(result, false);
+    TEST_EQUAL(compareValues(result, &leftMap, &rightMap, IfBranching::GREATER, errorMessage),
+               false);
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
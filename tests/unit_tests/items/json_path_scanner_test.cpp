@@ -0,0 +1,147 @@
+/**
+ * @file       json_path_scanner_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "json_path_scanner_test.h"
+
+#include <items/json_path_scanner.h>
+
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief JsonPathScanner_Test::JsonPathScanner_Test
+ */
+JsonPathScanner_Test::JsonPathScanner_Test() :
+    Kitsunemimi::CompareTestHelper("JsonPathScanner_Test")
+{
+    nestedPath_test();
+    escapedKeys_test();
+    invalidPath_test();
+}
+
+/**
+ * @brief JsonPathScanner_Test::nestedPath_test
+ */
+void
+JsonPathScanner_Test::nestedPath_test()
+{
+    std::string errorMessage = "";
+    const std::string json = "{\"a\": {\"b\": [1, \"x]\", 42]}, \"c\": {\"d\": \"}\"}}";
+
+    // brackets within strings are skipped
+    DataValue a("a");
+    DataValue b("b");
+    DataValue two(2);
+    DataItem* result = getValue(json, {&a, &b, &two}, errorMessage);
+    TEST_EQUAL(result->toValue()->getInt(), 42);
+    delete result;
+
+    DataValue c("c");
+    DataValue d("d");
+    result = getValue(json, {&c, &d}, errorMessage);
+    TEST_EQUAL(result->toValue()->getString(), std::string("}"));
+    delete result;
+
+    // maps and arrays at the end of the path are returned completely
+    result = getValue(json, {&a, &b}, errorMessage);
+    TEST_EQUAL(result->isArray(), true);
+    TEST_EQUAL(result->size(), 3);
+    delete result;
+}
+
+/**
+ * @brief JsonPathScanner_Test::escapedKeys_test
+ */
+void
+JsonPathScanner_Test::escapedKeys_test()
+{
+    std::string errorMessage = "";
+
+    // key outside of the basic multilingual plane, which is written as surrogate-pair
+    DataValue emojiKey("\xF0\x9F\x98\x80");
+    DataItem* result = getValue("{\"\\ud83d\\ude00\": 42}", {&emojiKey}, errorMessage);
+    TEST_EQUAL(result->toValue()->getInt(), 42);
+    delete result;
+
+    // escaped quote within a key
+    DataValue quoteKey("a\"b");
+    result = getValue("{\"a\": 1, \"a\\\"b\": 2}", {&quoteKey}, errorMessage);
+    TEST_EQUAL(result->toValue()->getInt(), 2);
+    delete result;
+}
+
+/**
+ * @brief JsonPathScanner_Test::invalidPath_test
+ */
+void
+JsonPathScanner_Test::invalidPath_test()
+{
+    std::string errorMessage = "";
+    const std::string json = "{\"a\": [1, 2]}";
+    DataValue a("a");
+    DataValue missing("missing");
+    DataValue outOfRange(2);
+    DataValue negative(-1);
+
+    bool failed = getValue(json, {&missing}, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+    failed = getValue(json, {&a, &outOfRange}, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+    failed = getValue(json, {&a, &negative}, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+
+    // arrays need integer positions and values have no childs
+    failed = getValue(json, {&a, &a}, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+    DataValue zero(0);
+    failed = getValue(json, {&a, &zero, &zero}, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+
+    // broken json
+    failed = getValue("{\"a\": [1, 2", {&a, &outOfRange}, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+}
+
+/**
+ * @brief scan a json-string for the value at the end of a path
+ *
+ * @param json json-formated string
+ * @param path keys and array-positions to the requested value
+ * @param errorMessage reference for error-message
+ *
+ * @return requested value or nullptr, if failed
+ */
+DataItem*
+JsonPathScanner_Test::getValue(const std::string &json,
+                               const std::vector<DataValue*> &path,
+                               std::string &errorMessage)
+{
+    JsonPathScanner scanner(json.c_str(), json.size());
+    return scanner.getValue(path, errorMessage);
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,56 @@
+/**
+ * @file       json_path_scanner_test.h
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef JSON_PATH_SCANNER_TEST_H
+#define JSON_PATH_SCANNER_TEST_H
+
+#include <vector>
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class DataItem;
+class DataValue;
+namespace Sakura
+{
+
+class JsonPathScanner_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    JsonPathScanner_Test();
+
+private:
+    void nestedPath_test();
+    void escapedKeys_test();
+    void invalidPath_test();
+
+    DataItem* getValue(const std::string &json,
+                       const std::vector<DataValue*> &path,
+                       std::string &errorMessage);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // JSON_PATH_SCANNER_TEST_H
@@ -0,0 +1,159 @@
+/**
+ * @file       value_item_functions_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "value_item_functions_test.h"
+
+#include <items/value_item_functions.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief ValueItemFunctions_Test::ValueItemFunctions_Test
+ */
+ValueItemFunctions_Test::ValueItemFunctions_Test() :
+    Kitsunemimi::CompareTestHelper("ValueItemFunctions_Test")
+{
+    splitValue_test();
+    uniqueValue_test();
+    filterBySet_test();
+}
+
+/**
+ * @brief ValueItemFunctions_Test::splitValue_test
+ */
+void
+ValueItemFunctions_Test::splitValue_test()
+{
+    std::string errorMessage = "";
+
+    // escape-sequences within the delimiter are resolved
+    DataValue content("a\nb\n\nc");
+    DataValue delimiter("\\n");
+    DataArray* result = splitValue(&content, &delimiter, errorMessage);
+    TEST_EQUAL(joinArray(result), std::string("a,b,,c"));
+    delete result;
+
+    // empty delimiter
+    DataValue emptyDelimiter("");
+    bool failed = splitValue(&content, &emptyDelimiter, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+
+    // only strings can be splitted
+    DataValue number(42);
+    failed = splitValue(&number, &delimiter, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+}
+
+/**
+ * @brief ValueItemFunctions_Test::uniqueValue_test
+ */
+void
+ValueItemFunctions_Test::uniqueValue_test()
+{
+    std::string errorMessage = "";
+
+    DataArray input;
+    input.append(new DataValue("b"));
+    input.append(new DataValue("a"));
+    input.append(new DataValue("b"));
+    input.append(new DataValue(1));
+    input.append(new DataValue("1"));
+
+    // the first appearance of each entry is kept in the original order. Entries are compared by
+    // their string-representation, so the number 1 and the string "1" are the same.
+    DataArray* result = uniqueValue(&input, errorMessage);
+    TEST_EQUAL(joinArray(result), std::string("b,a,1"));
+    delete result;
+
+    const bool failed = uniqueValue(nullptr, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+}
+
+/**
+ * @brief ValueItemFunctions_Test::filterBySet_test
+ */
+void
+ValueItemFunctions_Test::filterBySet_test()
+{
+    std::string errorMessage = "";
+
+    DataArray first;
+    first.append(new DataValue("a"));
+    first.append(new DataValue("b"));
+    first.append(new DataValue("b"));
+    first.append(new DataValue("c"));
+    DataArray second;
+    second.append(new DataValue("c"));
+    second.append(new DataValue("b"));
+    second.append(new DataValue("d"));
+
+    // intersect keeps duplicates and the order of the filtered array
+    DataArray* result = filterBySet(&first, &second, true, errorMessage);
+    TEST_EQUAL(joinArray(result), std::string("b,b,c"));
+    delete result;
+
+    // difference
+    result = filterBySet(&first, &second, false, errorMessage);
+    TEST_EQUAL(joinArray(result), std::string("a"));
+    delete result;
+
+    // empty filter
+    DataArray empty;
+    result = filterBySet(&first, &empty, true, errorMessage);
+    TEST_EQUAL(result->size(), 0);
+    delete result;
+
+    const bool failed = filterBySet(&first, nullptr, true, errorMessage) == nullptr;
+    TEST_EQUAL(failed, true);
+}
+
+/**
+ * @brief join the string-representations of all entries of an array
+ *
+ * @param array array to join
+ *
+ * @return comma-separated entries or an empty string, if the array is nullptr
+ */
+const std::string
+ValueItemFunctions_Test::joinArray(DataArray* array)
+{
+    std::string result = "";
+    if(array == nullptr) {
+        return result;
+    }
+
+    for(uint64_t i = 0; i < array->size(); i++)
+    {
+        if(i > 0) {
+            result += ",";
+        }
+        result += array->get(i)->toString();
+    }
+
+    return result;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
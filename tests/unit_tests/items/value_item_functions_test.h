@@ -0,0 +1,51 @@
+/**
+ * @file       value_item_functions_test.h
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef VALUE_ITEM_FUNCTIONS_TEST_H
+#define VALUE_ITEM_FUNCTIONS_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+class DataArray;
+namespace Sakura
+{
+
+class ValueItemFunctions_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    ValueItemFunctions_Test();
+
+private:
+    void splitValue_test();
+    void uniqueValue_test();
+    void filterBySet_test();
+
+    const std::string joinArray(DataArray* array);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // VALUE_ITEM_FUNCTIONS_TEST_H
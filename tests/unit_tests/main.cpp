@@ -0,0 +1,63 @@
+/**
+ * @file    main.cpp
+ *
+ * @author  Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2019 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include <libKitsunemimiPersistence/logger/logger.h>
+
+#include <blossom_test.h>
+#include <items/error_container_test.h>
+#include <items/item_methods_test.h>
+#include <items/json_path_scanner_test.h>
+#include <items/value_item_functions_test.h>
+#include <optimizer/dependency_analysis_test.h>
+#include <parsing/parse_cache_test.h>
+#include <parsing/sakura_parser_interface_test.h>
+#include <parsing/sakura_parsing_test.h>
+#include <processing/blossom_cache_test.h>
+#include <processing/blossom_trace_test.h>
+#include <processing/cpu_topology_test.h>
+#include <processing/loop_source_test.h>
+#include <processing/subtree_queue_test.h>
+#include <processing/thread_pool_test.h>
+
+using Kitsunemimi::Persistence::initConsoleLogger;
+
+
+int main()
+{
+    initConsoleLogger(true);
+
+    Kitsunemimi::Sakura::Blossom_Test();
+    Kitsunemimi::Sakura::ErrorContainer_Test();
+    Kitsunemimi::Sakura::ItemMethods_Test();
+    Kitsunemimi::Sakura::JsonPathScanner_Test();
+    Kitsunemimi::Sakura::ValueItemFunctions_Test();
+    Kitsunemimi::Sakura::DependencyAnalysis_Test();
+    Kitsunemimi::Sakura::ParseCache_Test();
+    Kitsunemimi::Sakura::SakuraParserInterface_Test();
+    Kitsunemimi::Sakura::SakuraParsing_Test();
+    Kitsunemimi::Sakura::BlossomCache_Test();
+    Kitsunemimi::Sakura::BlossomTrace_Test();
+    Kitsunemimi::Sakura::CpuTopology_Test();
+    Kitsunemimi::Sakura::LoopSource_Test();
+    Kitsunemimi::Sakura::SubtreeQueue_Test();
+    Kitsunemimi::Sakura::ThreadPool_Test();
+}
@@ -0,0 +1,160 @@
+/**
+ * @file       dependency_analysis_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "dependency_analysis_test.h"
+
+#include <optimizer/dependency_analysis.h>
+#include <items/sakura_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief DependencyAnalysis_Test::DependencyAnalysis_Test
+ */
+DependencyAnalysis_Test::DependencyAnalysis_Test() :
+    Kitsunemimi::CompareTestHelper("DependencyAnalysis_Test")
+{
+    independentItems_test();
+    dependentItems_test();
+    impureItems_test();
+    barrierItems_test();
+}
+
+/**
+ * @brief DependencyAnalysis_Test::independentItems_test
+ */
+void
+DependencyAnalysis_Test::independentItems_test()
+{
+    SequentiellPart sequential;
+    sequential.childs.push_back(createGroup("input", "first", true));
+    sequential.childs.push_back(createGroup("input", "second", true));
+
+    // both only read the same value, so they can be processed at the same time
+    std::vector<std::vector<uint64_t>> levels;
+    createDependencyLevels(levels, sequential.childs, nullptr);
+    TEST_EQUAL(levels.size(), 1);
+    TEST_EQUAL(levels.at(0).size(), 2);
+}
+
+/**
+ * @brief DependencyAnalysis_Test::dependentItems_test
+ */
+void
+DependencyAnalysis_Test::dependentItems_test()
+{
+    SequentiellPart sequential;
+    sequential.childs.push_back(createGroup("input", "first", true));
+    sequential.childs.push_back(createGroup("first", "second", true));
+    sequential.childs.push_back(createGroup("input", "third", true));
+    sequential.childs.push_back(createGroup("input", "first", true));
+
+    // read after write, write after read and write after write
+    std::vector<std::vector<uint64_t>> levels;
+    createDependencyLevels(levels, sequential.childs, nullptr);
+    TEST_EQUAL(levels.size(), 3);
+    if(levels.size() != 3) {
+        return;
+    }
+
+    TEST_EQUAL(levels.at(0).size(), 2);
+    TEST_EQUAL(levels.at(0).at(1), 2);
+    TEST_EQUAL(levels.at(1).size(), 1);
+    TEST_EQUAL(levels.at(1).at(0), 1);
+    TEST_EQUAL(levels.at(2).size(), 1);
+    TEST_EQUAL(levels.at(2).at(0), 3);
+}
+
+/**
+ * @brief DependencyAnalysis_Test::impureItems_test
+ */
+void
+DependencyAnalysis_Test::impureItems_test()
+{
+    SequentiellPart sequential;
+    sequential.childs.push_back(createGroup("input", "first", true));
+    sequential.childs.push_back(createGroup("input", "second", false));
+    sequential.childs.push_back(createGroup("input", "third", true));
+
+    // a blossom, which is not pure, can read the output of its siblings through the
+    // parent-values, so it is never processed at the same time as one of them
+    std::vector<std::vector<uint64_t>> levels;
+    createDependencyLevels(levels, sequential.childs, nullptr);
+    TEST_EQUAL(levels.size(), 3);
+}
+
+/**
+ * @brief DependencyAnalysis_Test::barrierItems_test
+ */
+void
+DependencyAnalysis_Test::barrierItems_test()
+{
+    SequentiellPart sequential;
+    sequential.childs.push_back(createGroup("input", "first", true));
+    sequential.childs.push_back(new SequentiellPart());
+    sequential.childs.push_back(createGroup("input", "second", true));
+
+    std::vector<std::vector<uint64_t>> levels;
+    createDependencyLevels(levels, sequential.childs, nullptr);
+    TEST_EQUAL(levels.size(), 3);
+}
+
+/**
+ * @brief create a blossom-group with a single blossom, which reads one value and writes another
+ *
+ * @param input name of the value, which is read by the blossom
+ * @param output name of the value, where the output of the blossom is written to
+ * @param isPure purity of the blossom
+ *
+ * @return new blossom-group
+ */
+SakuraItem*
+DependencyAnalysis_Test::createGroup(const std::string &input,
+                                     const std::string &output,
+                                     const bool isPure)
+{
+    BlossomItem* blossomItem = new BlossomItem();
+    blossomItem->isPure = isPure;
+
+    ValueItem inputItem;
+    inputItem.item = new DataValue(input);
+    inputItem.isIdentifier = true;
+    blossomItem->values.insert("input", inputItem);
+
+    ValueItem outputItem;
+    outputItem.item = new DataValue("output");
+    outputItem.isIdentifier = true;
+    outputItem.type = ValueItem::OUTPUT_PAIR_TYPE;
+    blossomItem->values.insert(output, outputItem);
+
+    BlossomGroupItem* blossomGroupItem = new BlossomGroupItem();
+    blossomGroupItem->id = "group";
+    blossomGroupItem->blossoms.push_back(blossomItem);
+
+    return blossomGroupItem;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,54 @@
+/**
+ * @file       dependency_analysis_test.h
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef DEPENDENCY_ANALYSIS_TEST_H
+#define DEPENDENCY_ANALYSIS_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+class SakuraItem;
+
+class DependencyAnalysis_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    DependencyAnalysis_Test();
+
+private:
+    void independentItems_test();
+    void dependentItems_test();
+    void impureItems_test();
+    void barrierItems_test();
+
+    SakuraItem* createGroup(const std::string &input,
+                            const std::string &output,
+                            const bool isPure);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // DEPENDENCY_ANALYSIS_TEST_H
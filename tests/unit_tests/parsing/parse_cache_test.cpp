@@ -0,0 +1,208 @@
+/**
+ * @file       parse_cache_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "parse_cache_test.h"
+
+#include <parsing/parse_cache.h>
+#include <items/sakura_items.h>
+
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief ParseCache_Test::ParseCache_Test
+ */
+ParseCache_Test::ParseCache_Test() :
+    Kitsunemimi::CompareTestHelper("ParseCache_Test")
+{
+    getAndAdd_test();
+    evict_test();
+    invalidate_test();
+}
+
+/**
+ * @brief ParseCache_Test::getAndAdd_test
+ */
+void
+ParseCache_Test::getAndAdd_test()
+{
+    ParseCache cache;
+    DataMap metrics;
+
+    // unknown content
+    const bool isMissing = cache.get("content") == nullptr;
+    TEST_EQUAL(isMissing, true);
+
+    // the cache holds its own copy of the tree
+    TreeItem* tree = createTree(10);
+    cache.add("content", tree, cache.getGeneration());
+    delete tree;
+
+    TreeItem* cachedTree = cache.get("content");
+    const bool isFound = cachedTree != nullptr;
+    TEST_EQUAL(isFound, true);
+    TEST_EQUAL(cachedTree->id, std::string("tree"));
+    TEST_EQUAL(cachedTree->unparsedConent, std::string("content"));
+
+    // every request gets a separate copy
+    TreeItem* secondTree = cache.get("content");
+    const bool isCopy = secondTree != cachedTree;
+    TEST_EQUAL(isCopy, true);
+    delete cachedTree;
+    delete secondTree;
+
+    // the used size contains the tree and not only the content
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("hits")->toValue()->getLong(), 2);
+    TEST_EQUAL(metrics.get("misses")->toValue()->getLong(), 1);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 1);
+    const bool containsTree = metrics.get("used_size")->toValue()->getLong() > 7;
+    TEST_EQUAL(containsTree, true);
+}
+
+/**
+ * @brief ParseCache_Test::evict_test
+ */
+void
+ParseCache_Test::evict_test()
+{
+    ParseCache cache;
+    DataMap metrics;
+
+    // get the size of a small and a big tree with the same content-size
+    TreeItem* smallTree = createTree(1);
+    cache.add("small", smallTree, cache.getGeneration());
+    cache.getMetrics(metrics);
+    const long smallSize = metrics.get("used_size")->toValue()->getLong();
+    cache.invalidate();
+
+    TreeItem* bigTree = createTree(100);
+    cache.add("big_1", bigTree, cache.getGeneration());
+    cache.getMetrics(metrics);
+    const long bigSize = metrics.get("used_size")->toValue()->getLong();
+    cache.invalidate();
+
+    const bool isBigger = bigSize > smallSize;
+    TEST_EQUAL(isBigger, true);
+
+    // the big trees don't fit together into the cache, even if their contents do it
+    cache.setMaxSize(static_cast<uint64_t>(bigSize) + 10);
+    cache.add("big_1", bigTree, cache.getGeneration());
+    cache.add("big_2", bigTree, cache.getGeneration());
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 1);
+    TEST_EQUAL(metrics.get("evictions")->toValue()->getLong(), 1);
+
+    // the least recently used one was removed
+    TreeItem* result = cache.get("big_1");
+    const bool isEvicted = result == nullptr;
+    TEST_EQUAL(isEvicted, true);
+    result = cache.get("big_2");
+    const bool isKept = result != nullptr;
+    TEST_EQUAL(isKept, true);
+    delete result;
+
+    // trees, which are bigger than the whole cache, are not cached
+    cache.setMaxSize(static_cast<uint64_t>(smallSize) + 10);
+    cache.add("big_1", bigTree, cache.getGeneration());
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 0);
+
+    // disabled cache
+    cache.setMaxSize(0);
+    cache.add("small", smallTree, cache.getGeneration());
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 0);
+
+    delete smallTree;
+    delete bigTree;
+}
+
+/**
+ * @brief ParseCache_Test::invalidate_test
+ */
+void
+ParseCache_Test::invalidate_test()
+{
+    ParseCache cache;
+    DataMap metrics;
+    TreeItem* tree = createTree(1);
+
+    cache.add("content", tree, cache.getGeneration());
+    const uint64_t oldGeneration = cache.getGeneration();
+    cache.invalidate();
+
+    // all entries are removed
+    TreeItem* result = cache.get("content");
+    const bool isRemoved = result == nullptr;
+    TEST_EQUAL(isRemoved, true);
+
+    // trees, which were validated before the invalidation, are not added anymore
+    cache.add("content", tree, oldGeneration);
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 0);
+    TEST_EQUAL(metrics.get("invalidations")->toValue()->getLong(), 1);
+
+    cache.add("content", tree, cache.getGeneration());
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 1);
+
+    delete tree;
+}
+
+/**
+ * @brief create a tree with a sequence of blossoms
+ *
+ * @param numberOfBlossoms number of blossoms within the tree
+ *
+ * @return new tree
+ */
+TreeItem*
+ParseCache_Test::createTree(const uint32_t numberOfBlossoms)
+{
+    TreeItem* tree = new TreeItem();
+    tree->id = "tree";
+
+    SequentiellPart* sequentiell = new SequentiellPart();
+    for(uint32_t i = 0; i < numberOfBlossoms; i++)
+    {
+        BlossomItem* blossom = new BlossomItem();
+        blossom->blossomType = "test_blossom";
+        blossom->blossomGroupType = "test_group";
+        blossom->values.insert("input", new DataValue(static_cast<long>(i)));
+
+        BlossomGroupItem* group = new BlossomGroupItem();
+        group->blossomGroupType = "test_group";
+        group->blossoms.push_back(blossom);
+        sequentiell->childs.push_back(group);
+    }
+    tree->childs = sequentiell;
+
+    return tree;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,110 @@
+/**
+ * @file       sakura_parser_interface_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "sakura_parser_interface_test.h"
+
+#include <parsing/sakura_parser_interface.h>
+#include <parsing/sakura_parsing.h>
+#include <items/sakura_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief SakuraParserInterface_Test::SakuraParserInterface_Test
+ */
+SakuraParserInterface_Test::SakuraParserInterface_Test() :
+    Kitsunemimi::CompareTestHelper("SakuraParserInterface_Test")
+{
+    parseError_test();
+    sourceSpan_test();
+}
+
+/**
+ * @brief SakuraParserInterface_Test::parseError_test
+ */
+void
+SakuraParserInterface_Test::parseError_test()
+{
+    SakuraParsing parsing;
+    SakuraParserInterface parserInterface(false, &parsing);
+
+    const std::string brokenTree = "[\"span\"]\n"
+                                   "- input = $\n";
+    TEST_EQUAL(parserInterface.parse(brokenTree, "broken.sakura"), false);
+
+    // the scanner writes null-characters into its copy of the input, so the broken part of the
+    // error has to be taken from the original input
+    TableItem errorMessage = parserInterface.getErrorMessage();
+    const std::string errorOutput = errorMessage.toString();
+    const bool containsBrokenPart = errorOutput.find("\"$\"") != std::string::npos;
+    TEST_EQUAL(containsBrokenPart, true);
+    const bool containsNull = errorOutput.find('\0') != std::string::npos;
+    TEST_EQUAL(containsNull, false);
+
+    // the input is unchanged
+    TEST_EQUAL(brokenTree, std::string("[\"span\"]\n- input = $\n"));
+}
+
+/**
+ * @brief SakuraParserInterface_Test::sourceSpan_test
+ */
+void
+SakuraParserInterface_Test::sourceSpan_test()
+{
+    SakuraParsing parsing;
+    SakuraParserInterface parserInterface(false, &parsing);
+
+    const std::string tree = "[\"span\"]\n"
+                             "- input = 42\n"
+                             "\n"
+                             "subtree(\"test-tree\")\n"
+                             "- input = input\n";
+    TEST_EQUAL(parserInterface.parse(tree, ""), true);
+
+    TreeItem* treeItem = dynamic_cast<TreeItem*>(parserInterface.getOutput());
+    const bool isTree = treeItem != nullptr;
+    TEST_EQUAL(isTree, true);
+    if(treeItem == nullptr) {
+        return;
+    }
+    TEST_EQUAL(treeItem->span.line, 1);
+
+    // the subtree-call begins at the start of the fourth line and ends with its values
+    SequentiellPart* sequentiell = dynamic_cast<SequentiellPart*>(treeItem->childs);
+    SakuraItem* subtree = sequentiell->childs.at(0);
+    TEST_EQUAL(subtree->span.line, 4);
+    TEST_EQUAL(subtree->span.column, 1);
+    const bool endsBehindStart = subtree->span.endLine > subtree->span.line;
+    TEST_EQUAL(endsBehindStart, true);
+
+    // the position is kept in copies of the items
+    SakuraItem* copy = subtree->copy();
+    TEST_EQUAL(copy->span.line, 4);
+    TEST_EQUAL(copy->span.column, 1);
+    delete copy;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,168 @@
+/**
+ * @file       sakura_parsing_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "sakura_parsing_test.h"
+
+#include <parsing/sakura_parsing.h>
+#include <items/sakura_items.h>
+#include <sakura_garden.h>
+
+#include <libKitsunemimiPersistence/files/text_file.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief SakuraParsing_Test::SakuraParsing_Test
+ */
+SakuraParsing_Test::SakuraParsing_Test() :
+    Kitsunemimi::CompareTestHelper("SakuraParsing_Test")
+{
+    resolveSubtreeString_test();
+    resolveSubtreeFiles_test();
+}
+
+/**
+ * @brief SakuraParsing_Test::resolveSubtreeString_test
+ */
+void
+SakuraParsing_Test::resolveSubtreeString_test()
+{
+    SakuraParsing parsing;
+    std::string errorMessage = "";
+
+    // trees, which are given as string, call their subtrees directly by id
+    TreeItem* tree = parsing.parseTreeString("test",
+                                             "[\"test\"]\n"
+                                             "- input = 42\n"
+                                             "\n"
+                                             "subtree(\"test-tree\")\n"
+                                             "- input = input\n",
+                                             errorMessage);
+    const bool isParsed = tree != nullptr;
+    TEST_EQUAL(isParsed, true);
+    if(tree == nullptr) {
+        return;
+    }
+
+    SubtreeItem* subtree = getFirstSubtree(tree);
+    const bool isFound = subtree != nullptr;
+    TEST_EQUAL(isFound, true);
+    if(subtree != nullptr) {
+        TEST_EQUAL(subtree->resolvedId, std::string("test-tree"));
+    }
+
+    delete tree;
+}
+
+/**
+ * @brief SakuraParsing_Test::resolveSubtreeFiles_test
+ */
+void
+SakuraParsing_Test::resolveSubtreeFiles_test()
+{
+    SakuraParsing parsing;
+    SakuraGarden garden;
+    std::map<std::string, TreeItem*> parsedTrees;
+    std::string errorMessage = "";
+
+    // calls of a directory and of a path relative to the calling file are both resolved to the
+    // id of the called file relative to the root-path
+    const bfs::path dirPath = bfs::temp_directory_path() / "sakura_parsing_test";
+    bfs::create_directories(dirPath / "sub");
+    Persistence::writeFile((dirPath / "root.sakura").string(),
+                           "[\"root\"]\n"
+                           "- input = 42\n"
+                           "\n"
+                           "subtree(\"sub\")\n"
+                           "- input = input\n",
+                           errorMessage);
+    Persistence::writeFile((dirPath / "sub" / "root.sakura").string(),
+                           "[\"sub\"]\n"
+                           "- input = 42\n"
+                           "\n"
+                           "subtree(\"../other.sakura\")\n"
+                           "- input = input\n",
+                           errorMessage);
+    Persistence::writeFile((dirPath / "other.sakura").string(),
+                           "[\"other\"]\n"
+                           "- input = 42\n"
+                           "\n"
+                           "test1(\"other\")\n"
+                           "->test2:\n"
+                           "   - input = input\n",
+                           errorMessage);
+
+    TEST_EQUAL(parsing.parseTreeFiles(garden,
+                                      dirPath / "root.sakura",
+                                      parsedTrees,
+                                      errorMessage), true);
+    bfs::remove_all(dirPath);
+
+    TEST_EQUAL(parsedTrees.size(), 3);
+    if(parsedTrees.size() != 3) {
+        return;
+    }
+
+    SubtreeItem* subtree = getFirstSubtree(parsedTrees["root.sakura"]);
+    TEST_EQUAL(subtree->resolvedId, std::string("sub/root.sakura"));
+    subtree = getFirstSubtree(parsedTrees["sub/root.sakura"]);
+    TEST_EQUAL(subtree->resolvedId, std::string("other.sakura"));
+
+    std::map<std::string, TreeItem*>::iterator it;
+    for(it = parsedTrees.begin();
+        it != parsedTrees.end();
+        it++)
+    {
+        delete it->second;
+    }
+}
+
+/**
+ * @brief get the first subtree-call within the top-level of a tree
+ *
+ * @param tree tree to search
+ *
+ * @return first subtree-item, if found, else nullptr
+ */
+SubtreeItem*
+SakuraParsing_Test::getFirstSubtree(TreeItem* tree)
+{
+    SequentiellPart* sequentiell = dynamic_cast<SequentiellPart*>(tree->childs);
+    if(sequentiell == nullptr) {
+        return nullptr;
+    }
+
+    for(SakuraItem* child : sequentiell->childs)
+    {
+        if(child->getType() == SakuraItem::SUBTREE_ITEM) {
+            return dynamic_cast<SubtreeItem*>(child);
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,163 @@
+/**
+ * @file       blossom_cache_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "blossom_cache_test.h"
+
+#include <processing/blossom_cache.h>
+
+#include <libKitsunemimiSakuraLang/blossom.h>
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief BlossomCache_Test::BlossomCache_Test
+ */
+BlossomCache_Test::BlossomCache_Test() :
+    Kitsunemimi::CompareTestHelper("BlossomCache_Test")
+{
+    createKey_test();
+    getAndAdd_test();
+    evict_test();
+}
+
+/**
+ * @brief BlossomCache_Test::createKey_test
+ */
+void
+BlossomCache_Test::createKey_test()
+{
+    BlossomLeaf firstLeaf;
+    initLeaf(firstLeaf, "pure", 42);
+    BlossomLeaf sameLeaf;
+    initLeaf(sameLeaf, "pure", 42);
+    BlossomLeaf otherInputLeaf;
+    initLeaf(otherInputLeaf, "pure", 43);
+    BlossomLeaf otherTypeLeaf;
+    initLeaf(otherTypeLeaf, "other", 42);
+
+    // the name of the call is not part of the key
+    sameLeaf.blossomName = "other-name";
+
+    const std::string key = BlossomCache::createKey(firstLeaf);
+    TEST_EQUAL(BlossomCache::createKey(sameLeaf), key);
+    const bool isOtherInput = BlossomCache::createKey(otherInputLeaf) != key;
+    TEST_EQUAL(isOtherInput, true);
+    const bool isOtherType = BlossomCache::createKey(otherTypeLeaf) != key;
+    TEST_EQUAL(isOtherType, true);
+}
+
+/**
+ * @brief BlossomCache_Test::getAndAdd_test
+ */
+void
+BlossomCache_Test::getAndAdd_test()
+{
+    BlossomCache cache;
+    DataMap metrics;
+
+    BlossomLeaf blossomLeaf;
+    initLeaf(blossomLeaf, "pure", 42);
+    const std::string key = BlossomCache::createKey(blossomLeaf);
+
+    // unknown call
+    TEST_EQUAL(cache.get(key, blossomLeaf), false);
+
+    // the output and the terminal-output are restored
+    blossomLeaf.output.insert("output", new DataValue(43));
+    blossomLeaf.terminalOutput = "terminal";
+    cache.add(key, blossomLeaf);
+
+    BlossomLeaf cachedLeaf;
+    initLeaf(cachedLeaf, "pure", 42);
+    TEST_EQUAL(cache.get(key, cachedLeaf), true);
+    TEST_EQUAL(cachedLeaf.output.get("output")->toValue()->getInt(), 43);
+    TEST_EQUAL(cachedLeaf.terminalOutput, std::string("terminal"));
+
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("hits")->toValue()->getLong(), 1);
+    TEST_EQUAL(metrics.get("misses")->toValue()->getLong(), 1);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 1);
+}
+
+/**
+ * @brief BlossomCache_Test::evict_test
+ */
+void
+BlossomCache_Test::evict_test()
+{
+    // single shard, so all entries share the same maximum size
+    BlossomCache cache(16 * 1024 * 1024, 1);
+    DataMap metrics;
+
+    BlossomLeaf firstLeaf;
+    initLeaf(firstLeaf, "pure", 1);
+    firstLeaf.output.insert("output", new DataValue(2));
+    const std::string firstKey = BlossomCache::createKey(firstLeaf);
+    cache.add(firstKey, firstLeaf);
+
+    cache.getMetrics(metrics);
+    const long entrySize = metrics.get("used_size")->toValue()->getLong();
+
+    // only one entry fits into the cache, so the least recently used one is removed
+    cache.setMaxSize(static_cast<uint64_t>(entrySize) + 1);
+    BlossomLeaf secondLeaf;
+    initLeaf(secondLeaf, "pure", 2);
+    secondLeaf.output.insert("output", new DataValue(3));
+    const std::string secondKey = BlossomCache::createKey(secondLeaf);
+    cache.add(secondKey, secondLeaf);
+
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 1);
+    TEST_EQUAL(metrics.get("evictions")->toValue()->getLong(), 1);
+    TEST_EQUAL(cache.get(firstKey, firstLeaf), false);
+    TEST_EQUAL(cache.get(secondKey, secondLeaf), true);
+
+    // disabled cache
+    cache.setMaxSize(0);
+    cache.add(firstKey, firstLeaf);
+    cache.getMetrics(metrics);
+    TEST_EQUAL(metrics.get("number_of_entries")->toValue()->getLong(), 0);
+}
+
+/**
+ * @brief init a blossom-leaf for the test
+ *
+ * @param blossomLeaf reference to the leaf to init
+ * @param blossomType type of the blossom
+ * @param input value of the input
+ */
+void
+BlossomCache_Test::initLeaf(BlossomLeaf &blossomLeaf,
+                            const std::string &blossomType,
+                            const long input)
+{
+    blossomLeaf.blossomType = blossomType;
+    blossomLeaf.blossomGroupType = "test1";
+    blossomLeaf.input.insert("input", new DataValue(input));
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,179 @@
+/**
+ * @file       blossom_trace_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "blossom_trace_test.h"
+
+#include <processing/blossom_trace.h>
+
+#include <libKitsunemimiSakuraLang/blossom.h>
+#include <libKitsunemimiCommon/common_items/data_items.h>
+#include <libKitsunemimiPersistence/files/text_file.h>
+
+#include <boost/filesystem.hpp>
+
+namespace bfs = boost::filesystem;
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief BlossomTrace_Test::BlossomTrace_Test
+ */
+BlossomTrace_Test::BlossomTrace_Test() :
+    Kitsunemimi::CompareTestHelper("BlossomTrace_Test")
+{
+    serialize_test();
+    recordAndReplay_test();
+    brokenTrace_test();
+}
+
+/**
+ * @brief BlossomTrace_Test::serialize_test
+ */
+void
+BlossomTrace_Test::serialize_test()
+{
+    DataMap input;
+    input.insert("string", new DataValue("test"));
+    input.insert("int", new DataValue(42));
+    input.insert("float", new DataValue(4.5f));
+    input.insert("bool", new DataValue(true));
+    DataArray* array = new DataArray();
+    array->append(new DataValue(1));
+    array->append(new DataValue("two"));
+    input.insert("array", array);
+
+    std::string serialized = "";
+    BlossomTrace::serializeItem(serialized, &input);
+
+    uint64_t position = 0;
+    DataItem* output = nullptr;
+    TEST_EQUAL(BlossomTrace::deserializeItem(serialized, position, output), true);
+    TEST_EQUAL(position, serialized.size());
+    TEST_EQUAL(output->toString(), input.toString());
+    delete output;
+
+    // incomplete input
+    position = 0;
+    output = nullptr;
+    const std::string incomplete = serialized.substr(0, serialized.size() / 2);
+    TEST_EQUAL(BlossomTrace::deserializeItem(incomplete, position, output), false);
+    delete output;
+}
+
+/**
+ * @brief BlossomTrace_Test::recordAndReplay_test
+ */
+void
+BlossomTrace_Test::recordAndReplay_test()
+{
+    std::string errorMessage = "";
+    const bfs::path tracePath = bfs::temp_directory_path() / "sakura_trace_unit_test.trace";
+
+    // small flush-size, so each call is written into the file while recording
+    BlossomTrace trace(16);
+    TEST_EQUAL(trace.startRecording(tracePath.string(), errorMessage), true);
+    TEST_EQUAL(trace.getMode(), BlossomTrace::RECORD_TRACE);
+
+    for(long i = 0; i < 3; i++)
+    {
+        BlossomLeaf blossomLeaf;
+        initLeaf(blossomLeaf, i);
+
+        std::string serializedInput = "";
+        BlossomTrace::serializeItem(serializedInput, &blossomLeaf.input);
+        blossomLeaf.output.insert("output", new DataValue(i * 10));
+        trace.record(blossomLeaf, serializedInput, true, "");
+    }
+
+    std::string content = "";
+    Persistence::readFile(content, tracePath.string(), errorMessage);
+    const bool isWritten = content.size() > 16;
+    TEST_EQUAL(isWritten, true);
+
+    TEST_EQUAL(trace.stopRecording(errorMessage), true);
+    TEST_EQUAL(trace.stopRecording(errorMessage), false);
+    TEST_EQUAL(trace.getMode(), BlossomTrace::NO_TRACE);
+
+    // replay the recorded calls
+    content = "";
+    Persistence::readFile(content, tracePath.string(), errorMessage);
+    bfs::remove(tracePath);
+    TEST_EQUAL(trace.startReplay(content, errorMessage), true);
+
+    BlossomLeaf blossomLeaf;
+    initLeaf(blossomLeaf, 2);
+    bool success = false;
+    TEST_EQUAL(trace.replay(blossomLeaf, success, errorMessage), true);
+    TEST_EQUAL(success, true);
+    TEST_EQUAL(blossomLeaf.output.get("output")->toValue()->getInt(), 20);
+
+    // each recorded call is used only once
+    BlossomLeaf secondLeaf;
+    initLeaf(secondLeaf, 2);
+    TEST_EQUAL(trace.replay(secondLeaf, success, errorMessage), false);
+
+    trace.stopReplay();
+    TEST_EQUAL(trace.getMode(), BlossomTrace::NO_TRACE);
+
+    // files, which can not be opened
+    const bfs::path brokenPath = bfs::temp_directory_path() / "does_not_exist" / "test.trace";
+    TEST_EQUAL(trace.startRecording(brokenPath.string(), errorMessage), false);
+    TEST_EQUAL(trace.getMode(), BlossomTrace::NO_TRACE);
+}
+
+/**
+ * @brief BlossomTrace_Test::brokenTrace_test
+ */
+void
+BlossomTrace_Test::brokenTrace_test()
+{
+    std::string errorMessage = "";
+    BlossomTrace trace;
+
+    // missing header
+    TEST_EQUAL(trace.startReplay("broken", errorMessage), false);
+
+    // incomplete entry
+    TEST_EQUAL(trace.startReplay("SAKURA-TRACE-1\x05", errorMessage), false);
+    TEST_EQUAL(trace.getMode(), BlossomTrace::NO_TRACE);
+}
+
+/**
+ * @brief init a blossom-leaf for the test
+ *
+ * @param blossomLeaf reference to the leaf to init
+ * @param input value of the input
+ */
+void
+BlossomTrace_Test::initLeaf(BlossomLeaf &blossomLeaf,
+                            const long input)
+{
+    blossomLeaf.blossomType = "test_blossom";
+    blossomLeaf.blossomGroupType = "test_group";
+    blossomLeaf.input.insert("input", new DataValue(input));
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,113 @@
+/**
+ * @file       cpu_topology_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "cpu_topology_test.h"
+
+#include <processing/cpu_topology.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief CpuTopology_Test::CpuTopology_Test
+ */
+CpuTopology_Test::CpuTopology_Test() :
+    Kitsunemimi::CompareTestHelper("CpuTopology_Test")
+{
+    parseCpuList_test();
+    getCpuSlots_test();
+}
+
+/**
+ * @brief CpuTopology_Test::parseCpuList_test
+ */
+void
+CpuTopology_Test::parseCpuList_test()
+{
+    std::vector<uint32_t> cpuIds;
+
+    // single ids and ranges, separated by commas
+    TEST_EQUAL(parseCpuList(cpuIds, "0-2,5,8-9\n"), true);
+    TEST_EQUAL(cpuIds.size(), 6);
+    if(cpuIds.size() == 6)
+    {
+        TEST_EQUAL(cpuIds.at(0), 0);
+        TEST_EQUAL(cpuIds.at(2), 2);
+        TEST_EQUAL(cpuIds.at(3), 5);
+        TEST_EQUAL(cpuIds.at(5), 9);
+    }
+
+    // a single id, like the online-list of a host with only one numa-node
+    TEST_EQUAL(parseCpuList(cpuIds, "0"), true);
+    TEST_EQUAL(cpuIds.size(), 1);
+
+    // empty input
+    TEST_EQUAL(parseCpuList(cpuIds, ""), true);
+    TEST_EQUAL(cpuIds.size(), 0);
+    TEST_EQUAL(parseCpuList(cpuIds, "\n"), true);
+    TEST_EQUAL(cpuIds.size(), 0);
+
+    // invalid input clears the result
+    TEST_EQUAL(parseCpuList(cpuIds, "0-1,x"), false);
+    TEST_EQUAL(cpuIds.size(), 0);
+    TEST_EQUAL(parseCpuList(cpuIds, "-3"), false);
+}
+
+/**
+ * @brief CpuTopology_Test::getCpuSlots_test
+ */
+void
+CpuTopology_Test::getCpuSlots_test()
+{
+    std::vector<std::vector<uint32_t>> nodes;
+    getNumaNodes(nodes);
+    const bool hasNodes = nodes.size() > 0;
+    TEST_EQUAL(hasNodes, true);
+    if(hasNodes == false) {
+        return;
+    }
+
+    uint64_t numberOfCpus = 0;
+    for(const std::vector<uint32_t> &cpuIds : nodes) {
+        numberOfCpus += cpuIds.size();
+    }
+
+    // each cpu-thread of the host gets exactly one slot
+    std::vector<CpuSlot> cpuSlots;
+    getCpuSlots(cpuSlots, std::vector<uint32_t>());
+    TEST_EQUAL(cpuSlots.size(), numberOfCpus);
+
+    // only allowed cpu-ids get a slot
+    const uint32_t allowedId = nodes.at(0).at(0);
+    getCpuSlots(cpuSlots, std::vector<uint32_t>{allowedId});
+    TEST_EQUAL(cpuSlots.size(), 1);
+    if(cpuSlots.size() == 1)
+    {
+        TEST_EQUAL(cpuSlots.at(0).cpuId, allowedId);
+        TEST_EQUAL(cpuSlots.at(0).nodeId, 0);
+    }
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
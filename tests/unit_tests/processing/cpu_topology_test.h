@@ -0,0 +1,47 @@
+/**
+ * @file       cpu_topology_test.h
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef CPU_TOPOLOGY_TEST_H
+#define CPU_TOPOLOGY_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+class CpuTopology_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    CpuTopology_Test();
+
+private:
+    void parseCpuList_test();
+    void getCpuSlots_test();
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // CPU_TOPOLOGY_TEST_H
@@ -0,0 +1,128 @@
+/**
+ * @file       loop_source_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "loop_source_test.h"
+
+#include <processing/loop_source.h>
+
+#include <libKitsunemimiCommon/common_items/data_items.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief LoopSource_Test::LoopSource_Test
+ */
+LoopSource_Test::LoopSource_Test() :
+    Kitsunemimi::CompareTestHelper("LoopSource_Test")
+{
+    range_test();
+    array_test();
+    split_test();
+}
+
+/**
+ * @brief LoopSource_Test::range_test
+ */
+void
+LoopSource_Test::range_test()
+{
+    LoopSource source(2, 5);
+    TEST_EQUAL(source.size(), 3);
+    TEST_EQUAL(collectValues(source), std::string("2|3|4|"));
+
+    // the end is before the start
+    LoopSource emptySource(5, 2);
+    TEST_EQUAL(emptySource.size(), 0);
+    const bool isEmpty = emptySource.next() == nullptr;
+    TEST_EQUAL(isEmpty, true);
+}
+
+/**
+ * @brief LoopSource_Test::array_test
+ */
+void
+LoopSource_Test::array_test()
+{
+    DataArray array;
+    array.append(new DataValue("a"));
+    array.append(new DataValue(1));
+
+    LoopSource source(&array);
+    TEST_EQUAL(source.size(), 2);
+    TEST_EQUAL(collectValues(source), std::string("a|1|"));
+
+    // the values are copies, so the array is not changed
+    TEST_EQUAL(array.size(), 2);
+}
+
+/**
+ * @brief LoopSource_Test::split_test
+ */
+void
+LoopSource_Test::split_test()
+{
+    // empty parts between delimiters are kept, but not after the last delimiter
+    const std::string content = "a::b::::c::";
+    LoopSource source(content, "::");
+    TEST_EQUAL(source.size(), 4);
+    TEST_EQUAL(collectValues(source), std::string("a|b||c|"));
+
+    // delimiter with multiple characters at the start
+    const std::string list = ", x, y";
+    LoopSource listSource(list, ", ");
+    TEST_EQUAL(listSource.size(), 3);
+    TEST_EQUAL(collectValues(listSource), std::string("|x|y|"));
+
+    // empty content
+    const std::string empty = "";
+    LoopSource emptySource(empty, ",");
+    TEST_EQUAL(emptySource.size(), 0);
+}
+
+/**
+ * @brief take all values of a loop-source
+ *
+ * @param source source to iterate over
+ *
+ * @return string-representations of all values, each followed by a "|"
+ */
+const std::string
+LoopSource_Test::collectValues(LoopSource &source)
+{
+    std::string result = "";
+
+    DataItem* value = source.next();
+    while(value != nullptr)
+    {
+        result += value->toString() + "|";
+        delete value;
+        value = source.next();
+    }
+
+    return result;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,163 @@
+/**
+ * @file       subtree_queue_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "subtree_queue_test.h"
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief SubtreeQueue_Test::SubtreeQueue_Test
+ */
+SubtreeQueue_Test::SubtreeQueue_Test() :
+    Kitsunemimi::CompareTestHelper("SubtreeQueue_Test")
+{
+    priorityShare_test();
+    noStarvation_test();
+}
+
+/**
+ * @brief SubtreeQueue_Test::priorityShare_test
+ */
+void
+SubtreeQueue_Test::priorityShare_test()
+{
+    SubtreeQueue queue;
+
+    SubtreeQueue::RunContext batchRun;
+    batchRun.runId = queue.createRunId();
+    batchRun.priority = SakuraLangInterface::BATCH_PRIORITY;
+    SubtreeQueue::RunContext interactiveRun;
+    interactiveRun.runId = queue.createRunId();
+    interactiveRun.priority = SakuraLangInterface::INTERACTIVE_PRIORITY;
+
+    addObjects(queue, batchRun, 90);
+    addObjects(queue, interactiveRun, 90);
+
+    // while both runs have waiting objects, the interactive run gets 8 of 9 taken objects, but
+    // the batch run is still taken from time to time
+    uint32_t batchTaken = 0;
+    uint32_t interactiveTaken = 0;
+    for(uint32_t i = 0; i < 45; i++)
+    {
+        SubtreeQueue::SubtreeObject* object = queue.getSubtreeObject();
+        if(object->runContext == &batchRun) {
+            batchTaken++;
+        } else {
+            interactiveTaken++;
+        }
+        delete object;
+    }
+
+    TEST_EQUAL(interactiveTaken, 40);
+    TEST_EQUAL(batchTaken, 5);
+
+    // check metrics
+    DataMap metrics;
+    queue.getSchedulingMetrics(metrics);
+    TEST_EQUAL(metrics.size(), 3);
+    TEST_EQUAL(metrics.get("interactive")->get("processed_subtrees")->getLong(), 40);
+    TEST_EQUAL(metrics.get("interactive")->get("waiting_subtrees")->getLong(), 50);
+    TEST_EQUAL(metrics.get("batch")->get("processed_subtrees")->getLong(), 5);
+    TEST_EQUAL(metrics.get("normal")->get("processed_subtrees")->getLong(), 0);
+
+    clearQueue(queue);
+}
+
+/**
+ * @brief SubtreeQueue_Test::noStarvation_test
+ */
+void
+SubtreeQueue_Test::noStarvation_test()
+{
+    SubtreeQueue queue;
+
+    SubtreeQueue::RunContext bigRun;
+    bigRun.runId = queue.createRunId();
+    bigRun.priority = SakuraLangInterface::BATCH_PRIORITY;
+    SubtreeQueue::RunContext smallRun;
+    smallRun.runId = queue.createRunId();
+    smallRun.priority = SakuraLangInterface::INTERACTIVE_PRIORITY;
+
+    // a big low-priority run is already in progress, when a small high-priority run arrives
+    addObjects(queue, bigRun, 100);
+    for(uint32_t i = 0; i < 10; i++) {
+        delete queue.getSubtreeObject();
+    }
+    addObjects(queue, smallRun, 3);
+
+    // the small run doesn't have to wait until the big run is finished
+    uint32_t smallTaken = 0;
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        SubtreeQueue::SubtreeObject* object = queue.getSubtreeObject();
+        if(object->runContext == &smallRun) {
+            smallTaken++;
+        }
+        delete object;
+    }
+    TEST_EQUAL(smallTaken, 3);
+    TEST_EQUAL(queue.size(), 90);
+
+    clearQueue(queue);
+}
+
+/**
+ * @brief add empty objects of a run to the queue
+ *
+ * @param queue queue, where the objects should be added
+ * @param runContext context of the run, where the objects belong to
+ * @param numberOfObjects number of objects to add
+ */
+void
+SubtreeQueue_Test::addObjects(SubtreeQueue &queue,
+                              SubtreeQueue::RunContext &runContext,
+                              const uint32_t numberOfObjects)
+{
+    for(uint32_t i = 0; i < numberOfObjects; i++)
+    {
+        SubtreeQueue::SubtreeObject* object = new SubtreeQueue::SubtreeObject();
+        object->runContext = &runContext;
+        queue.addSubtreeObject(object);
+    }
+}
+
+/**
+ * @brief take and delete all remaining objects of the queue
+ *
+ * @param queue queue to clear
+ */
+void
+SubtreeQueue_Test::clearQueue(SubtreeQueue &queue)
+{
+    SubtreeQueue::SubtreeObject* object = queue.getSubtreeObject();
+    while(object != nullptr)
+    {
+        delete object;
+        object = queue.getSubtreeObject();
+    }
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
@@ -0,0 +1,54 @@
+/**
+ * @file       subtree_queue_test.h
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef SUBTREE_QUEUE_TEST_H
+#define SUBTREE_QUEUE_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+#include <processing/subtree_queue.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+class SubtreeQueue_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    SubtreeQueue_Test();
+
+private:
+    void priorityShare_test();
+    void noStarvation_test();
+
+    void addObjects(SubtreeQueue &queue,
+                    SubtreeQueue::RunContext &runContext,
+                    const uint32_t numberOfObjects);
+    void clearQueue(SubtreeQueue &queue);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // SUBTREE_QUEUE_TEST_H
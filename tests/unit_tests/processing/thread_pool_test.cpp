@@ -0,0 +1,140 @@
+/**
+ * @file       thread_pool_test.cpp
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#include "thread_pool_test.h"
+
+#include <thread>
+#include <atomic>
+
+#include <processing/thread_pool.h>
+#include <processing/subtree_queue.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+
+/**
+ * @brief ThreadPool_Test::ThreadPool_Test
+ */
+ThreadPool_Test::ThreadPool_Test() :
+    Kitsunemimi::CompareTestHelper("ThreadPool_Test")
+{
+    setNumberOfThreads_test();
+    scaling_test();
+}
+
+/**
+ * @brief ThreadPool_Test::setNumberOfThreads_test
+ */
+void
+ThreadPool_Test::setNumberOfThreads_test()
+{
+    SubtreeQueue queue;
+    ThreadPool pool(2, &queue);
+    TEST_EQUAL(pool.getNumberOfThreads(), 2);
+
+    // invalid limits
+    TEST_EQUAL(pool.setNumberOfThreads(0, 4), false);
+    TEST_EQUAL(pool.setNumberOfThreads(4, 2), false);
+    TEST_EQUAL(pool.getNumberOfThreads(), 2);
+
+    // the pool grows to the new minimum and shrinks to the new maximum immediately
+    TEST_EQUAL(pool.setNumberOfThreads(4, 4), true);
+    TEST_EQUAL(pool.getNumberOfThreads(), 4);
+    TEST_EQUAL(pool.setNumberOfThreads(1, 1), true);
+    TEST_EQUAL(pool.getNumberOfThreads(), 1);
+}
+
+/**
+ * @brief ThreadPool_Test::scaling_test
+ */
+void
+ThreadPool_Test::scaling_test()
+{
+    SubtreeQueue queue;
+    ThreadPool pool(1, &queue);
+    TEST_EQUAL(pool.setNumberOfThreads(1, 3), true);
+
+    SubtreeQueue::RunContext runContext;
+    runContext.runId = queue.createRunId();
+    SubtreeQueue::ActiveCounter activeCounter;
+    activeCounter.shouldCount = 6;
+    std::atomic<bool> released(false);
+
+    // block all threads of the pool, so the tasks are waiting in the queue
+    std::vector<SubtreeQueue::SubtreeObject*> tasks;
+    for(uint32_t i = 0; i < activeCounter.shouldCount; i++)
+    {
+        SubtreeQueue::SubtreeObject* object = new SubtreeQueue::SubtreeObject();
+        object->runContext = &runContext;
+        object->activeCounter = &activeCounter;
+        object->task = [&released]()
+        {
+            while(released == false) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        };
+        queue.addSubtreeObject(object);
+        tasks.push_back(object);
+    }
+
+    // the pool grows up to its maximum, while tasks are waiting
+    TEST_EQUAL(waitForNumberOfThreads(pool, 3), true);
+
+    released = true;
+    while(activeCounter.isEqual() == false) {
+        activeCounter.waitUntilEqual(std::chrono::milliseconds(10));
+    }
+    for(SubtreeQueue::SubtreeObject* object : tasks) {
+        delete object;
+    }
+
+    // the pool shrinks back to its minimum, when the queue is empty
+    TEST_EQUAL(waitForNumberOfThreads(pool, 1), true);
+}
+
+/**
+ * @brief wait until the pool has reached a specific number of threads
+ *
+ * @param pool pool to check
+ * @param expected expected number of threads
+ *
+ * @return false, if the number was not reached within 10 seconds, else true
+ */
+bool
+ThreadPool_Test::waitForNumberOfThreads(ThreadPool &pool,
+                                        const uint32_t expected)
+{
+    for(uint32_t i = 0; i < 1000; i++)
+    {
+        if(pool.getNumberOfThreads() == expected) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return false;
+}
+
+} // namespace Sakura
+} // namespace Kitsunemimi
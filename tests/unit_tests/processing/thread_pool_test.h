@@ -0,0 +1,51 @@
+/**
+ * @file       thread_pool_test.h
+ *
+ * @author     Tobias Anker <tobias.anker@kitsunemimi.moe>
+ *
+ * @copyright  Apache License Version 2.0
+ *
+ *      Copyright 2021 Tobias Anker
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License");
+ *      you may not use this file except in compliance with the License.
+ *      You may obtain a copy of the License at
+ *
+ *          http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *      Unless required by applicable law or agreed to in writing, software
+ *      distributed under the License is distributed on an "AS IS" BASIS,
+ *      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *      See the License for the specific language governing permissions and
+ *      limitations under the License.
+ */
+
+#ifndef THREAD_POOL_TEST_H
+#define THREAD_POOL_TEST_H
+
+#include <libKitsunemimiCommon/test_helper/compare_test_helper.h>
+
+namespace Kitsunemimi
+{
+namespace Sakura
+{
+class ThreadPool;
+
+class ThreadPool_Test
+        : public Kitsunemimi::CompareTestHelper
+{
+public:
+    ThreadPool_Test();
+
+private:
+    void setNumberOfThreads_test();
+    void scaling_test();
+
+    bool waitForNumberOfThreads(ThreadPool &pool,
+                                const uint32_t expected);
+};
+
+} // namespace Sakura
+} // namespace Kitsunemimi
+
+#endif // THREAD_POOL_TEST_H
@@ -0,0 +1,68 @@
+include(../../defaults.pri)
+
+QT -= qt core gui
+
+CONFIG   -= app_bundle
+CONFIG += c++14 console
+
+LIBS += -L../../src -lKitsunemimiSakuraLang
+INCLUDEPATH += $$PWD
+
+LIBS += -L../../../libKitsunemimiCommon/src -lKitsunemimiCommon
+LIBS += -L../../../libKitsunemimiCommon/src/debug -lKitsunemimiCommon
+LIBS += -L../../../libKitsunemimiCommon/src/release -lKitsunemimiCommon
+INCLUDEPATH += ../../../libKitsunemimiCommon/include
+
+LIBS += -L../../../libKitsunemimiPersistence/src -lKitsunemimiPersistence
+LIBS += -L../../../libKitsunemimiPersistence/src/debug -lKitsunemimiPersistence
+LIBS += -L../../../libKitsunemimiPersistence/src/release -lKitsunemimiPersistence
+INCLUDEPATH += ../../../libKitsunemimiPersistence/include
+
+LIBS += -L../../../libKitsunemimiJinja2/src -lKitsunemimiJinja2
+LIBS += -L../../../libKitsunemimiJinja2/src/debug -lKitsunemimiJinja2
+LIBS += -L../../../libKitsunemimiJinja2/src/release -lKitsunemimiJinja2
+INCLUDEPATH += ../../../libKitsunemimiJinja2/include
+
+LIBS += -L../../../libKitsunemimiJson/src -lKitsunemimiJson
+LIBS += -L../../../libKitsunemimiJson/src/debug -lKitsunemimiJson
+LIBS += -L../../../libKitsunemimiJson/src/release -lKitsunemimiJson
+INCLUDEPATH += ../../../libKitsunemimiJson/include
+
+
+LIBS +=  -lboost_filesystem -lboost_system
+
+
+SOURCES += \
+    main.cpp \
+    blossom_test.cpp \
+    items/error_container_test.cpp \
+    items/item_methods_test.cpp \
+    items/json_path_scanner_test.cpp \
+    items/value_item_functions_test.cpp \
+    optimizer/dependency_analysis_test.cpp \
+    parsing/parse_cache_test.cpp \
+    parsing/sakura_parser_interface_test.cpp \
+    parsing/sakura_parsing_test.cpp \
+    processing/blossom_cache_test.cpp \
+    processing/blossom_trace_test.cpp \
+    processing/cpu_topology_test.cpp \
+    processing/loop_source_test.cpp \
+    processing/subtree_queue_test.cpp \
+    processing/thread_pool_test.cpp
+
+HEADERS += \
+    blossom_test.h \
+    items/error_container_test.h \
+    items/item_methods_test.h \
+    items/json_path_scanner_test.h \
+    items/value_item_functions_test.h \
+    optimizer/dependency_analysis_test.h \
+    parsing/parse_cache_test.h \
+    parsing/sakura_parser_interface_test.h \
+    parsing/sakura_parsing_test.h \
+    processing/blossom_cache_test.h \
+    processing/blossom_trace_test.h \
+    processing/cpu_topology_test.h \
+    processing/loop_source_test.h \
+    processing/subtree_queue_test.h \
+    processing/thread_pool_test.h